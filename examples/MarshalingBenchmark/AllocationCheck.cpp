@@ -0,0 +1,286 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  AllocationCheck.cpp
+ * @brief Heap allocations on the steady-state data port paths
+ * @date $Date$
+ *
+ * Usage: AllocationCheck [iterations]
+ *
+ * write: an OutPort<T> is connected through OutPortBase::
+ * subscribeInterfaces() with the "flush" and the "new" subscription
+ * types, so each write goes through the OutPortPushConnector, the
+ * publisher, its buffer and the default timestamp listeners of the
+ * port with the default "corba" marshaling. The consumer at the end
+ * of the connector keeps the last sample and does not send it.
+ * read: a timestamp listener with the "on_read" policy rewrites the
+ * last sample, and it is attached to a serializer and deserialized
+ * into the same variable every time, as InPort does with its bound
+ * variable.
+ * After a warm-up, every call of operator new is counted, including
+ * the ones in the publisher thread. The program fails if any write or
+ * read of equal-sized samples allocates.
+ *
+ * $Id$
+ */
+
+#include <rtm/Manager.h>
+#include <rtm/OutPort.h>
+#include <rtm/InPortConsumer.h>
+#include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/CORBA_SeqUtil.h>
+#include <rtm/NVUtil.h>
+#include <rtm/ByteData.h>
+#include <rtm/ConnectorListener.h>
+#include <rtm/Timestamp.h>
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <coil/Factory.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  std::atomic<unsigned long> g_allocations(0);
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  ++g_allocations;
+  void* p(std::malloc(size == 0 ? 1 : size));
+  if (p == nullptr) { throw std::bad_alloc(); }
+  return p;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+  /*!
+   * The consumer at the end of the connector under test. It keeps the
+   * last sample for the read check instead of sending it.
+   */
+  class LocalConsumer
+    : public RTC::InPortConsumer
+  {
+  public:
+    void init(coil::Properties& /* prop */) override {}
+
+    RTC::DataPortStatus put(RTC::ByteData& data) override
+    {
+      s_last = data;
+      ++s_received;
+      return RTC::DataPortStatus::PORT_OK;
+    }
+
+    void publishInterfaceProfile(SDOPackage::NVList& /* properties */)
+      override {}
+
+    bool subscribeInterface(const SDOPackage::NVList& /* properties */)
+      override
+    {
+      return true;
+    }
+
+    void unsubscribeInterface(const SDOPackage::NVList& /* properties */)
+      override {}
+
+    static RTC::ByteData s_last;
+    static std::atomic<unsigned long> s_received;
+  };
+
+  RTC::ByteData LocalConsumer::s_last;
+  std::atomic<unsigned long> LocalConsumer::s_received(0);
+
+  /*!
+   * OutPort connected to a LocalConsumer in the same way as
+   * OutPortBase::notify_connect() connects it to a remote InPort.
+   */
+  template <class DataType>
+  class CheckedOutPort
+    : public RTC::OutPort<DataType>
+  {
+  public:
+    CheckedOutPort(const char* name, DataType& value)
+      : RTC::OutPort<DataType>(name, value)
+    {
+    }
+
+    bool connect(const char* subscription_type)
+    {
+      RTC::ConnectorProfile prof;
+      prof.name = CORBA::string_dup("allocation_check");
+      prof.connector_id = CORBA::string_dup("allocation_check");
+      CORBA_SeqUtil::push_back(prof.properties,
+        NVUtil::newNV("dataport.dataflow_type", "push"));
+      CORBA_SeqUtil::push_back(prof.properties,
+        NVUtil::newNV("dataport.interface_type", "local"));
+      CORBA_SeqUtil::push_back(prof.properties,
+        NVUtil::newNV("dataport.subscription_type", subscription_type));
+      CORBA_SeqUtil::push_back(prof.properties,
+        NVUtil::newNV("dataport.serializer.cdr.endian", "little"));
+      return this->subscribeInterfaces(prof) == RTC::RTC_OK;
+    }
+  };
+
+  template <class Function>
+  unsigned long countAllocations(Function func, unsigned long count)
+  {
+    // the first calls allocate the streams, the buffer slots and the
+    // sequences of the variable
+    for (int i(0); i < 10; ++i) { func(); }
+
+    g_allocations = 0;
+    for (unsigned long i(0); i < count; ++i) { func(); }
+    return g_allocations;
+  }
+
+  template <class DataType>
+  bool check(const char* name, const char* subscription_type,
+             const DataType& data, unsigned long count)
+  {
+    DataType written(data);
+    CheckedOutPort<DataType> port("out", written);
+    coil::Properties prop;
+    port.init(prop);
+    if (!port.connect(subscription_type))
+      {
+        std::cout << name << ": connection failed." << std::endl;
+        return false;
+      }
+
+    auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                  instance());
+    const std::string marshaling("corba");
+    RTC::ConnectorDataListenerHolder readListeners;
+    readListeners.addListener(new RTC::Timestamp<DataType>("on_read"), true);
+    RTC::ConnectorInfo readInfo;
+    readInfo.properties["timestamp_policy"] = "on_read";
+    RTC::ByteData& slot(LocalConsumer::s_last);
+    DataType value;
+
+    unsigned long sent(LocalConsumer::s_received);
+    auto write = [&]()
+      {
+        port.write();
+        // the "new" publisher sends from its own thread
+        ++sent;
+        while (LocalConsumer::s_received < sent)
+          {
+            std::this_thread::yield();
+          }
+      };
+
+    // kept for all reads as InPortConnector does
+    ::RTC::ByteDataStream<DataType>* cdr(factory.createObject(marshaling));
+    auto read = [&]()
+      {
+        readListeners.notify(readInfo, slot, marshaling);
+        cdr->attachData(slot.getBuffer(), slot.getDataLength());
+        cdr->isLittleEndian(true);
+        cdr->deserialize(value);
+      };
+
+    unsigned long writes(countAllocations(write, count));
+    unsigned long reads(countAllocations(read, count));
+    factory.deleteObject(cdr);
+
+    std::cout << std::left << std::setw(16) << name
+              << std::setw(6) << subscription_type << std::right
+              << "write: " << std::setw(8) << writes
+              << "  read: " << std::setw(8) << reads
+              << "  (allocations in " << count << " samples)" << std::endl;
+    return writes == 0 && reads == 0;
+  }
+
+  template <class DataType>
+  bool check(const char* name, const DataType& data, unsigned long count)
+  {
+    bool ok(check(name, "flush", data, count));
+    return check(name, "new", data, count) && ok;
+  }
+} // namespace
+
+int main(int argc, char** argv)
+{
+  unsigned long count(10000);
+  if (argc > 1) { count = std::strtoul(argv[1], nullptr, 10); }
+  if (count == 0) { count = 1; }
+
+  // the ports need the ORB, but not the name service
+  std::vector<std::string> options = {
+    argv[0],
+    "-o", "naming.enable: NO",
+    "-o", "logger.enable: NO",
+    "-o", "manager.shutdown_auto: NO"
+  };
+  std::vector<char*> args;
+  for (auto& option : options) { args.push_back(&option[0]); }
+  RTC::Manager::init(static_cast<int>(args.size()), args.data());
+
+  RTC::InPortConsumerFactory::instance().
+    addFactory("local",
+               ::coil::Creator< ::RTC::InPortConsumer, LocalConsumer>,
+               ::coil::Destructor< ::RTC::InPortConsumer, LocalConsumer>);
+
+  bool ok(true);
+
+  RTC::TimedDouble d;
+  d.tm.sec = 0;
+  d.tm.nsec = 0;
+  d.data = 1.0;
+  ok = check("TimedDouble", d, count) && ok;
+
+  RTC::TimedDoubleSeq seq;
+  seq.tm.sec = 0;
+  seq.tm.nsec = 0;
+  seq.data.length(1000);
+  for (CORBA::ULong i(0); i < seq.data.length(); ++i) { seq.data[i] = i; }
+  ok = check("TimedDoubleSeq", seq, count) && ok;
+
+  // a 640x480 RGB image
+  RTC::TimedOctetSeq image;
+  image.tm.sec = 0;
+  image.tm.nsec = 0;
+  image.data.length(640 * 480 * 3);
+  for (CORBA::ULong i(0); i < image.data.length(); ++i)
+    {
+      image.data[i] = static_cast<CORBA::Octet>(i);
+    }
+  ok = check("TimedOctetSeq", image, count / 10 + 1) && ok;
+
+  if (!ok)
+    {
+      std::cout << "the data port path allocates heap memory." << std::endl;
+      return 1;
+    }
+  return 0;
+}
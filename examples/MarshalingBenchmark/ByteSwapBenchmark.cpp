@@ -0,0 +1,157 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  ByteSwapBenchmark.cpp
+ * @brief Throughput of big endian marshaling of numeric sequences
+ * @date $Date$
+ *
+ * Usage: ByteSwapBenchmark [max elements]
+ *
+ * TimedDoubleSeq, TimedFloatSeq and TimedShortSeq samples of 1K to 10M
+ * elements are serialized and deserialized in big endian, which needs
+ * byte swapping on little endian hosts. corba is measured once and
+ * fast_cdr with each byte swap kernel the CPU supports.
+ *
+ * $Id$
+ */
+
+#include <rtm/ByteSwap.h>
+#include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/FastCdrSerializer.h>
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <coil/Factory.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  // bytes processed per measurement
+  const double TARGET_BYTES(256.0 * 1024 * 1024);
+
+  template <class DataType>
+  double serializeRate(const std::string& type, const DataType& data,
+                       unsigned long count)
+  {
+    auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                  instance());
+    ::RTC::ByteDataStream<DataType>* cdr(factory.createObject(type));
+    cdr->isLittleEndian(false);
+    unsigned long length(0);
+    Clock::time_point start(Clock::now());
+    for (unsigned long i(0); i < count; ++i)
+      {
+        cdr->serialize(data);
+        length = cdr->getDataLength();
+      }
+    double sec(std::chrono::duration<double>(Clock::now() - start).count());
+    factory.deleteObject(cdr);
+    return static_cast<double>(length) * count / sec / 1e6;
+  }
+
+  template <class DataType>
+  double deserializeRate(const std::string& type,
+                         const std::vector<unsigned char>& buf,
+                         unsigned long count)
+  {
+    auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                  instance());
+    DataType data;
+    double sec(0.0);
+    for (unsigned long i(0); i < count; ++i)
+      {
+        ::RTC::ByteDataStream<DataType>* cdr(factory.createObject(type));
+        cdr->writeData(buf.data(), static_cast<unsigned long>(buf.size()));
+        cdr->isLittleEndian(false);
+        // exclude copying into the stream
+        Clock::time_point start(Clock::now());
+        cdr->deserialize(data);
+        sec += std::chrono::duration<double>(Clock::now() - start).count();
+        factory.deleteObject(cdr);
+      }
+    return static_cast<double>(buf.size()) * count / sec / 1e6;
+  }
+
+  template <class DataType>
+  void report(const char* name, unsigned long elements,
+              const std::string& type, const char* kernel,
+              const DataType& data, const std::vector<unsigned char>& buf)
+  {
+    unsigned long count(static_cast<unsigned long>(
+      TARGET_BYTES / static_cast<double>(buf.size())) + 1);
+    double ser(serializeRate(type, data, count));
+    double des(deserializeRate<DataType>(type, buf, count));
+    std::cout << std::left << std::setw(16) << name
+              << std::right << std::setw(10) << elements
+              << "  " << std::left << std::setw(10) << type
+              << std::setw(8) << kernel
+              << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << ser << std::setw(12) << des << std::endl;
+  }
+
+  template <class DataType>
+  void run(const char* name, unsigned long elements)
+  {
+    CdrMemoryStreamInit<DataType>();
+    FastCdrSerializerInit<DataType>();
+
+    DataType data;
+    data.tm.sec = 0;
+    data.tm.nsec = 0;
+    data.data.length(static_cast<CORBA::ULong>(elements));
+    for (CORBA::ULong i(0); i < data.data.length(); ++i)
+      {
+        data.data[i] = static_cast<typename std::remove_reference<
+          decltype(data.data[i])>::type>(i % 1000);
+      }
+
+    auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                  instance());
+    ::RTC::ByteDataStream<DataType>* cdr(factory.createObject("corba"));
+    cdr->isLittleEndian(false);
+    cdr->serialize(data);
+    std::vector<unsigned char> buf(cdr->getDataLength());
+    cdr->readData(buf.data(), static_cast<unsigned long>(buf.size()));
+    factory.deleteObject(cdr);
+
+    report(name, elements, "corba", "-", data, buf);
+
+    const char* kernels[] = {"scalar", "ssse3", "avx2"};
+    std::string detected(RTC::ByteSwap::implementation());
+    for (const char* kernel : kernels)
+      {
+        if (!RTC::ByteSwap::select(kernel)) { continue; }
+        report(name, elements, "fast_cdr", kernel, data, buf);
+      }
+    RTC::ByteSwap::select(detected.c_str());
+  }
+} // namespace
+
+int main(int argc, char** argv)
+{
+  unsigned long max(10000000);
+  if (argc > 1) { max = std::strtoul(argv[1], nullptr, 10); }
+
+  std::cout << "byte swap kernel: " << RTC::ByteSwap::implementation()
+            << " (rates are MB/s)" << std::endl;
+  std::cout << std::left << std::setw(16) << "type"
+            << std::right << std::setw(10) << "elements"
+            << "  " << std::left << std::setw(10) << "marshaling"
+            << std::setw(8) << "kernel"
+            << std::right << std::setw(12) << "serialize"
+            << std::setw(12) << "deserialize" << std::endl;
+
+  for (unsigned long n(1000); n <= max; n *= 10)
+    {
+      run<RTC::TimedDoubleSeq>("TimedDoubleSeq", n);
+      run<RTC::TimedFloatSeq>("TimedFloatSeq", n);
+      run<RTC::TimedShortSeq>("TimedShortSeq", n);
+    }
+  return 0;
+}
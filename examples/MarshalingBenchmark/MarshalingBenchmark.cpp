@@ -0,0 +1,205 @@
+﻿// -*- C++ -*-
+/*!
+ * @file  MarshalingBenchmark.cpp
+ * @brief Benchmark of the data port marshalers (corba vs fast_cdr)
+ * @date $Date$
+ *
+ * Usage: MarshalingBenchmark [iterations]
+ *
+ * Each sample is serialized and deserialized through the serializer
+ * factory in the same way as OutPortConnector and InPortConnector do,
+ * in both byte orders. The output of fast_cdr is checked to be
+ * identical to that of corba.
+ *
+ * $Id$
+ */
+
+#include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/FastCdrSerializer.h>
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <rtm/idl/ExtendedDataTypesSkel.h>
+#include <coil/Factory.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  template <class DataType>
+  std::vector<unsigned char> serialize(const std::string& type,
+                                       const DataType& data, bool little)
+  {
+    auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                  instance());
+    ::RTC::ByteDataStream<DataType>* cdr(factory.createObject(type));
+    cdr->isLittleEndian(little);
+    cdr->serialize(data);
+    std::vector<unsigned char> buf(cdr->getDataLength());
+    cdr->readData(buf.data(), static_cast<unsigned long>(buf.size()));
+    factory.deleteObject(cdr);
+    return buf;
+  }
+
+  template <class DataType>
+  double benchSerialize(const std::string& type, const DataType& data,
+                        bool little, unsigned long count)
+  {
+    auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                  instance());
+    std::vector<unsigned char> buf;
+    Clock::time_point start(Clock::now());
+    for (unsigned long i(0); i < count; ++i)
+      {
+        ::RTC::ByteDataStream<DataType>* cdr(factory.createObject(type));
+        cdr->isLittleEndian(little);
+        cdr->serialize(data);
+        buf.resize(cdr->getDataLength());
+        cdr->readData(buf.data(), static_cast<unsigned long>(buf.size()));
+        factory.deleteObject(cdr);
+      }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count() / count;
+  }
+
+  template <class DataType>
+  double benchDeserialize(const std::string& type,
+                          const std::vector<unsigned char>& buf,
+                          bool little, unsigned long count)
+  {
+    auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                  instance());
+    DataType data;
+    Clock::time_point start(Clock::now());
+    for (unsigned long i(0); i < count; ++i)
+      {
+        ::RTC::ByteDataStream<DataType>* cdr(factory.createObject(type));
+        cdr->writeData(buf.data(), static_cast<unsigned long>(buf.size()));
+        cdr->isLittleEndian(little);
+        cdr->deserialize(data);
+        factory.deleteObject(cdr);
+      }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+      .count() / count;
+  }
+
+  template <class DataType>
+  bool run(const char* name, const DataType& data, unsigned long count)
+  {
+    CdrMemoryStreamInit<DataType>();
+    FastCdrSerializerInit<DataType>();
+
+    bool ok(true);
+    const bool orders[] = {true, false};
+    for (bool little : orders)
+      {
+        std::vector<unsigned char> corba(serialize("corba", data, little));
+        std::vector<unsigned char> fast(serialize("fast_cdr", data, little));
+        bool same(corba == fast);
+        ok = ok && same;
+
+        double cs(benchSerialize("corba", data, little, count));
+        double fs(benchSerialize("fast_cdr", data, little, count));
+        double cd(benchDeserialize<DataType>("corba", corba, little, count));
+        double fd(benchDeserialize<DataType>("fast_cdr", corba, little,
+                                             count));
+
+        std::cout << std::left << std::setw(16) << name
+                  << std::setw(7) << (little ? "little" : "big")
+                  << std::right << std::setw(9) << corba.size()
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(11) << cs << std::setw(11) << fs
+                  << std::setw(7) << cs / fs << "x"
+                  << std::setw(11) << cd << std::setw(11) << fd
+                  << std::setw(7) << cd / fd << "x"
+                  << (same ? "" : "  MISMATCH") << std::endl;
+      }
+    return ok;
+  }
+
+  template <class Seq>
+  void fill(Seq& seq, CORBA::ULong len)
+  {
+    seq.length(len);
+    for (CORBA::ULong i(0); i < len; ++i)
+      {
+        seq[i] = static_cast<typename std::remove_reference<
+          decltype(seq[i])>::type>(i % 100);
+      }
+  }
+} // namespace
+
+int main(int argc, char** argv)
+{
+  unsigned long count(100000);
+  if (argc > 1) { count = std::strtoul(argv[1], nullptr, 10); }
+  if (count == 0) { count = 1; }
+
+  std::cout << "iterations: " << count
+            << " (times are ns per sample)" << std::endl;
+  std::cout << std::left << std::setw(16) << "type"
+            << std::setw(7) << "order"
+            << std::right << std::setw(9) << "bytes"
+            << std::setw(11) << "ser:corba" << std::setw(11) << "fast_cdr"
+            << std::setw(8) << "ratio"
+            << std::setw(11) << "des:corba" << std::setw(11) << "fast_cdr"
+            << std::setw(8) << "ratio" << std::endl;
+
+  RTC::Time tm;
+  tm.sec = 1234567890;
+  tm.nsec = 123456789;
+  bool ok(true);
+
+  RTC::TimedDouble d;
+  d.tm = tm;
+  d.data = 3.14159;
+  ok = run("TimedDouble", d, count) && ok;
+
+  RTC::TimedLong l;
+  l.tm = tm;
+  l.data = 123456;
+  ok = run("TimedLong", l, count) && ok;
+
+  RTC::TimedPose2D pose;
+  pose.tm = tm;
+  pose.data.position.x = 1.0;
+  pose.data.position.y = 2.0;
+  pose.data.heading = 0.5;
+  ok = run("TimedPose2D", pose, count) && ok;
+
+  RTC::TimedPoint3D point;
+  point.tm = tm;
+  point.data.x = 1.0;
+  point.data.y = 2.0;
+  point.data.z = 3.0;
+  ok = run("TimedPoint3D", point, count) && ok;
+
+  RTC::TimedDoubleSeq dseq;
+  dseq.tm = tm;
+  fill(dseq.data, 1000);
+  ok = run("TimedDoubleSeq", dseq, count) && ok;
+
+  RTC::TimedShortSeq sseq;
+  sseq.tm = tm;
+  fill(sseq.data, 1000);
+  ok = run("TimedShortSeq", sseq, count) && ok;
+
+  RTC::TimedOctetSeq oseq;
+  oseq.tm = tm;
+  fill(oseq.data, 65536);
+  ok = run("TimedOctetSeq", oseq, count / 10 + 1) && ok;
+
+  if (!ok)
+    {
+      std::cout << "fast_cdr output differs from corba." << std::endl;
+      return 1;
+    }
+  return 0;
+}
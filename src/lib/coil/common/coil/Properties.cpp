@@ -170,10 +170,8 @@ namespace coil
    */
   const std::string& Properties::getProperty(const std::string& key) const
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
     Properties* node(nullptr);
-    if ((node = _getNode(keys, 0, this)) != nullptr)
+    if ((node = _findNode(key, this)) != nullptr)
       {
         return (node->set_value) ? node->value : node->default_value;
       }
@@ -231,10 +229,8 @@ namespace coil
    */
   const std::string& Properties::getDefault(const std::string& key) const
   {
-    std::vector<std::string> keys;
-    split(key, '.', keys);
     Properties* node(nullptr);
-    if ((node = _getNode(keys, 0, this)) != nullptr)
+    if ((node = _findNode(key, this)) != nullptr)
       {
         return node->default_value;
       }
@@ -465,13 +461,7 @@ namespace coil
    */
   Properties* Properties::findNode(const std::string& key) const
   {
-    if (key.empty())
-      {
-        return nullptr;
-      }
-    std::vector<std::string> keys;
-    split(key, '.', keys);
-    return _getNode(keys, 0, this);
+    return _findNode(key, this);
   }
 
   /*!
@@ -706,6 +696,51 @@ namespace coil
       }
   }
 
+  /*!
+   * @if jp
+   * @brief キーを分割せずにプロパティを取得する
+   * @else
+   * @brief Get properties without splitting the key
+   * @endif
+   */
+  Properties* Properties::_findNode(const std::string& key,
+                                    const Properties* curr)
+  {
+    if (key.empty())
+      {
+        return nullptr;
+      }
+
+    Properties* node(nullptr);
+    std::string::size_type begin(0);
+    std::string::size_type len(key.size());
+    for (std::string::size_type end(0); end <= len; ++end)
+      {
+        if (end < len && (key[end] != '.' || coil::isEscaped(key, end)))
+          {
+            continue;
+          }
+        // the same name as split() would give: key[begin, end)
+        node = nullptr;
+        for (auto prop : curr->leaf)
+          {
+            if (prop->name.compare(0, std::string::npos,
+                                   key, begin, end - begin) == 0)
+              {
+                node = prop;
+                break;
+              }
+          }
+        if (node == nullptr)
+          {
+            return nullptr;
+          }
+        curr = node;
+        begin = end + 1;
+      }
+    return node;
+  }
+
   /*!
    * @if jp
    * @brief プロパティの名称リストを取得する
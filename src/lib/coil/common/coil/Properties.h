@@ -1230,6 +1230,39 @@ namespace coil
                                 std::vector<Properties*>::size_type index,
                                 const Properties* curr);
 
+    /*!
+     * @if jp
+     * @brief キーを分割せずにプロパティを取得する
+     *
+     * _getNode() と同じく '.' 区切りのキーで指定されたプロパティを取得
+     * するが、キーのリストを作らずにキー文字列の各部分を直接比較する。
+     * データポートでデータごとに参照されるプロパティの取得でメモリを
+     * 確保しないために使用する。
+     *
+     * @param key 取得対象プロパティのキー
+     * @param curr 検索対象プロパティ
+     *
+     * @return 検索対象プロパティ。存在しない場合は NULL
+     *
+     * @else
+     * @brief Get properties without splitting the key
+     *
+     * Like _getNode(), it gets the properties specified by a key
+     * separated by '.', but each part of the key string is compared
+     * in place without building a key list. This keeps the lookups of
+     * properties referred to for every data on data ports from
+     * allocating memory.
+     *
+     * @param key Target properties's key
+     * @param curr Target properties for the search
+     *
+     * @return Target properties, or null if they do not exist
+     *
+     * @endif
+     */
+    static Properties* _findNode(const std::string& key,
+                                 const Properties* curr);
+
     /*!
      * @if jp
      * @brief プロパティの名称リストを取得する
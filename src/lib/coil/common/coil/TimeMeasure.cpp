@@ -18,13 +18,36 @@
  */
 
 #include <coil/TimeMeasure.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 
 #ifndef ULLONG_MAX
 #define ULLONG_MAX 0xffffffffffffffffULL
 #endif
 
+namespace
+{
+  const long long NO_MIN(std::numeric_limits<long long>::max());
+
+  size_t highestBit(unsigned long long v)
+  {
+#if defined(__GNUC__)
+    return 63 - static_cast<size_t>(__builtin_clzll(v));
+#else
+    size_t bit(0);
+    while (v >>= 1) { ++bit; }
+    return bit;
+#endif
+  }
+
+  double seconds(double ns)
+  {
+    return ns / 1e9;
+  }
+} // namespace
+
 namespace coil
 {
 
@@ -37,14 +60,9 @@ namespace coil
    */
   TimeMeasure::TimeMeasure(unsigned long buflen)
     : m_interval(std::chrono::seconds(0)),
-      m_count(0), m_countMax(buflen + 1),
-      m_recurred(false)
+      m_current(0), m_windowMax((buflen + 2) / 2)
   {
-    m_record.reserve(m_countMax);
-    for (unsigned long int i(0); i < m_countMax; ++i)
-      {
-        m_record.emplace_back(std::chrono::seconds(0));
-      }
+    reset();
   }
 
   /*!
@@ -69,13 +87,7 @@ namespace coil
   void TimeMeasure::tack()
   {
     m_interval = std::chrono::high_resolution_clock::now() - m_begin;
-    m_record.at(m_count) = m_interval;
-    ++m_count;
-    if (m_count == m_countMax)
-      {
-        m_count = 0;
-        m_recurred = true;
-      }
+    record(m_interval);
   }
 
   /*!
@@ -99,8 +111,9 @@ namespace coil
    */
   void TimeMeasure::reset()
   {
-    m_count = 0;
-    m_recurred = false;
+    m_windows[0].clear();
+    m_windows[1].clear();
+    m_current = 0;
     m_begin = std::chrono::high_resolution_clock::time_point();
   }
 
@@ -113,8 +126,7 @@ namespace coil
    */
   unsigned long int TimeMeasure::count() const
   {
-    return m_recurred ?
-      static_cast<unsigned long int>(m_record.size()) : m_count;
+    return m_windows[0].count + m_windows[1].count;
   }
 
   /*!
@@ -132,24 +144,13 @@ namespace coil
     max_interval = static_cast<double>(0);
     min_interval = static_cast<double>(ULLONG_MAX);
 
-    double sum = 0;
-    double sq_sum = 0;
-    unsigned long int len(count());
+    if (count() == 0UL) { return false; }
 
-    if (len == 0UL) { return false; }
-
-    for (unsigned long int i(0); i < len; ++i)
-      {
-        double trecord = std::chrono::duration<double>(m_record[i]).count();
-        sum += trecord;
-        sq_sum += trecord * trecord;
-
-        if (trecord > max_interval) max_interval = trecord;
-        if (trecord < min_interval) min_interval = trecord;
-      }
-
-    mean_interval = sum / len;
-    stddev = sqrt(sq_sum / len - (mean_interval * mean_interval));
+    Window all(merged());
+    max_interval = seconds(static_cast<double>(all.max));
+    min_interval = seconds(static_cast<double>(all.min));
+    mean_interval = seconds(all.mean);
+    stddev = seconds(std::sqrt(all.m2 / static_cast<double>(all.count)));
 
     return true;
   }
@@ -163,10 +164,162 @@ namespace coil
    */
   TimeMeasure::Statistics TimeMeasure::getStatistics()
   {
-    Statistics s;
-    getStatistics(s.max_interval, s.min_interval,
-                  s.mean_interval, s.std_deviation);
+    Statistics s = Statistics();
+    s.min_interval = static_cast<double>(ULLONG_MAX);
+    if (count() == 0UL) { return s; }
+
+    Window all(merged());
+    s.max_interval = seconds(static_cast<double>(all.max));
+    s.min_interval = seconds(static_cast<double>(all.min));
+    s.mean_interval = seconds(all.mean);
+    s.std_deviation = seconds(std::sqrt(all.m2 /
+                                        static_cast<double>(all.count)));
+    s.p50 = percentile(all, 0.5);
+    s.p99 = percentile(all, 0.99);
+    s.p999 = percentile(all, 0.999);
     return s;
   }
 
+  /*!
+   * @if jp
+   * @brief 区間の集計を消去する
+   * @else
+   * @brief Clear the window
+   * @endif
+   */
+  void TimeMeasure::Window::clear()
+  {
+    std::fill(bins, bins + BINS, 0U);
+    count = 0;
+    mean = 0.0;
+    m2 = 0.0;
+    min = NO_MIN;
+    max = 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief 区間に計測値を加える
+   * @else
+   * @brief Add a measurement to the window
+   * @endif
+   */
+  void TimeMeasure::Window::add(long long ns)
+  {
+    size_t index(BINS - 1);
+    if (ns < static_cast<long long>(LINEAR))
+      {
+        index = static_cast<size_t>(ns);
+      }
+    else
+      {
+        size_t bit(highestBit(static_cast<unsigned long long>(ns)));
+        if (bit <= MAX_BIT)
+          {
+            size_t sub(static_cast<size_t>(ns >> (bit - SUB_BITS)) &
+                       ((1 << SUB_BITS) - 1));
+            index = LINEAR + ((bit - 4) << SUB_BITS) + sub;
+          }
+      }
+    ++bins[index];
+
+    // Welford's method
+    double x(static_cast<double>(ns));
+    ++count;
+    double delta(x - mean);
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (x - mean);
+
+    min = std::min(min, ns);
+    max = std::max(max, ns);
+  }
+
+  /*!
+   * @if jp
+   * @brief 計測値を統計に加える
+   * @else
+   * @brief Add a measurement to the statistics
+   * @endif
+   */
+  void TimeMeasure::record(std::chrono::nanoseconds interval)
+  {
+    long long ns(interval.count() > 0 ?
+                 static_cast<long long>(interval.count()) : 0);
+    Window& current(m_windows[m_current]);
+    current.add(ns);
+    if (current.count == m_windowMax)
+      {
+        // the oldest window is dropped
+        m_current ^= 1;
+        m_windows[m_current].clear();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 直前の区間と現在の区間を合わせた集計を取得する
+   * @else
+   * @brief Get the previous and the current window merged
+   * @endif
+   */
+  TimeMeasure::Window TimeMeasure::merged() const
+  {
+    const Window& a(m_windows[0]);
+    const Window& b(m_windows[1]);
+    if (a.count == 0) { return b; }
+    if (b.count == 0) { return a; }
+
+    Window all;
+    for (size_t i(0); i < BINS; ++i) { all.bins[i] = a.bins[i] + b.bins[i]; }
+    // Chan et al.'s parallel algorithm
+    double na(static_cast<double>(a.count));
+    double nb(static_cast<double>(b.count));
+    double delta(b.mean - a.mean);
+    all.count = a.count + b.count;
+    all.mean = a.mean + delta * nb / (na + nb);
+    all.m2 = a.m2 + b.m2 + delta * delta * na * nb / (na + nb);
+    all.min = std::min(a.min, b.min);
+    all.max = std::max(a.max, b.max);
+    return all;
+  }
+
+  /*!
+   * @if jp
+   * @brief パーセンタイル値 [s] を取得する
+   * @else
+   * @brief Get a percentile [s]
+   * @endif
+   */
+  double TimeMeasure::percentile(const Window& window, double ratio)
+  {
+    if (window.count == 0) { return 0.0; }
+
+    ratio = std::min(std::max(ratio, 0.0), 1.0);
+    unsigned long int rank(std::max(static_cast<unsigned long int>(
+      std::ceil(ratio * static_cast<double>(window.count))), 1UL));
+    unsigned long int sum(0);
+    size_t i(0);
+    for (; i < BINS - 1; ++i)
+      {
+        sum += window.bins[i];
+        if (sum >= rank) { break; }
+      }
+
+    // the middle of the bin, within the recorded range
+    double lower(static_cast<double>(i));
+    double upper(lower + 1.0);
+    if (i >= LINEAR)
+      {
+        size_t bit(((i - LINEAR) >> SUB_BITS) + 4);
+        double sub(static_cast<double>((i - LINEAR) & ((1 << SUB_BITS) - 1)));
+        double width(std::ldexp(1.0, static_cast<int>(bit - SUB_BITS)));
+        lower = ((1 << SUB_BITS) + sub) * width;
+        upper = lower + width;
+      }
+    double value((lower + upper) / 2.0);
+    value = std::min(value, static_cast<double>(window.max));
+    value = std::max(value, static_cast<double>(window.min));
+    return seconds(value);
+  }
+
 } // namespace coil
@@ -21,7 +21,7 @@
 #define COIL_TIMEMEASURE_H
 
 #include <chrono>
-#include <vector>
+#include <cstddef>
 
 namespace coil
 {
@@ -35,6 +35,20 @@ namespace coil
    * このクラスは、コード実行時間の統計を取る為に使用します。
    * get_stat を使用してコード実行の最大・最小・平均・標準偏差時間を計測できます。
    *
+   * 統計値は計測ごとに逐次更新され、計測回数によらず一定の時間とメモリ
+   * で計測・取得できる。平均と分散は Welford の方法で、パーセンタイルは
+   * 2 のべき乗ごとに 4 分割した対数ヒストグラムで求める。パーセンタイル
+   * の相対誤差は 12.5% 以下である。計測はバッファ長の半分ずつの区間に
+   * 集計し、統計値は直前の区間と現在の区間を合わせたもの、すなわち直近
+   * のバッファ長の半分からバッファ長までの計測を表す。
+   *
+   * 計測値を保持していた以前の実装では、統計値と count() は常に直近の
+   * バッファ長分の計測を表していた。この実装では区間が切り替わるたび
+   * に count() がバッファ長の半分まで戻り、統計値もその分だけ短い期間
+   * を表す。このため MultilayerCompositeEC などが出力する P99 や標準偏
+   * 差、measurement.*_count で指定した件数の意味は、指定件数ちょうど
+   * ではなく、その半分から指定件数までとなる。
+   *
    * @else
    *
    * @class TimeMeasure
@@ -44,6 +58,25 @@ namespace coil
    * Using get_stat you can get maximum, minimum, mean and standard
    * deviation time for code execution.
    *
+   * The statistics are updated incrementally on each measurement, so
+   * measuring and getting them take constant time and memory regardless
+   * of the number of measurements. The mean and the variance are
+   * computed by Welford's method and the percentiles by a logarithmic
+   * histogram dividing each power of two into 4. The relative error of
+   * the percentiles is 12.5% or less. Measurements are accumulated in
+   * windows of half the buffer length, and the statistics merge the
+   * previous and the current window, so they cover the latest half to
+   * full buffer length of measurements.
+   *
+   * The former implementation kept the measured values, and its
+   * statistics and count() always covered the latest buffer length of
+   * measurements. Here count() falls back to half the buffer length
+   * each time the windows switch, and the statistics cover a
+   * correspondingly shorter span. Hence the P99 and standard deviation
+   * logged by MultilayerCompositeEC and others, and the number given
+   * by measurement.*_count, mean half to all of that number of
+   * measurements rather than exactly that number.
+   *
    * @endif
    */
   class TimeMeasure
@@ -66,6 +99,9 @@ namespace coil
       double min_interval;
       double mean_interval;
       double std_deviation;
+      double p50;
+      double p99;
+      double p999;
     };
 
     /*!
@@ -75,12 +111,19 @@ namespace coil
      *
      * 時間統計のプロファイリング
      *
+     * @param buflen 統計値に含める計測件数の上限。統計値は直近の
+     *               buflen/2 から buflen 件の計測を表す。
+     *
      * @else
      *
      * @brief Constructor
      *
      * Time Statistics object for profiling.
      *
+     * @param buflen Upper bound of the measurements in the statistics.
+     *               The statistics cover the latest buflen/2 to buflen
+     *               measurements.
+     *
      * @endif
      */
     explicit TimeMeasure(unsigned long buflen = 100);
@@ -162,7 +205,8 @@ namespace coil
      *
      * @brief 時間統計バッファサイズを取得する
      *
-     * 時間統計バッファサイズを取得する
+     * 統計値に含まれる計測件数を取得する。バッファが一巡した後は
+     * buflen/2 から buflen の間の値となる。
      *
      * @return 計測件数
      *
@@ -170,7 +214,8 @@ namespace coil
      *
      * @brief Get number of time measurement buffer
      *
-     * Get number of time measurement buffer.
+     * Get the number of measurements in the statistics. Once the buffer
+     * has been filled, it is between buflen/2 and buflen.
      *
      * @return Measurement count
      *
@@ -217,7 +262,8 @@ namespace coil
      *
      * @brief 統計結果を取得する
      *
-     * 統計結果を取得する
+     * 統計結果を取得する。単位は秒である。計測がない場合、パーセンタイ
+     * ル値は 0 となる。
      *
      * @return 統計結果
      *
@@ -225,7 +271,8 @@ namespace coil
      *
      * @brief Get statistics result
      *
-     * Get statistics result.
+     * Get statistics result. The unit is seconds. The percentiles are 0
+     * if nothing is measured.
      *
      * @return Statistics result
      *
@@ -234,14 +281,35 @@ namespace coil
     Statistics getStatistics();
 
   private:
-    std::vector<std::chrono::nanoseconds> m_record;
+    // 16 linear bins below 16 ns, then 4 per power of two up to 2^36 ns
+    static const size_t LINEAR = 16;
+    static const size_t SUB_BITS = 2;
+    static const size_t MAX_BIT = 36;
+    static const size_t BINS = LINEAR + (MAX_BIT - 4 + 1) * (1 << SUB_BITS);
+
+    struct Window
+    {
+      void clear();
+      void add(long long ns);
+
+      unsigned int bins[BINS];
+      unsigned long int count;
+      double mean;
+      double m2;   // sum of squared deviations from the mean [ns^2]
+      long long min;
+      long long max;
+    };
+
+    void record(std::chrono::nanoseconds interval);
+    Window merged() const;
+    static double percentile(const Window& window, double ratio);
+
     std::chrono::high_resolution_clock::time_point m_begin;
     std::chrono::nanoseconds m_interval;
 
-    unsigned long int m_count;
-    const unsigned long int m_countMax;
-
-    bool m_recurred;
+    Window m_windows[2];
+    size_t m_current;
+    const unsigned long int m_windowMax;
   };
 } // namespace coil
 #endif  // COIL_TIMEMEASURE_H
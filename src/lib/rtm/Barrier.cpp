@@ -0,0 +1,115 @@
+﻿// -*- C++ -*-
+/*!
+ * @file Barrier.cpp
+ * @brief Reusable spin-then-block barrier
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/Barrier.h>
+
+#include <thread>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  Barrier::Barrier(size_t count)
+    : m_count(count), m_spin(0), m_yield(false),
+      m_arrived(0), m_generation(0), m_sleepers(0), m_cancelled(false)
+  {
+  }
+
+  void Barrier::setCount(size_t count)
+  {
+    m_count = count;
+  }
+
+  void Barrier::setWaitStrategy(std::chrono::nanoseconds spin, bool yield)
+  {
+    m_spin = spin;
+    m_yield = yield;
+  }
+
+  /*!
+   * @if jp
+   * @brief 全スレッドの到着を待つ
+   * @else
+   * @brief Wait for all threads to arrive
+   * @endif
+   */
+  bool Barrier::wait()
+  {
+    if (m_cancelled.load(std::memory_order_acquire)) { return false; }
+    unsigned long generation(m_generation.load(std::memory_order_acquire));
+    if (m_arrived.fetch_add(1, std::memory_order_acq_rel) + 1 >= m_count)
+      {
+        // the last one releases the others
+        m_arrived.store(0, std::memory_order_relaxed);
+        m_generation.store(generation + 1);
+        if (m_sleepers.load() != 0)
+          {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_cond.notify_all();
+          }
+        return true;
+      }
+
+    if (m_spin > std::chrono::nanoseconds::zero())
+      {
+        auto deadline = std::chrono::steady_clock::now() + m_spin;
+        unsigned int count(0);
+        while (m_generation.load(std::memory_order_acquire) == generation)
+          {
+            if (m_cancelled.load(std::memory_order_relaxed)) { return false; }
+            // reading the clock costs more than an iteration
+            if ((++count & 0x3f) == 0 &&
+                std::chrono::steady_clock::now() >= deadline)
+              {
+                break;
+              }
+            if (m_yield) { std::this_thread::yield(); }
+            else         { cpuRelax(); }
+          }
+      }
+
+    if (m_generation.load(std::memory_order_acquire) == generation)
+      {
+        std::unique_lock<std::mutex> guard(m_mutex);
+        ++m_sleepers;
+        m_cond.wait(guard, [this, generation] {
+            return m_generation.load() != generation || m_cancelled.load();
+          });
+        --m_sleepers;
+      }
+    return !m_cancelled.load();
+  }
+
+  /*!
+   * @if jp
+   * @brief 待機中のスレッドを解放し、以降の wait() をすぐに戻らせる
+   * @else
+   * @brief Release the waiting threads and make later wait() return
+   *        at once
+   * @endif
+   */
+  void Barrier::cancel()
+  {
+    m_cancelled = true;
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_cond.notify_all();
+  }
+} // namespace RTC
@@ -0,0 +1,183 @@
+﻿// -*- C++ -*-
+/*!
+ * @file Barrier.h
+ * @brief Reusable spin-then-block barrier
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_BARRIER_H
+#define RTC_BARRIER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief ビジーウェイトのループ内で CPU に待機中であることを伝える
+   *
+   * x86 では pause, ARM では yield 命令を実行する。同じコアの他のハー
+   * ドウェアスレッドに実行資源を譲り、消費電力を抑える。
+   *
+   * @else
+   * @brief Tell the CPU that it is in a busy-wait loop
+   *
+   * This executes the pause instruction on x86 and yield on ARM. It
+   * gives the execution resources to the other hardware threads of the
+   * core and saves power.
+   *
+   * @endif
+   */
+  inline void cpuRelax()
+  {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    _mm_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#endif
+  }
+
+  /*!
+   * @if jp
+   * @class Barrier
+   * @brief 再利用可能なスピン後ブロックするバリア
+   *
+   * 指定数のスレッドが wait() を呼ぶまで全員を待たせ、最後のスレッド
+   * が到着すると全員を解放する。解放後はそのまま次の同期に使用できる。
+   *
+   * 待機するスレッドはまず指定時間だけ解放を監視しながらスピンし、そ
+   * の間に解放されなければ条件変数でブロックする。スピン時間を 0 にす
+   * るとすぐにブロックする。専用のコアを割り当てたスレッドではスピン
+   * 時間を同期の間隔より長くすることで、カーネルを介さずにマイクロ秒
+   * 未満で解放される。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class Barrier
+   * @brief Reusable spin-then-block barrier
+   *
+   * Threads calling wait() are held until the given number of threads
+   * arrive, and all of them are released when the last one arrives.
+   * The barrier can be used again for the next synchronization right
+   * after the release.
+   *
+   * A waiting thread first spins watching for the release for the
+   * given time, then blocks on a condition variable if it has not been
+   * released. It blocks at once if the spin time is 0. Threads on
+   * dedicated cores are released within a microsecond without the
+   * kernel if the spin time is longer than the interval of the
+   * synchronization.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class Barrier
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @param count 同期するスレッド数
+     * @else
+     * @brief Constructor
+     * @param count The number of threads to synchronize
+     * @endif
+     */
+    explicit Barrier(size_t count = 1);
+
+    Barrier(const Barrier&) = delete;
+    Barrier& operator=(const Barrier&) = delete;
+
+    /*!
+     * @if jp
+     * @brief 同期するスレッド数を設定する
+     *
+     * 待機中のスレッドがある間に呼び出してはならない。
+     *
+     * @param count 同期するスレッド数
+     *
+     * @else
+     * @brief Set the number of threads to synchronize
+     *
+     * This must not be called while a thread is waiting.
+     *
+     * @param count The number of threads to synchronize
+     *
+     * @endif
+     */
+    void setCount(size_t count);
+
+    /*!
+     * @if jp
+     * @brief 待機の方法を設定する
+     * @param spin ブロックする前にスピンする時間
+     * @param yield true の場合、スピン中に pause 命令の代わりに
+     *              std::this_thread::yield() を呼ぶ。コア数より多くの
+     *              スレッドが動作する場合に使用する。
+     * @else
+     * @brief Set how to wait
+     * @param spin The time to spin before blocking
+     * @param yield If true, std::this_thread::yield() is called instead
+     *              of the pause instruction while spinning. It is used
+     *              when more threads than cores are running.
+     * @endif
+     */
+    void setWaitStrategy(std::chrono::nanoseconds spin, bool yield);
+
+    /*!
+     * @if jp
+     * @brief 全スレッドの到着を待つ
+     * @return cancel() された場合 false
+     * @else
+     * @brief Wait for all threads to arrive
+     * @return false if cancel() was called
+     * @endif
+     */
+    bool wait();
+
+    /*!
+     * @if jp
+     * @brief 待機中のスレッドを解放し、以降の wait() をすぐに戻らせる
+     * @else
+     * @brief Release the waiting threads and make later wait() return
+     *        at once
+     * @endif
+     */
+    void cancel();
+
+  private:
+    size_t m_count;
+    std::chrono::nanoseconds m_spin;
+    bool m_yield;
+    std::atomic<size_t> m_arrived;
+    std::atomic<unsigned long> m_generation;
+    std::atomic<size_t> m_sleepers;
+    std::atomic<bool> m_cancelled;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+  };
+} // namespace RTC
+
+#endif  // RTC_BARRIER_H
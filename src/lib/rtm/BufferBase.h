@@ -311,6 +311,43 @@ namespace RTC
                                std::chrono::nanoseconds timeout
                                = std::chrono::nanoseconds(-1)) = 0;
 
+    /*!
+     * @if jp
+     *
+     * @brief バッファにデータを移して書き込む
+     *
+     * write(const DataType&) と同じだが、書き込みに成功した場合の value
+     * の内容は不定となる。バッファはコピーせずに value の内容を取り込
+     * んでもよい。デフォルトの実装はコピーする。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 (default -1: 無効)
+     *
+     * @return write(const DataType&) と同じ
+     *
+     * @else
+     *
+     * @brief Write data into the buffer by moving it
+     *
+     * The same as write(const DataType&), but the contents of value
+     * are unspecified after a successful write. The buffer may take
+     * over the contents of value instead of copying them. The default
+     * implementation copies.
+     *
+     * @param value Target data to write.
+     * @param timeout Timeout (default -1: no timeout)
+     *
+     * @return The same as write(const DataType&)
+     *
+     * @endif
+     */
+    virtual BufferStatus write(DataType&& value,
+                               std::chrono::nanoseconds timeout
+                               = std::chrono::nanoseconds(-1))
+    {
+      return write(static_cast<const DataType&>(value), timeout);
+    }
+
     /*!
      * @if jp
      *
@@ -1,5 +1,6 @@
 ﻿#include "ByteData.h"
 #include <cstring>
+#include <utility>
 
 namespace RTC
 {
@@ -18,7 +19,7 @@ namespace RTC
      * @endif
      */
     ByteData::ByteData() :
-        m_buf(nullptr), m_len(0), m_little_endian(true)
+        m_buf(nullptr), m_len(0), m_capacity(0), m_little_endian(true)
     {
 
     }
@@ -60,8 +61,10 @@ namespace RTC
      * @endif
      */
     ByteData::ByteData(const ByteData &rhs)
+        : m_little_endian(rhs.m_little_endian)
     {
         m_len = rhs.m_len;
+        m_capacity = m_len;
         m_buf = new unsigned char[m_len];
         memcpy(m_buf, rhs.m_buf, m_len);
     }
@@ -84,8 +87,10 @@ namespace RTC
      * @endif
      */
     ByteData::ByteData(const ByteDataStreamBase &rhs)
+        : m_little_endian(true)
     {
         m_len = rhs.getDataLength();
+        m_capacity = m_len;
         m_buf = new unsigned char[m_len];
         rhs.readData(m_buf, m_len);
     }
@@ -109,9 +114,16 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteData &rhs)
     {
+        if (this == &rhs)
+        {
+            return *this;
+        }
+        reserve(rhs.m_len);
         m_len = rhs.m_len;
-        m_buf = new unsigned char[m_len];
-        memcpy(m_buf, rhs.m_buf, m_len);
+        if (m_len > 0)
+        {
+            memcpy(m_buf, rhs.m_buf, m_len);
+        }
         return *this;
     }
     /*!
@@ -134,8 +146,9 @@ namespace RTC
      */
     ByteData& ByteData::operator= (const ByteDataStreamBase &rhs)
     {
-        m_len = rhs.getDataLength();
-        m_buf = new unsigned char[m_len];
+        unsigned long len(rhs.getDataLength());
+        reserve(len);
+        m_len = len;
         rhs.readData(m_buf, m_len);
         return *this;
     }
@@ -239,10 +252,13 @@ namespace RTC
             return;
         }
         
-        delete[] m_buf;
-        
+        if (data == m_buf)
+        {
+            m_len = length;
+            return;
+        }
+        reserve(length);
         m_len = length;
-        m_buf = new unsigned char[length];
         memcpy(m_buf, data, length);
     }
     /*!
@@ -289,10 +305,8 @@ namespace RTC
         {
             return;
         }
-        delete[] m_buf;
-
+        reserve(length);
         m_len = length;
-        m_buf = new unsigned char[m_len];
     }
     /*!
      * @if jp
@@ -315,4 +329,37 @@ namespace RTC
     {
         return m_little_endian;
     }
+
+    /*!
+     * @if jp
+     * @brief 内容を交換する
+     * @else
+     * @brief Exchange the contents
+     * @endif
+     */
+    void ByteData::swap(ByteData& rhs) noexcept
+    {
+        std::swap(m_buf, rhs.m_buf);
+        std::swap(m_len, rhs.m_len);
+        std::swap(m_capacity, rhs.m_capacity);
+        std::swap(m_little_endian, rhs.m_little_endian);
+    }
+
+    /*!
+     * @if jp
+     * @brief バッファを少なくとも length バイトにする
+     * @else
+     * @brief Make the buffer at least length bytes
+     * @endif
+     */
+    void ByteData::reserve(unsigned long length)
+    {
+        if (length <= m_capacity)
+        {
+            return;
+        }
+        delete[] m_buf;
+        m_buf = new unsigned char[length];
+        m_capacity = length;
+    }
 } // namespace RTC
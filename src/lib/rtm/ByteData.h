@@ -262,12 +262,55 @@ namespace RTC
          * @endif
          */
         bool getEndian();
+        /*!
+         * @if jp
+         *
+         * @brief 内容を交換する
+         *
+         * バッファを確保し直さずにデータと容量を交換する。
+         *
+         * @param rhs 交換相手
+         *
+         * @else
+         *
+         * @brief Exchange the contents
+         *
+         * The data and the capacity are exchanged without reallocating
+         * the buffers.
+         *
+         * @param rhs The object to exchange with
+         *
+         * @endif
+         */
+        void swap(ByteData& rhs) noexcept;
     private:
+        /*!
+         * @if jp
+         * @brief バッファを少なくとも length バイトにする
+         *
+         * 現在のバッファが足りない場合のみ確保し直す。内容は保持しない。
+         *
+         * @else
+         * @brief Make the buffer at least length bytes
+         *
+         * The buffer is reallocated only if it is too small. The
+         * contents are not preserved.
+         *
+         * @endif
+         */
+        void reserve(unsigned long length);
+
         unsigned char* m_buf;
         unsigned long m_len;
+        unsigned long m_capacity;
         bool m_little_endian;
     };
 
+    inline void swap(ByteData& lhs, ByteData& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
 } // namespace RTC
 
 
@@ -97,5 +97,18 @@ namespace RTC
 
     }
 
+    /*!
+     * @if jp
+     * @brief データをコピーせずに設定する
+     * @else
+     * @brief Set data without copying
+     * @endif
+     */
+    void ByteDataStreamBase::attachData(const unsigned char* buffer,
+                                        unsigned long length)
+    {
+        writeData(buffer, length);
+    }
+
 
 } // namespace RTC
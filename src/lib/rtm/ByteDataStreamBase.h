@@ -172,6 +172,33 @@ namespace RTC
      * @endif
      */
     virtual void isLittleEndian(bool little_endian);
+    /*!
+     * @if jp
+     * @brief データをコピーせずに設定する
+     *
+     * 外部のバッファのデータを復号化の対象として設定する。可能な実装
+     * ではバッファを参照するだけでコピーしないため、バッファは復号化が
+     * 終わるまで、または次に writeData() か serialize() を呼ぶまで有効
+     * でなければならない。デフォルトの実装は writeData() でコピーする。
+     *
+     * @param buffer データのバッファ
+     * @param length データの長さ
+     *
+     * @else
+     * @brief Set data without copying
+     *
+     * This operation sets data in an external buffer as the target of
+     * deserialization. Implementations which can refer to the buffer
+     * do not copy it, so the buffer must remain valid until the data
+     * is deserialized or writeData() or serialize() is called next.
+     * The default implementation copies the data by writeData().
+     *
+     * @param buffer Buffer of the data
+     * @param length Length of the data
+     *
+     * @endif
+     */
+    virtual void attachData(const unsigned char* buffer, unsigned long length);
   };
 
 
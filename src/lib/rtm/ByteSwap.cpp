@@ -0,0 +1,306 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ByteSwap.cpp
+ * @brief Bulk byte order conversion of numeric arrays
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ByteSwap.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) \
+  || (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86)))
+#define RTC_BYTESWAP_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RTC_BYTESWAP_TARGET(isa)
+#else
+#define RTC_BYTESWAP_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace
+{
+  inline uint16_t swap(uint16_t v)
+  {
+    return static_cast<uint16_t>((v >> 8) | (v << 8));
+  }
+
+  inline uint32_t swap(uint32_t v)
+  {
+#if defined(__GNUC__)
+    return __builtin_bswap32(v);
+#elif defined(_MSC_VER)
+    return _byteswap_ulong(v);
+#else
+    return ((v >> 24) & 0xffU) | ((v >> 8) & 0xff00U) |
+      ((v << 8) & 0xff0000U) | (v << 24);
+#endif
+  }
+
+  inline uint64_t swap(uint64_t v)
+  {
+#if defined(__GNUC__)
+    return __builtin_bswap64(v);
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(v);
+#else
+    return (static_cast<uint64_t>(swap(static_cast<uint32_t>(v))) << 32) |
+      swap(static_cast<uint32_t>(v >> 32));
+#endif
+  }
+
+  template <class T>
+  void scalarCopy(void* dst, const void* src, size_t count)
+  {
+    unsigned char* d(static_cast<unsigned char*>(dst));
+    const unsigned char* s(static_cast<const unsigned char*>(src));
+    for (size_t i(0); i < count; ++i, d += sizeof(T), s += sizeof(T))
+      {
+        T v;
+        memcpy(&v, s, sizeof(T));
+        v = swap(v);
+        memcpy(d, &v, sizeof(T));
+      }
+  }
+
+#ifdef RTC_BYTESWAP_X86
+  // shuffle control reversing the bytes of each element in 16 bytes
+  template <size_t Size>
+  struct Mask
+  {
+    static const unsigned char value[16];
+  };
+
+  template <>
+  const unsigned char Mask<2>::value[16] = {
+    1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14
+  };
+
+  template <>
+  const unsigned char Mask<4>::value[16] = {
+    3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+  };
+
+  template <>
+  const unsigned char Mask<8>::value[16] = {
+    7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+  };
+
+  template <class T>
+  RTC_BYTESWAP_TARGET("ssse3")
+  void ssse3Copy(void* dst, const void* src, size_t count)
+  {
+    unsigned char* d(static_cast<unsigned char*>(dst));
+    const unsigned char* s(static_cast<const unsigned char*>(src));
+    const __m128i mask(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(Mask<sizeof(T)>::value)));
+    const size_t step(32 / sizeof(T));
+    size_t i(0);
+    for (; i + step <= count; i += step, d += 32, s += 32)
+      {
+        __m128i a(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+        __m128i b(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+                         _mm_shuffle_epi8(a, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + 16),
+                         _mm_shuffle_epi8(b, mask));
+      }
+    scalarCopy<T>(d, s, count - i);
+  }
+
+  template <class T>
+  RTC_BYTESWAP_TARGET("avx2")
+  void avx2Copy(void* dst, const void* src, size_t count)
+  {
+    unsigned char* d(static_cast<unsigned char*>(dst));
+    const unsigned char* s(static_cast<const unsigned char*>(src));
+    // _mm256_shuffle_epi8 shuffles within each 128 bit lane
+    const __m128i half(_mm_loadu_si128(
+      reinterpret_cast<const __m128i*>(Mask<sizeof(T)>::value)));
+    const __m256i mask(_mm256_broadcastsi128_si256(half));
+    const size_t step(64 / sizeof(T));
+    size_t i(0);
+    for (; i + step <= count; i += step, d += 64, s += 64)
+      {
+        __m256i a(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+        __m256i b(_mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(s + 32)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                            _mm256_shuffle_epi8(a, mask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + 32),
+                            _mm256_shuffle_epi8(b, mask));
+      }
+    ssse3Copy<T>(d, s, count - i);
+  }
+
+  bool hasSsse3()
+  {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") != 0;
+#endif
+  }
+
+  bool hasAvx2()
+  {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 1);
+    // the OS must save the AVX registers
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 ||
+        (_xgetbv(0) & 6) != 6)
+      {
+        return false;
+      }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+  }
+#endif  // RTC_BYTESWAP_X86
+
+  typedef void (*Kernel)(void*, const void*, size_t);
+
+  struct Kernels
+  {
+    const char* name;
+    Kernel copy16;
+    Kernel copy32;
+    Kernel copy64;
+  };
+
+  const Kernels scalarKernels = {
+    "scalar",
+    scalarCopy<uint16_t>, scalarCopy<uint32_t>, scalarCopy<uint64_t>
+  };
+
+#ifdef RTC_BYTESWAP_X86
+  const Kernels ssse3Kernels = {
+    "ssse3",
+    ssse3Copy<uint16_t>, ssse3Copy<uint32_t>, ssse3Copy<uint64_t>
+  };
+
+  const Kernels avx2Kernels = {
+    "avx2",
+    avx2Copy<uint16_t>, avx2Copy<uint32_t>, avx2Copy<uint64_t>
+  };
+#endif
+
+  const Kernels* detect()
+  {
+#ifdef RTC_BYTESWAP_X86
+    if (hasAvx2()) { return &avx2Kernels; }
+    if (hasSsse3()) { return &ssse3Kernels; }
+#endif
+    return &scalarKernels;
+  }
+
+  std::atomic<const Kernels*>& current()
+  {
+    static std::atomic<const Kernels*> kernels(detect());
+    return kernels;
+  }
+} // namespace
+
+namespace RTC
+{
+  namespace ByteSwap
+  {
+    /*!
+     * @if jp
+     * @brief 2 バイト要素の配列をバイトオーダーを反転してコピーする
+     * @else
+     * @brief Copy an array of 2 byte elements reversing the byte order
+     * @endif
+     */
+    void copy16(void* dst, const void* src, size_t count)
+    {
+      current().load(std::memory_order_relaxed)->copy16(dst, src, count);
+    }
+
+    /*!
+     * @if jp
+     * @brief 4 バイト要素の配列をバイトオーダーを反転してコピーする
+     * @else
+     * @brief Copy an array of 4 byte elements reversing the byte order
+     * @endif
+     */
+    void copy32(void* dst, const void* src, size_t count)
+    {
+      current().load(std::memory_order_relaxed)->copy32(dst, src, count);
+    }
+
+    /*!
+     * @if jp
+     * @brief 8 バイト要素の配列をバイトオーダーを反転してコピーする
+     * @else
+     * @brief Copy an array of 8 byte elements reversing the byte order
+     * @endif
+     */
+    void copy64(void* dst, const void* src, size_t count)
+    {
+      current().load(std::memory_order_relaxed)->copy64(dst, src, count);
+    }
+
+    /*!
+     * @if jp
+     * @brief 使用中のカーネル名を取得する
+     * @else
+     * @brief Get the name of the kernel in use
+     * @endif
+     */
+    const char* implementation()
+    {
+      return current().load()->name;
+    }
+
+    /*!
+     * @if jp
+     * @brief 使用するカーネルを選択する
+     * @else
+     * @brief Select the kernel to use
+     * @endif
+     */
+    bool select(const char* name)
+    {
+      const Kernels* kernels(nullptr);
+      if (strcmp(name, "scalar") == 0)
+        {
+          kernels = &scalarKernels;
+        }
+#ifdef RTC_BYTESWAP_X86
+      else if (strcmp(name, "ssse3") == 0 && hasSsse3())
+        {
+          kernels = &ssse3Kernels;
+        }
+      else if (strcmp(name, "avx2") == 0 && hasAvx2())
+        {
+          kernels = &avx2Kernels;
+        }
+#endif
+      if (kernels == nullptr) { return false; }
+      current().store(kernels);
+      return true;
+    }
+  } // namespace ByteSwap
+} // namespace RTC
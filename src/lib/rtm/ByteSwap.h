@@ -0,0 +1,172 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ByteSwap.h
+ * @brief Bulk byte order conversion of numeric arrays
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_BYTESWAP_H
+#define RTC_BYTESWAP_H
+
+#include <cstddef>
+#include <cstring>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @namespace ByteSwap
+   * @brief 数値配列のバイトオーダー一括変換
+   *
+   * 2, 4, 8 バイトの要素からなる配列のバイトオーダーを反転しながらコピー
+   * する。x86 では実行時に CPU を判定して AVX2 または SSSE3 のカーネル
+   * を使用し、それ以外ではスカラーのカーネルを使用する。
+   *
+   * コピー元とコピー先は同一でもよいが、部分的に重なってはならない。
+   * アラインメントの制約はない。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @namespace ByteSwap
+   * @brief Bulk byte order conversion of numeric arrays
+   *
+   * These functions copy arrays of 2, 4 or 8 byte elements reversing the
+   * byte order of each element. On x86 the CPU is detected at runtime
+   * and the AVX2 or SSSE3 kernel is used. Otherwise the scalar kernel is
+   * used.
+   *
+   * The source and the destination may be the same but must not
+   * partially overlap. There is no alignment requirement.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  namespace ByteSwap
+  {
+    /*!
+     * @if jp
+     * @brief 2 バイト要素の配列をバイトオーダーを反転してコピーする
+     * @param dst コピー先
+     * @param src コピー元
+     * @param count 要素数
+     * @else
+     * @brief Copy an array of 2 byte elements reversing the byte order
+     * @param dst Destination
+     * @param src Source
+     * @param count Number of elements
+     * @endif
+     */
+    void copy16(void* dst, const void* src, size_t count);
+
+    /*!
+     * @if jp
+     * @brief 4 バイト要素の配列をバイトオーダーを反転してコピーする
+     * @param dst コピー先
+     * @param src コピー元
+     * @param count 要素数
+     * @else
+     * @brief Copy an array of 4 byte elements reversing the byte order
+     * @param dst Destination
+     * @param src Source
+     * @param count Number of elements
+     * @endif
+     */
+    void copy32(void* dst, const void* src, size_t count);
+
+    /*!
+     * @if jp
+     * @brief 8 バイト要素の配列をバイトオーダーを反転してコピーする
+     * @param dst コピー先
+     * @param src コピー元
+     * @param count 要素数
+     * @else
+     * @brief Copy an array of 8 byte elements reversing the byte order
+     * @param dst Destination
+     * @param src Source
+     * @param count Number of elements
+     * @endif
+     */
+    void copy64(void* dst, const void* src, size_t count);
+
+    /*!
+     * @if jp
+     * @brief 要素の大きさに応じたカーネルでコピーする
+     * @else
+     * @brief Copy with the kernel for the element size
+     * @endif
+     */
+    template <size_t Size>
+    void copy(void* dst, const void* src, size_t count);
+
+    template <>
+    inline void copy<1>(void* dst, const void* src, size_t count)
+    {
+      if (dst != src) { memcpy(dst, src, count); }
+    }
+
+    template <>
+    inline void copy<2>(void* dst, const void* src, size_t count)
+    {
+      copy16(dst, src, count);
+    }
+
+    template <>
+    inline void copy<4>(void* dst, const void* src, size_t count)
+    {
+      copy32(dst, src, count);
+    }
+
+    template <>
+    inline void copy<8>(void* dst, const void* src, size_t count)
+    {
+      copy64(dst, src, count);
+    }
+
+    /*!
+     * @if jp
+     * @brief 使用中のカーネル名を取得する
+     * @return "avx2", "ssse3" または "scalar"
+     * @else
+     * @brief Get the name of the kernel in use
+     * @return "avx2", "ssse3" or "scalar"
+     * @endif
+     */
+    const char* implementation();
+
+    /*!
+     * @if jp
+     * @brief 使用するカーネルを選択する
+     *
+     * 性能比較のために使用する。実行中の CPU が対応していないカーネルは
+     * 選択できない。
+     *
+     * @param name "avx2", "ssse3" または "scalar"
+     * @return 選択できた場合 true
+     *
+     * @else
+     * @brief Select the kernel to use
+     *
+     * This is intended for benchmarks. A kernel which the running CPU
+     * does not support cannot be selected.
+     *
+     * @param name "avx2", "ssse3" or "scalar"
+     * @return true if the kernel was selected
+     *
+     * @endif
+     */
+    bool select(const char* name);
+  } // namespace ByteSwap
+} // namespace RTC
+
+#endif  // RTC_BYTESWAP_H
@@ -39,7 +39,8 @@
   */
 namespace RTC
 {
-    CORBA_CdrMemoryStream::CORBA_CdrMemoryStream(): m_endian(true)
+    CORBA_CdrMemoryStream::CORBA_CdrMemoryStream()
+        : m_endian(true), m_extBuffer(nullptr), m_extLength(0)
     {
     }
 
@@ -57,6 +58,10 @@ namespace RTC
 
     unsigned long CORBA_CdrMemoryStream::getCdrDataLength() const
     {
+        if (m_extBuffer != nullptr)
+        {
+            return m_extLength;
+        }
 #ifdef ORB_IS_ORBEXPRESS
         return m_cdr.size_written();
 #elif defined(ORB_IS_TAO)
@@ -68,6 +73,10 @@ namespace RTC
 
     const unsigned char* CORBA_CdrMemoryStream::getBuffer()
     {
+        if (m_extBuffer != nullptr)
+        {
+            return m_extBuffer;
+        }
 #ifdef ORB_IS_ORBEXPRESS
         return (unsigned char*)m_cdr.get_buffer();
 #elif defined(ORB_IS_TAO)
@@ -91,6 +100,14 @@ namespace RTC
 
     void CORBA_CdrMemoryStream::writeCdrData(const unsigned char* buffer, unsigned long length)
     {
+        if (m_extBuffer != nullptr)
+        {
+            // copy the attached data before appending
+            const unsigned char* ext(m_extBuffer);
+            m_extBuffer = nullptr;
+            writeCdrData(ext, m_extLength);
+            m_extLength = 0;
+        }
 #ifdef ORB_IS_ORBEXPRESS
         m_cdr.write_array_1(buffer, length);
 #elif defined(ORB_IS_TAO)
@@ -102,6 +119,11 @@ namespace RTC
 
     void CORBA_CdrMemoryStream::readCdrData(unsigned char* buffer, unsigned long length) const
     {
+        if (m_extBuffer != nullptr)
+        {
+            memcpy(buffer, m_extBuffer, length);
+            return;
+        }
 #ifdef ORB_IS_ORBEXPRESS
         length = tmp_data.cdr.size_written();
         m_cdr.read_array_1(buffer, length);
@@ -118,5 +140,42 @@ namespace RTC
 #endif
     }
 
+    /*!
+     * @if jp
+     * @brief 外部のバッファのデータをコピーせずに設定する
+     * @else
+     * @brief Set data in an external buffer without copying
+     * @endif
+     */
+    void CORBA_CdrMemoryStream::attachCdrData(const unsigned char* buffer, unsigned long length)
+    {
+        reset();
+#ifdef ORB_IS_ORBEXPRESS
+        writeCdrData(buffer, length);
+#else
+        m_extBuffer = buffer;
+        m_extLength = length;
+#endif
+    }
+
+    /*!
+     * @if jp
+     * @brief ストリームを空にする
+     * @else
+     * @brief Empty the stream
+     * @endif
+     */
+    void CORBA_CdrMemoryStream::reset()
+    {
+        m_extBuffer = nullptr;
+        m_extLength = 0;
+#ifdef ORB_IS_ORBEXPRESS
+        m_cdr.rewind();
+#elif defined(ORB_IS_TAO)
+        m_cdr.reset();
+#else
+        m_cdr.rewindPtrs();
+#endif
+    }
 
 } // namespace RTC
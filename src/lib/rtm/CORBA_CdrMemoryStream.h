@@ -24,6 +24,10 @@
 #include <rtm/idl/DataPort_OpenRTMSkel.h>
 #include <rtm/ByteDataStreamBase.h>
 
+#include <mutex>
+#include <typeinfo>
+#include <vector>
+
 
 
  /*!
@@ -105,6 +109,8 @@ namespace RTC
         template<class ExDataType>
         bool serializeCDR(const ExDataType& data)
         {
+            m_extBuffer = nullptr;
+            m_extLength = 0;
 #ifdef ORB_IS_ORBEXPRESS
             try
             {
@@ -165,6 +171,10 @@ namespace RTC
         template<class ExDataType>
         bool deserializeCDR(ExDataType& data)
         {
+            if (m_extBuffer != nullptr)
+            {
+                return deserializeExternal(data);
+            }
 #ifdef ORB_IS_ORBEXPRESS
             try
             {
@@ -322,6 +332,55 @@ namespace RTC
          */
         void readCdrData(unsigned char* buffer, unsigned long length) const;
 
+        /*!
+         * @if jp
+         *
+         * @brief 外部のバッファのデータをコピーせずに設定する
+         *
+         * 以後の deserializeCDR() はバッファから直接復号化する。バッファは
+         * 復号化が終わるまで、または serializeCDR()、writeCdrData()、
+         * reset() を呼ぶまで有効でなければならない。ORBexpress ではコピー
+         * する。
+         *
+         * @param buffer データのバッファ
+         * @param length データの長さ
+         *
+         * @else
+         *
+         * @brief Set data in an external buffer without copying
+         *
+         * The following deserializeCDR() decodes directly from the
+         * buffer. The buffer must remain valid until the data is
+         * decoded or serializeCDR(), writeCdrData() or reset() is
+         * called. The data is copied with ORBexpress.
+         *
+         * @param buffer Buffer of the data
+         * @param length Length of the data
+         *
+         * @endif
+         */
+        void attachCdrData(const unsigned char* buffer, unsigned long length);
+
+        /*!
+         * @if jp
+         *
+         * @brief ストリームを空にする
+         *
+         * 読み書きの位置を先頭に戻し、外部のバッファの参照を解除する。
+         * 確保済みのメモリは解放せずに次のデータで再利用する。
+         *
+         * @else
+         *
+         * @brief Empty the stream
+         *
+         * This operation rewinds the read and write positions and
+         * releases the reference to an external buffer. The allocated
+         * memory is kept and reused for the next data.
+         *
+         * @endif
+         */
+        void reset();
+
         /*!
          * @if jp
          * @brief コピーコンストラクタ
@@ -336,6 +395,7 @@ namespace RTC
          * @endif
          */
         CORBA_CdrMemoryStream(const CORBA_CdrMemoryStream &rhs)
+            : m_endian(rhs.m_endian), m_extBuffer(nullptr), m_extLength(0)
         {
 #ifdef ORB_IS_ORBEXPRESS
             m_cdr.copy(rhs.m_cdr);
@@ -347,6 +407,10 @@ namespace RTC
 #else
             m_cdr = rhs.m_cdr;
 #endif
+            if (rhs.m_extBuffer != nullptr)
+            {
+                writeCdrData(rhs.m_extBuffer, rhs.m_extLength);
+            }
         }
 
 
@@ -367,19 +431,23 @@ namespace RTC
          */
         CORBA_CdrMemoryStream& operator= (const CORBA_CdrMemoryStream &rhs)
         {
+            m_extBuffer = nullptr;
+            m_extLength = 0;
 #ifdef ORB_IS_ORBEXPRESS
             m_cdr.copy(rhs.m_cdr);
-            return *this;
 #elif defined(ORB_IS_TAO)
             for (const ACE_Message_Block *i = rhs.m_cdr.begin(); i != 0; i = i->cont())
             {
                 m_cdr.write_octet_array_mb(i);
             }
-            return *this;
 #else
             m_cdr = rhs.m_cdr;
-            return *this;
 #endif
+            if (rhs.m_extBuffer != nullptr)
+            {
+                writeCdrData(rhs.m_extBuffer, rhs.m_extLength);
+            }
+            return *this;
         }
 
     protected:
@@ -391,6 +459,44 @@ namespace RTC
         cdrMemoryStream m_cdr;
 #endif
         bool m_endian;
+        const unsigned char* m_extBuffer;
+        unsigned long m_extLength;
+
+    private:
+        template<class ExDataType>
+        bool deserializeExternal(ExDataType& data)
+        {
+#if defined(ORB_IS_TAO)
+            try
+            {
+                TAO_InputCDR tao_cdr(reinterpret_cast<const char*>(m_extBuffer),
+                                     m_extLength, m_endian ? 1 : 0);
+                tao_cdr >> data;
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+#elif !defined(ORB_IS_ORBEXPRESS)
+            try
+            {
+                // read-only stream referring to the buffer
+                cdrMemoryStream cdr(const_cast<unsigned char*>(m_extBuffer),
+                                    m_extLength);
+                cdr.setByteSwapFlag(m_endian);
+                data <<= cdr;
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+#else
+            (void)data;
+            return false;
+#endif
+        }
     };
     /*!
      * @if jp
@@ -622,6 +728,40 @@ namespace RTC
         {
             m_cdr.setEndian(little_endian);
         }
+
+        /*!
+         * @if jp
+         * @brief データをコピーせずに設定する
+         *
+         * @param buffer データのバッファ
+         * @param length データの長さ
+         *
+         * @else
+         * @brief Set data without copying
+         *
+         * @param buffer Buffer of the data
+         * @param length Length of the data
+         *
+         * @endif
+         */
+        void attachData(const unsigned char* buffer,
+                        unsigned long length) override
+        {
+            m_cdr.attachCdrData(buffer, length);
+        }
+
+        /*!
+         * @if jp
+         * @brief 確保済みのメモリを残してストリームを空にする
+         * @else
+         * @brief Empty the stream keeping the allocated memory
+         * @endif
+         */
+        void reset()
+        {
+            m_cdr.reset();
+            m_cdr.setEndian(true);
+        }
     protected:
         CORBA_CdrMemoryStream m_cdr;
         
@@ -632,6 +772,92 @@ namespace RTC
 
 
 
+    /*!
+     * @if jp
+     * @class CORBA_CdrSerializerPool
+     * @brief CORBA_CdrSerializer のプール
+     *
+     * ファクトリから破棄された CORBA_CdrSerializer を確保済みのストリー
+     * ムとともに保持し、次の生成で再利用する。データ毎にシリアライザを
+     * 生成、破棄するコネクタで、ストリームを毎回ゼロから拡張することを
+     * 避ける。データ型ごとに最大 MAX_POOLED 個を保持する。
+     *
+     * @since 2.1.0
+     *
+     * @else
+     * @class CORBA_CdrSerializerPool
+     * @brief Pool of CORBA_CdrSerializer
+     *
+     * CORBA_CdrSerializer objects destroyed through the factory are
+     * kept with their allocated streams and reused for the next
+     * creation. This avoids growing a stream from zero every time in
+     * connectors which create and destroy a serializer per data. At
+     * most MAX_POOLED objects are kept per data type.
+     *
+     * @since 2.1.0
+     *
+     * @endif
+     */
+    template <class DataType>
+    class CORBA_CdrSerializerPool
+    {
+    public:
+        static const size_t MAX_POOLED = 8;
+
+        static ByteDataStream<DataType>* create()
+        {
+            CORBA_CdrSerializerPool& pool(instance());
+            {
+                std::lock_guard<std::mutex> guard(pool.m_mutex);
+                if (!pool.m_free.empty())
+                {
+                    CORBA_CdrSerializer<DataType>* obj(pool.m_free.back());
+                    pool.m_free.pop_back();
+                    return obj;
+                }
+            }
+            return new CORBA_CdrSerializer<DataType>();
+        }
+
+        static void destroy(ByteDataStream<DataType>*& obj)
+        {
+            if (obj == nullptr) { return; }
+            CORBA_CdrSerializer<DataType>* tmp(
+                dynamic_cast<CORBA_CdrSerializer<DataType>*>(obj));
+            if (tmp == nullptr) { return; }
+            obj = nullptr;
+            // derived serializers are not pooled
+            if (typeid(*tmp) == typeid(CORBA_CdrSerializer<DataType>))
+            {
+                tmp->reset();
+                CORBA_CdrSerializerPool& pool(instance());
+                std::lock_guard<std::mutex> guard(pool.m_mutex);
+                if (pool.m_free.size() < MAX_POOLED)
+                {
+                    pool.m_free.push_back(tmp);
+                    return;
+                }
+            }
+            delete tmp;
+        }
+
+    private:
+        CORBA_CdrSerializerPool() = default;
+
+        ~CORBA_CdrSerializerPool()
+        {
+            for (auto obj : m_free) { delete obj; }
+        }
+
+        static CORBA_CdrSerializerPool& instance()
+        {
+            static CORBA_CdrSerializerPool pool;
+            return pool;
+        }
+
+        std::mutex m_mutex;
+        std::vector<CORBA_CdrSerializer<DataType>*> m_free;
+    };
 } // namespace RTC
 
 
@@ -655,10 +881,8 @@ void CdrMemoryStreamInit()
 {
     coil::GlobalFactory < ::RTC::ByteDataStream<DataType> > ::
         instance().addFactory("corba",
-            ::coil::Creator< ::RTC::ByteDataStream<DataType>,
-            ::RTC::CORBA_CdrSerializer<DataType> >,
-            ::coil::Destructor< ::RTC::ByteDataStream<DataType>,
-            ::RTC::CORBA_CdrSerializer<DataType> > );
+            ::RTC::CORBA_CdrSerializerPool<DataType>::create,
+            ::RTC::CORBA_CdrSerializerPool<DataType>::destroy);
 }
 
 
@@ -0,0 +1,208 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ConnectorCodec.cpp
+ * @brief Payload codec stage of data port connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <coil/stringutil.h>
+#include <rtm/ConnectorCodec.h>
+#include <rtm/SystemLogger.h>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  ConnectorCodec::~ConnectorCodec() = default;
+
+  //============================================================
+  // ConnectorCodecChain
+  //============================================================
+  ConnectorCodecChain::ConnectorCodecChain()
+    : m_empty(true)
+  {
+  }
+
+  ConnectorCodecChain::~ConnectorCodecChain()
+  {
+    clear();
+  }
+
+  /*!
+   * @if jp
+   * @brief コーデックを生成する
+   * @else
+   * @brief Create codecs
+   * @endif
+   */
+  void ConnectorCodecChain::init(const coil::Properties& prop)
+  {
+    Logger rtclog("ConnectorCodecChain");
+    std::string codec_type(prop.getProperty("codec_type"));
+    coil::normalize(codec_type);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (codec_type == m_type) { return; }
+    clear();
+    m_type = codec_type;
+
+    std::string dataflow_type(prop.getProperty("dataflow_type"));
+    coil::normalize(dataflow_type);
+    // a pull connection reads only the latest data
+    bool lossy(dataflow_type == "pull");
+
+    coil::vstring types(coil::split(codec_type, ","));
+    ConnectorCodecFactory& factory(ConnectorCodecFactory::instance());
+    for (auto& type : types)
+      {
+        if (type.empty() || type == "none") { continue; }
+        ConnectorCodec* codec(factory.createObject(type));
+        if (codec == nullptr)
+          {
+            RTC_ERROR(("Can not find codec: %s", type.c_str()));
+            continue;
+          }
+        if (lossy && codec->isStateful())
+          {
+            RTC_WARN(("codec %s can not be used on pull connections.",
+                      type.c_str()));
+            factory.deleteObject(codec);
+            continue;
+          }
+        const coil::Properties* node(prop.findNode("codec." + type));
+        codec->init(node != nullptr ? *node : coil::Properties());
+        m_codecs.push_back(codec);
+        RTC_DEBUG(("codec %s enabled.", type.c_str()));
+      }
+    m_empty = m_codecs.empty();
+  }
+
+  /*!
+   * @if jp
+   * @brief このプロセスで利用可能なコーデックの一覧を取得する
+   * @else
+   * @brief Get the codecs available in this process
+   * @endif
+   */
+  std::string ConnectorCodecChain::supported()
+  {
+    return coil::flatten(ConnectorCodecFactory::instance().getIdentifiers(),
+                         ",");
+  }
+
+  /*!
+   * @if jp
+   * @brief 使用するコーデックを決定する
+   * @else
+   * @brief Decide the codecs to use
+   * @endif
+   */
+  std::string ConnectorCodecChain::negotiate(const std::string& requested,
+                                             const std::string& peer)
+  {
+    std::string local(supported());
+    coil::vstring agreed;
+    for (auto& type : coil::split(requested, ","))
+      {
+        coil::normalize(type);
+        if (coil::includes(local, type) && coil::includes(peer, type))
+          {
+            agreed.push_back(type);
+          }
+      }
+    return coil::flatten(agreed, ",");
+  }
+
+  /*!
+   * @if jp
+   * @brief データを符号化する
+   * @else
+   * @brief Encode data
+   * @endif
+   */
+  bool ConnectorCodecChain::encode(ByteData& data)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto& codec : m_codecs)
+      {
+        if (!codec->encode(data, m_work)) { return false; }
+        data.writeData(m_work.getBuffer(), m_work.getDataLength());
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief データを復号する
+   * @else
+   * @brief Decode data
+   * @endif
+   */
+  bool ConnectorCodecChain::decode(ByteData& data)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto it = m_codecs.rbegin(); it != m_codecs.rend(); ++it)
+      {
+        if (!(*it)->decode(data, m_work)) { return false; }
+        data.writeData(m_work.getBuffer(), m_work.getDataLength());
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 全コーデックの状態をリセットする
+   * @else
+   * @brief Reset the state of all codecs
+   * @endif
+   */
+  void ConnectorCodecChain::reset()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto& codec : m_codecs)
+      {
+        codec->reset();
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 全コーデックの統計情報を取得する
+   * @else
+   * @brief Get statistics of all codecs
+   * @endif
+   */
+  void ConnectorCodecChain::getStatistics(coil::Properties& stat) const
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto& codec : m_codecs)
+      {
+        codec->getStatistics(stat);
+      }
+  }
+
+  void ConnectorCodecChain::clear()
+  {
+    ConnectorCodecFactory& factory(ConnectorCodecFactory::instance());
+    for (auto& codec : m_codecs)
+      {
+        factory.deleteObject(codec);
+      }
+    m_codecs.clear();
+    m_empty = true;
+  }
+} // namespace RTC
@@ -0,0 +1,351 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ConnectorCodec.h
+ * @brief Payload codec stage of data port connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_CONNECTORCODEC_H
+#define RTC_CONNECTORCODEC_H
+
+#include <coil/Factory.h>
+#include <coil/Properties.h>
+#include <rtm/ByteData.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class ConnectorCodec
+   * @brief コネクタのペイロードコーデック基底クラス
+   *
+   * シリアライズ後のバイト列を送信前に変換し、受信後に元に戻すコーデッ
+   * クの抽象クラス。コーデックはコネクタごとに生成され、送信側と受信側
+   * でそれぞれ状態を持つことができる。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class ConnectorCodec
+   * @brief Base class of payload codecs of connectors
+   *
+   * The abstract class of codecs that transform serialized bytes before
+   * sending and restore them after receiving. A codec is created for
+   * each connector, and may hold state on both the sending and the
+   * receiving side.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ConnectorCodec
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    virtual ~ConnectorCodec();
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     * @param prop コネクタプロファイルの codec.[コーデック名] ノード
+     * @else
+     * @brief Initializing configuration
+     * @param prop codec.[codec name] node of the connector properties
+     * @endif
+     */
+    virtual void init(const coil::Properties& prop) = 0;
+
+    /*!
+     * @if jp
+     * @brief 送信データを符号化する
+     *
+     * @param in 符号化前のデータ
+     * @param out 符号化後のデータ
+     * @return true: 符号化した, false: エラー
+     *
+     * @else
+     * @brief Encode data to send
+     *
+     * @param in Data before encoding
+     * @param out Data after encoding
+     * @return true: encoded, false: error
+     *
+     * @endif
+     */
+    virtual bool encode(const ByteData& in, ByteData& out) = 0;
+
+    /*!
+     * @if jp
+     * @brief 受信データを復号する
+     *
+     * @param in 受信したデータ
+     * @param out 復号後のデータ
+     * @return true: 復号した, false: 復号できないため破棄する
+     *
+     * @else
+     * @brief Decode received data
+     *
+     * @param in Received data
+     * @param out Data after decoding
+     * @return true: decoded, false: the data cannot be decoded and is
+     *         discarded
+     *
+     * @endif
+     */
+    virtual bool decode(const ByteData& in, ByteData& out) = 0;
+
+    /*!
+     * @if jp
+     * @brief 状態をリセットする
+     *
+     * 送信エラーなどで受信側との同期が失われた可能性がある場合に呼ばれる。
+     *
+     * @else
+     * @brief Reset the state
+     *
+     * This operation is called when synchronization with the receiving
+     * side may have been lost, such as on a send error.
+     *
+     * @endif
+     */
+    virtual void reset() {}
+
+    /*!
+     * @if jp
+     * @brief 復号に直前のフレームが必要か
+     *
+     * true の場合、送信したフレームがすべて順に受信されなければ復号でき
+     * ない。最新のデータのみを読み出す pull 型接続では使用されない。
+     *
+     * @return true: 状態を持つ, false: フレームごとに独立
+     *
+     * @else
+     * @brief Whether decoding needs the preceding frames
+     *
+     * If true, frames cannot be decoded unless all the sent frames are
+     * received in order. Such a codec is not used on pull connections,
+     * which read only the latest data.
+     *
+     * @return true: stateful, false: each frame is independent
+     *
+     * @endif
+     */
+    virtual bool isStateful() const { return false; }
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     * @param stat 統計情報を受け取るプロパティ
+     * @else
+     * @brief Get statistics
+     * @param stat Properties to receive the statistics
+     * @endif
+     */
+    virtual void getStatistics(coil::Properties& /*stat*/) const {}
+  };
+
+  typedef ::coil::GlobalFactory<ConnectorCodec> ConnectorCodecFactory;
+
+  /*!
+   * @if jp
+   * @class ConnectorCodecChain
+   * @brief コネクタのコーデック列
+   *
+   * コネクタプロファイルの codec_type にカンマ区切りで指定されたコーデ
+   * ックを生成し、送信時は指定順に符号化、受信時は逆順に復号する。各コ
+   * ーデックには codec.[コーデック名] ノードが渡される。
+   *
+   * 接続時、各ポートは対応するコーデックの一覧を ConnectorProfile の
+   * dataport.codec.inport_supported および
+   * dataport.codec.outport_supported として公開し、codec_type のうち両
+   * 端が対応するコーデックのみが使用される。合意したコーデックは
+   * ConnectorProfile の dataport.codec_type に記録され、両端はこの値を
+   * 使用する。codec_type が指定されていない場合コーデックは使用しない。
+   * 受信側は ON_RECEIVED リスナを呼ぶ前に復号するため、リスナには
+   * 常に復号済みのデータが渡される。
+   * dataflow_type が pull の場合、状態を持つコーデックは使用しない。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class ConnectorCodecChain
+   * @brief Codec chain of a connector
+   *
+   * This class creates the codecs listed comma-separated in codec_type
+   * of the connector properties. Data is encoded in the listed order
+   * when sending and decoded in the reverse order when receiving. Each
+   * codec receives the codec.[codec name] node.
+   *
+   * On connection, each port publishes the list of codecs it supports
+   * as dataport.codec.inport_supported and
+   * dataport.codec.outport_supported in the ConnectorProfile, and only
+   * the codecs in codec_type supported by both ends are used. The
+   * agreed codecs are recorded in dataport.codec_type of the
+   * ConnectorProfile, and both ends use that value. No codec is used
+   * unless codec_type is given. The receiving side decodes before the
+   * ON_RECEIVED listeners, so listeners always get decoded data.
+   * If dataflow_type is pull, stateful codecs are not used.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ConnectorCodecChain
+  {
+  public:
+    ConnectorCodecChain();
+    ~ConnectorCodecChain();
+
+    /*!
+     * @if jp
+     * @brief コーデックを生成する
+     *
+     * codec_type が前回と異なる場合、既存のコーデックを破棄して生成し
+     * 直す。同じ場合はコーデックの状態を保持する。
+     *
+     * @param prop コネクタプロファイルのプロパティ
+     *
+     * @else
+     * @brief Create codecs
+     *
+     * If codec_type differs from the previous one, the existing codecs
+     * are destroyed and created again. Otherwise, the codec state is
+     * kept.
+     *
+     * @param prop Connector properties
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief このプロセスで利用可能なコーデックの一覧を取得する
+     * @return カンマ区切りのコーデック名
+     * @else
+     * @brief Get the codecs available in this process
+     * @return Comma separated codec names
+     * @endif
+     */
+    static std::string supported();
+
+    /*!
+     * @if jp
+     * @brief 使用するコーデックを決定する
+     *
+     * requested のうち、このプロセスと接続相手の双方が対応するコーデッ
+     * クを requested の順序で返す。
+     *
+     * @param requested 要求されたコーデック (codec_type)
+     * @param peer 接続相手が対応するコーデックの一覧
+     * @return 使用するコーデック
+     *
+     * @else
+     * @brief Decide the codecs to use
+     *
+     * This operation returns the codecs in requested supported by both
+     * this process and the peer, in the order of requested.
+     *
+     * @param requested Requested codecs (codec_type)
+     * @param peer Codecs supported by the peer
+     * @return Codecs to use
+     *
+     * @endif
+     */
+    static std::string negotiate(const std::string& requested,
+                                 const std::string& peer);
+
+    /*!
+     * @if jp
+     * @brief コーデックが設定されているか
+     * @else
+     * @brief Whether any codec is configured
+     * @endif
+     */
+    bool empty() const { return m_empty; }
+
+    /*!
+     * @if jp
+     * @brief データを符号化する
+     * @param data 符号化対象データ。符号化後のデータで置き換えられる
+     * @return true: 成功, false: エラー
+     * @else
+     * @brief Encode data
+     * @param data Data to encode, replaced with the encoded data
+     * @return true: succeeded, false: error
+     * @endif
+     */
+    bool encode(ByteData& data);
+
+    /*!
+     * @if jp
+     * @brief データを復号する
+     * @param data 復号対象データ。復号後のデータで置き換えられる
+     * @return true: 成功, false: データを破棄する
+     * @else
+     * @brief Decode data
+     * @param data Data to decode, replaced with the decoded data
+     * @return true: succeeded, false: the data is discarded
+     * @endif
+     */
+    bool decode(ByteData& data);
+
+    /*!
+     * @if jp
+     * @brief 全コーデックの状態をリセットする
+     * @else
+     * @brief Reset the state of all codecs
+     * @endif
+     */
+    void reset();
+
+    /*!
+     * @if jp
+     * @brief 全コーデックの統計情報を取得する
+     * @else
+     * @brief Get statistics of all codecs
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) const;
+
+    ConnectorCodecChain(ConnectorCodecChain const&) = delete;
+    ConnectorCodecChain& operator=(ConnectorCodecChain const&) = delete;
+
+  private:
+    void clear();
+
+    mutable std::mutex m_mutex;
+    std::atomic<bool> m_empty;
+    std::string m_type;
+    std::vector<ConnectorCodec*> m_codecs;
+    ByteData m_work;
+  };
+} // namespace RTC
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+EXTERN template class DLL_PLUGIN coil::GlobalFactory<RTC::ConnectorCodec>;
+#elif defined(__GNUC__)
+EXTERN template class coil::Singleton<coil::GlobalFactory<RTC::ConnectorCodec> >;
+#endif
+
+#endif  // RTC_CONNECTORCODEC_H
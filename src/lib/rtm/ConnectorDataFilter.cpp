@@ -0,0 +1,292 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ConnectorDataFilter.cpp
+ * @brief Sender side data filter of OutPort connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <coil/stringutil.h>
+#include <rtm/ConnectorDataFilter.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  ConnectorDataFilter::ConnectorDataFilter()
+    : m_enabled(false), m_everyNth(1), m_nthCount(0),
+      m_minInterval(std::chrono::steady_clock::duration::zero()),
+      m_hasSent(false),
+      m_useValue(false), m_deadband(0.0), m_predicateOp(PREDICATE_NONE),
+      m_predicateValue(0.0), m_hasValues(false), m_valueCaptured(false),
+      m_onChange(false), m_skipBytes(0), m_hasBytes(false),
+      m_passedCount(0), m_filteredCount(0)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void ConnectorDataFilter::init(const coil::Properties& prop)
+  {
+    // every_nth default: 1 (every sample)
+    if (!coil::stringTo(m_everyNth, prop.getProperty("every_nth", "1").c_str())
+        || m_everyNth == 0)
+      {
+        m_everyNth = 1;
+      }
+    m_nthCount = 0;
+
+    // max_rate default: 0 (unlimited)
+    double rate(0.0);
+    if (coil::stringTo(rate, prop.getProperty("max_rate", "0").c_str())
+        && rate > 0.0)
+      {
+        m_minInterval =
+          std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / rate));
+      }
+    else
+      {
+        m_minInterval = std::chrono::steady_clock::duration::zero();
+      }
+    m_hasSent = false;
+
+    // deadband default: none
+    std::string deadband(prop.getProperty("deadband"));
+    if (deadband.empty() || !coil::stringTo(m_deadband, deadband.c_str())
+        || m_deadband < 0.0)
+      {
+        m_deadband = -1.0;
+      }
+
+    if (!parsePredicate(prop.getProperty("predicate")))
+      {
+        m_predicateOp = PREDICATE_NONE;
+      }
+    m_useValue = (m_deadband >= 0.0) || (m_predicateOp != PREDICATE_NONE);
+    m_hasValues = false;
+
+    // on_change default: none
+    std::string on_change(prop.getProperty("on_change", "none"));
+    coil::normalize(on_change);
+    m_onChange = (on_change == "bytes");
+    if (!coil::stringTo(m_skipBytes,
+                        prop.getProperty("on_change.skip_bytes", "0").c_str()))
+      {
+        m_skipBytes = 0;
+      }
+    m_hasBytes = false;
+
+    m_enabled = (m_everyNth > 1) ||
+      (m_minInterval > std::chrono::steady_clock::duration::zero()) ||
+      m_useValue || m_onChange;
+  }
+
+  /*!
+   * @if jp
+   * @brief シリアライズ後のバイト列を判定する
+   * @else
+   * @brief Examine serialized bytes
+   * @endif
+   */
+  bool ConnectorDataFilter::passBytes(const ByteDataStreamBase& cdr)
+  {
+    if (!m_enabled || !m_onChange) { return true; }
+
+    m_bytes.resize(cdr.getDataLength());
+    if (!m_bytes.empty())
+      {
+        cdr.readData(m_bytes.data(), static_cast<unsigned long>(m_bytes.size()));
+      }
+    if (!m_hasBytes || m_bytes.size() != m_lastBytes.size())
+      {
+        return true;
+      }
+    size_t skip(std::min(static_cast<size_t>(m_skipBytes), m_bytes.size()));
+    if (std::equal(m_bytes.begin() + static_cast<long>(skip), m_bytes.end(),
+                   m_lastBytes.begin() + static_cast<long>(skip)))
+      {
+        return reject();
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信を確定する
+   * @else
+   * @brief Commit sending
+   * @endif
+   */
+  void ConnectorDataFilter::commit()
+  {
+    if (!m_enabled) { return; }
+    ++m_passedCount;
+    m_lastSent = std::chrono::steady_clock::now();
+    m_hasSent = true;
+    if (m_valueCaptured)
+      {
+        m_lastValues.swap(m_values);
+        m_hasValues = true;
+      }
+    if (m_onChange)
+      {
+        m_lastBytes.swap(m_bytes);
+        m_hasBytes = true;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get statistics
+   * @endif
+   */
+  void ConnectorDataFilter::getStatistics(coil::Properties& stat) const
+  {
+    if (!m_enabled) { return; }
+    stat.setProperty("filter.passed_count", coil::otos(m_passedCount.load()));
+    stat.setProperty("filter.filtered_count",
+                     coil::otos(m_filteredCount.load()));
+  }
+
+  /*!
+   * @if jp
+   * @brief every_nth と max_rate の判定
+   * @else
+   * @brief Examine every_nth and max_rate
+   * @endif
+   */
+  bool ConnectorDataFilter::passRate()
+  {
+    if (m_everyNth > 1)
+      {
+        unsigned long count(m_nthCount);
+        m_nthCount = (m_nthCount + 1) % m_everyNth;
+        if (count != 0) { return false; }
+      }
+    if (m_hasSent &&
+        m_minInterval > std::chrono::steady_clock::duration::zero())
+      {
+        if (std::chrono::steady_clock::now() - m_lastSent < m_minInterval)
+          {
+            return false;
+          }
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief deadband と predicate の判定
+   * @else
+   * @brief Examine deadband and predicate
+   * @endif
+   */
+  bool ConnectorDataFilter::passValue() const
+  {
+    if (m_predicateOp != PREDICATE_NONE)
+      {
+        // sequences pass if any element satisfies the predicate
+        bool matched(false);
+        for (double v : m_values)
+          {
+            switch (m_predicateOp)
+              {
+              case PREDICATE_LT: matched = (v <  m_predicateValue); break;
+              case PREDICATE_LE: matched = (v <= m_predicateValue); break;
+              case PREDICATE_GT: matched = (v >  m_predicateValue); break;
+              case PREDICATE_GE: matched = (v >= m_predicateValue); break;
+              case PREDICATE_EQ: matched = (v == m_predicateValue); break;
+              case PREDICATE_NE: matched = (v != m_predicateValue); break;
+              default: matched = true; break;
+              }
+            if (matched) { break; }
+          }
+        if (!matched) { return false; }
+      }
+
+    if (m_deadband >= 0.0 && m_hasValues &&
+        m_values.size() == m_lastValues.size())
+      {
+        for (size_t i(0); i < m_values.size(); ++i)
+          {
+            if (std::fabs(m_values[i] - m_lastValues[i]) > m_deadband)
+              {
+                return true;
+              }
+          }
+        return false;
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief データを破棄する
+   * @else
+   * @brief Discard data
+   * @endif
+   */
+  bool ConnectorDataFilter::reject()
+  {
+    ++m_filteredCount;
+    return false;
+  }
+
+  /*!
+   * @if jp
+   * @brief predicate 文字列の解析
+   * @else
+   * @brief Parse a predicate string
+   * @endif
+   */
+  bool ConnectorDataFilter::parsePredicate(const std::string& predicate)
+  {
+    std::string pred(predicate);
+    coil::eraseBlank(pred);
+    if (pred.empty()) { return false; }
+
+    static const struct { const char* str; PredicateOp op; } ops[] =
+      {
+        // two character operators first
+        {"<=", PREDICATE_LE}, {">=", PREDICATE_GE},
+        {"==", PREDICATE_EQ}, {"!=", PREDICATE_NE},
+        {"<",  PREDICATE_LT}, {">",  PREDICATE_GT}
+      };
+    for (const auto& op : ops)
+      {
+        std::string str(op.str);
+        if (pred.compare(0, str.size(), str) != 0) { continue; }
+        if (!coil::stringTo(m_predicateValue, pred.substr(str.size()).c_str()))
+          {
+            return false;
+          }
+        m_predicateOp = op.op;
+        return true;
+      }
+    return false;
+  }
+} // namespace RTC
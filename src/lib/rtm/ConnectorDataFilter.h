@@ -0,0 +1,276 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ConnectorDataFilter.h
+ * @brief Sender side data filter of OutPort connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_CONNECTORDATAFILTER_H
+#define RTC_CONNECTORDATAFILTER_H
+
+#include <coil/Properties.h>
+#include <rtm/ByteDataStreamBase.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+  namespace ConnectorDataFilterDetail
+  {
+    // scalar "data" member (TimedDouble, TimedLong, ...)
+    template <class DataType>
+    auto toNumeric(const DataType& value, std::vector<double>& out, int)
+      -> decltype(static_cast<double>(value.data), bool())
+    {
+      out.assign(1, static_cast<double>(value.data));
+      return true;
+    }
+
+    // sequence "data" member (TimedDoubleSeq, TimedLongSeq, ...)
+    template <class DataType>
+    auto toNumeric(const DataType& value, std::vector<double>& out, long)
+      -> decltype(static_cast<double>(value.data[0]), value.data.length(),
+                  bool())
+    {
+      out.resize(value.data.length());
+      for (size_t i(0); i < out.size(); ++i)
+        {
+          out[i] = static_cast<double>(value.data[static_cast<unsigned int>(i)]);
+        }
+      return true;
+    }
+
+    // other types have no numeric representation
+    template <class DataType>
+    bool toNumeric(const DataType& /*value*/, std::vector<double>& /*out*/,
+                   ...)
+    {
+      return false;
+    }
+  } // namespace ConnectorDataFilterDetail
+
+  /*!
+   * @if jp
+   * @class ConnectorDataFilter
+   * @brief OutPort コネクタの送信側データフィルタ
+   *
+   * OutPort の書き込みパスでシリアライズ前にデータを間引くフィルタ。
+   * コネクタプロファイルの以下のプロパティで設定する。
+   *
+   * - filter.every_nth: N 個に 1 個のデータのみ送信する
+   * - filter.max_rate: 最大送信レート [Hz]
+   * - filter.deadband: 前回送信値からの変化量がこの値を超えた場合のみ送信
+   * - filter.predicate: 数値データに対する条件 (例: ">0.5", "!=0")
+   * - filter.on_change: bytes の場合、シリアライズ後のバイト列が前回と
+   *                     異なる場合のみ送信
+   * - filter.on_change.skip_bytes: 比較しない先頭バイト数
+   *                                (Timed* 型のタイムスタンプは 8)
+   *
+   * filter.deadband と filter.predicate は data メンバが数値または数値
+   * シーケンスである型にのみ適用され、その他の型では常に送信する。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class ConnectorDataFilter
+   * @brief Sender side data filter of OutPort connectors
+   *
+   * This filter decimates data in the OutPort write path before
+   * serialization. It is configured by the following connector
+   * properties.
+   *
+   * - filter.every_nth: Send only one of every N samples
+   * - filter.max_rate: Maximum sending rate [Hz]
+   * - filter.deadband: Send only when the value changed from the last
+   *                    sent value by more than this threshold
+   * - filter.predicate: Condition on numeric data (e.g. ">0.5", "!=0")
+   * - filter.on_change: If bytes, send only when the serialized bytes
+   *                     differ from the last sent ones
+   * - filter.on_change.skip_bytes: Number of leading bytes not compared
+   *                                (8 for the timestamp of Timed* types)
+   *
+   * filter.deadband and filter.predicate are applied only to types whose
+   * data member is a number or a sequence of numbers. Data of other types
+   * is always sent.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ConnectorDataFilter
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    ConnectorDataFilter();
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     *
+     * @param prop コネクタプロファイルの filter ノード
+     *
+     * @else
+     * @brief Initializing configuration
+     *
+     * @param prop "filter" node of the connector properties
+     *
+     * @endif
+     */
+    void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief シリアライズ前のデータを判定する
+     *
+     * every_nth、max_rate、deadband、predicate を評価する。
+     *
+     * @param data 書き込み対象データ
+     * @return true: 送信する, false: 破棄する
+     *
+     * @else
+     * @brief Examine data before serialization
+     *
+     * This operation evaluates every_nth, max_rate, deadband and
+     * predicate.
+     *
+     * @param data The target data for writing
+     * @return true: send, false: discard
+     *
+     * @endif
+     */
+    template <class DataType>
+    bool pass(const DataType& data)
+    {
+      if (!m_enabled) { return true; }
+      m_valueCaptured = false;
+      if (!passRate()) { return reject(); }
+      if (m_useValue &&
+          ConnectorDataFilterDetail::toNumeric(data, m_values, 0))
+        {
+          if (!passValue()) { return reject(); }
+          m_valueCaptured = true;
+        }
+      return true;
+    }
+
+    /*!
+     * @if jp
+     * @brief シリアライズ後のバイト列を判定する
+     *
+     * filter.on_change = bytes の場合に前回送信したバイト列と比較する。
+     *
+     * @param cdr シリアライズ済みデータ
+     * @return true: 送信する, false: 破棄する
+     *
+     * @else
+     * @brief Examine serialized bytes
+     *
+     * If filter.on_change is bytes, the data is compared with the last
+     * sent bytes.
+     *
+     * @param cdr Serialized data
+     * @return true: send, false: discard
+     *
+     * @endif
+     */
+    bool passBytes(const ByteDataStreamBase& cdr);
+
+    /*!
+     * @if jp
+     * @brief 送信を確定する
+     *
+     * pass() と passBytes() を通過したデータの送信時に呼び出し、比較用
+     * の前回値を更新する。
+     *
+     * @else
+     * @brief Commit sending
+     *
+     * This operation is called when data that passed pass() and
+     * passBytes() is sent, and updates the values used for comparison.
+     *
+     * @endif
+     */
+    void commit();
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     *
+     * filter.passed_count と filter.filtered_count を設定する。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics
+     *
+     * This operation sets filter.passed_count and filter.filtered_count.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) const;
+
+  private:
+    enum PredicateOp
+      {
+        PREDICATE_NONE,
+        PREDICATE_LT,
+        PREDICATE_LE,
+        PREDICATE_GT,
+        PREDICATE_GE,
+        PREDICATE_EQ,
+        PREDICATE_NE
+      };
+
+    bool passRate();
+    bool passValue() const;
+    bool reject();
+    bool parsePredicate(const std::string& predicate);
+
+    bool m_enabled;
+    unsigned long m_everyNth;
+    unsigned long m_nthCount;
+    std::chrono::steady_clock::duration m_minInterval;
+    std::chrono::steady_clock::time_point m_lastSent;
+    bool m_hasSent;
+
+    bool m_useValue;
+    double m_deadband;
+    PredicateOp m_predicateOp;
+    double m_predicateValue;
+    std::vector<double> m_values;
+    std::vector<double> m_lastValues;
+    bool m_hasValues;
+    bool m_valueCaptured;
+
+    bool m_onChange;
+    unsigned long m_skipBytes;
+    std::vector<unsigned char> m_bytes;
+    std::vector<unsigned char> m_lastBytes;
+    bool m_hasBytes;
+
+    std::atomic<unsigned long> m_passedCount;
+    std::atomic<unsigned long> m_filteredCount;
+  };
+} // namespace RTC
+
+#endif  // RTC_CONNECTORDATAFILTER_H
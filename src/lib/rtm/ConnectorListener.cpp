@@ -18,7 +18,10 @@
  */
 
 #include <rtm/ConnectorListener.h>
+#include <rtm/ConnectorBase.h>
+#include <cctype>
 #include <cstdint>
+#include <string>
 
 namespace RTC
 {
@@ -43,6 +46,37 @@ namespace RTC
    */
   ConnectorDataListener::~ConnectorDataListener() {}
 
+  /*!
+   * @if jp
+   * @brief コネクタのエンディアンを取得する
+   * @else
+   * @brief Get the endian of the connector
+   * @endif
+   */
+  bool ConnectorDataListener::isLittleEndian(const ConnectorInfo& info)
+  {
+    static const std::string key("serializer.cdr.endian");
+    static const char big[] = "big";
+    const std::string& endian(info.properties.getProperty(key));
+
+    // the first of the comma separated endians
+    std::string::size_type begin(endian.find_first_not_of(" \t"));
+    if (begin == std::string::npos) { return true; }
+    std::string::size_type end(endian.find_first_of(", \t", begin));
+    if (end == std::string::npos) { end = endian.size(); }
+
+    if (end - begin != sizeof(big) - 1) { return true; }
+    for (std::string::size_type i(0); i < sizeof(big) - 1; ++i)
+      {
+        if (std::tolower(static_cast<unsigned char>(endian[begin + i]))
+            != big[i])
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
   /*!
    * @if jp
    * @class ConnectorListener クラス
@@ -463,6 +463,36 @@ namespace RTC
      */
     virtual ~ConnectorDataListener();
 
+    /*!
+     * @if jp
+     *
+     * @brief コネクタのエンディアンを取得する
+     *
+     * serializer.cdr.endian プロパティの最初のエンディアンを返す。
+     * データごとに呼ばれるため、文字列をコピー、分割せずにその場で比較
+     * する。"big" 以外はリトルエンディアンとする。
+     *
+     * @param info ConnectorInfo
+     *
+     * @return リトルエンディアン(true)、ビッグエンディアン(false)
+     *
+     * @else
+     *
+     * @brief Get the endian of the connector
+     *
+     * This returns the first endian of the serializer.cdr.endian
+     * property. It is called for every data, so the string is compared
+     * in place without copying or splitting it. Anything other than
+     * "big" is taken as little endian.
+     *
+     * @param info ConnectorInfo
+     *
+     * @return little endian (true), big endian (false)
+     *
+     * @endif
+     */
+    static bool isLittleEndian(const ConnectorInfo& info);
+
     /*!
      * @if jp
      *
@@ -521,7 +551,14 @@ namespace RTC
      * @brief Destructor
      * @endif
      */
-    ~ConnectorDataListenerT() override {}
+    ~ConnectorDataListenerT() override
+    {
+      if (m_cdr != nullptr)
+        {
+          coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+            instance().deleteObject(m_cdr);
+        }
+    }
 
     /*!
      * @if jp
@@ -551,57 +588,41 @@ namespace RTC
     ReturnCode operator()(ConnectorInfo& info,
                                   ByteData& cdrdata, const std::string& marshalingtype) override
     {
-      DataType data;
-      
-      ByteDataStream<DataType> *cdr = coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().createObject(marshalingtype);
-      
-      
-      if (!cdr)
-      {
-          return NO_CHANGE;
-      }
-      
-      
-      cdr->writeData(cdrdata.getBuffer(), cdrdata.getDataLength());
-      // endian type check
-      std::string endian_type;
-      endian_type = info.properties.getProperty("serializer.cdr.endian",
-                                                "little");
-      coil::normalize(endian_type);
-      std::vector<std::string> endian(coil::split(endian_type, ","));
+      auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                    instance());
 
-      if (endian[0] == "little")
-      {
-          cdr->isLittleEndian(true);
-      }
-      else if (endian[0] == "big")
-      {
-          cdr->isLittleEndian(false);
-      }
-
-      cdr->deserialize(data);
-
-      ReturnCode ret = this->operator()(info, data);
-      if (ret == DATA_CHANGED || ret == BOTH_CHANGED)
-      {
-          if (endian[0] == "little")
+      // reuse the serializer and the storage of the previous sample
+      // unless another thread is deserializing into them
+      std::unique_lock<std::mutex> guard(m_dataMutex, std::try_to_lock);
+      if (!guard.owns_lock())
+        {
+          ByteDataStream<DataType> *cdr = factory.createObject(marshalingtype);
+          if (!cdr)
           {
-              cdr->isLittleEndian(true);
+              return NO_CHANGE;
           }
-          else if (endian[0] == "big")
+          DataType tmp;
+          ReturnCode ret = convert(info, cdrdata, *cdr, tmp);
+          factory.deleteObject(cdr);
+          return ret;
+        }
+
+      // createObject() allocates the factory's bookkeeping, so the
+      // serializer is created again only if the marshaling type changes
+      if (m_cdr == nullptr || m_cdrType != marshalingtype)
+        {
+          if (m_cdr != nullptr)
+            {
+              factory.deleteObject(m_cdr);
+            }
+          m_cdr = factory.createObject(marshalingtype);
+          if (!m_cdr)
           {
-              cdr->isLittleEndian(false);
+              return NO_CHANGE;
           }
-
-          cdr->serialize(data);
-      }
-
-      cdrdata.setDataLength(cdr->getDataLength());
-      cdr->readData(cdrdata.getBuffer(), cdrdata.getDataLength());
-
-      coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().deleteObject(cdr);
-  
-      return ret;
+          m_cdrType = marshalingtype;
+        }
+      return convert(info, cdrdata, *m_cdr, m_data);
     }
 
     /*!
@@ -623,6 +644,70 @@ namespace RTC
      */
     virtual ReturnCode operator()(ConnectorInfo& info,
                                  DataType& data) = 0;
+
+  private:
+    /*!
+     * @if jp
+     * @brief データを復号化してコールバックメソッドを呼び出す
+     * @else
+     * @brief Deserialize data and invoke the callback method
+     * @endif
+     */
+    ReturnCode convert(ConnectorInfo& info, ByteData& cdrdata,
+                       ByteDataStream<DataType>& cdr, DataType& data)
+    {
+      cdr.attachData(cdrdata.getBuffer(), cdrdata.getDataLength());
+      // endian type check
+      bool little_endian(ConnectorDataListener::isLittleEndian(info));
+      cdr.isLittleEndian(little_endian);
+
+      cdr.deserialize(data);
+
+      ReturnCode ret = this->operator()(info, data);
+      if (ret == DATA_CHANGED || ret == BOTH_CHANGED)
+      {
+          cdr.isLittleEndian(little_endian);
+
+          cdr.serialize(data);
+          cdrdata.setDataLength(cdr.getDataLength());
+          cdr.readData(cdrdata.getBuffer(), cdrdata.getDataLength());
+      }
+      return ret;
+    }
+
+    /*!
+     * @if jp
+     * @brief 復号化したデータ
+     *
+     * シーケンスの領域を次のデータで再利用するために保持する。
+     * このため、データを復号化したリスナは最後のデータ1つ分のメモリ
+     * (画像の型では画像1枚分) を接続が切れた後も保持し続ける。データを
+     * 復号化する前に戻るリスナ (別のポリシーの Timestamp など) は保持
+     * しない。
+     *
+     * @else
+     * @brief The deserialized data
+     *
+     * This is kept to reuse the storage of sequences for the next data.
+     * Hence a listener that has deserialized data keeps the memory of
+     * one last data (one image for image types), even after the
+     * connection is closed. Listeners that return before deserializing
+     * the data (e.g. Timestamp of another policy) keep nothing.
+     *
+     * @endif
+     */
+    DataType m_data;
+
+    /*!
+     * @if jp
+     * @brief m_data の復号化に再利用するシリアライザとその種類
+     * @else
+     * @brief Serializer reused to deserialize m_data, and its type
+     * @endif
+     */
+    ByteDataStream<DataType>* m_cdr{nullptr};
+    std::string m_cdrType;
+    std::mutex m_dataMutex;
   };
 
   /*!
@@ -1152,13 +1237,8 @@ namespace RTC
       std::lock_guard<std::mutex> guard(m_mutex);
       ReturnCode ret(NO_CHANGE);
 
-      std::string endian_type;
-      endian_type = info.properties.getProperty("serializer.cdr.endian",
-          "little");
-      coil::normalize(endian_type);
-      std::vector<std::string> endian(coil::split(endian_type, ","));
+      bool little_endian(ConnectorDataListener::isLittleEndian(info));
 
-      
 
       for (auto & listener : m_listeners)
         {
@@ -1176,17 +1256,11 @@ namespace RTC
               ByteDataStream<DataType> *cdr = coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().createObject(marshalingtype);
 
               
-              if (endian[0] == "little")
-              {
-                  cdr->isLittleEndian(true);
-              }
-              else if (endian[0] == "big")
-              {
-                  cdr->isLittleEndian(false);
-              }
+              cdr->isLittleEndian(little_endian);
               cdr->serialize(typeddata);
-              ByteData tmp = *cdr;
-              ret = ret | listener.first->operator()(info, tmp, marshalingtype);
+              m_data = *cdr;
+              ret = ret | listener.first->operator()(info, m_data,
+                                                     marshalingtype);
               coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().deleteObject(cdr);
             }
         }
@@ -1196,6 +1270,22 @@ namespace RTC
   private:
     std::vector<Entry> m_listeners;
     std::mutex m_mutex;
+    /*!
+     * @if jp
+     * @brief 型付きのデータを渡されたリスナ向けに符号化したデータ
+     *
+     * 領域を再利用するため、最後に符号化したデータの大きさの領域を保持
+     * し続ける。
+     *
+     * @else
+     * @brief The data serialized for listeners notified of typed data
+     *
+     * This keeps storage of the size of the last serialized data, so
+     * that it is reused.
+     *
+     * @endif
+     */
+    ByteData m_data;
   };
 
 
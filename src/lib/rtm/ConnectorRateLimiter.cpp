@@ -0,0 +1,305 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ConnectorRateLimiter.cpp
+ * @brief Token bucket based rate limiter for publishers
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <coil/stringutil.h>
+#include <rtm/ConnectorRateLimiter.h>
+
+#include <algorithm>
+#include <map>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TokenBucket::TokenBucket(double rate, double burst)
+    : m_rate(rate), m_burst(burst), m_tokens(burst),
+      m_last(std::chrono::steady_clock::now())
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief トークンを消費する
+   * @else
+   * @brief Consume tokens
+   * @endif
+   */
+  bool TokenBucket::tryConsume(double n)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    refill(std::chrono::steady_clock::now());
+    if (m_tokens < std::min(n, m_burst)) { return false; }
+    m_tokens -= n;
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 消費したトークンを戻す
+   * @else
+   * @brief Give back consumed tokens
+   * @endif
+   */
+  void TokenBucket::refund(double n)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_tokens = std::min(m_tokens + n, m_burst);
+  }
+
+  /*!
+   * @if jp
+   * @brief n 個のトークンが利用可能になるまでの時間を取得する
+   * @else
+   * @brief Get the time until n tokens become available
+   * @endif
+   */
+  std::chrono::nanoseconds TokenBucket::waitTime(double n)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    refill(std::chrono::steady_clock::now());
+    double shortage(std::min(n, m_burst) - m_tokens);
+    if (shortage <= 0.0) { return std::chrono::nanoseconds::zero(); }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::duration<double>(shortage / m_rate));
+  }
+
+  void TokenBucket::refill(std::chrono::steady_clock::time_point now)
+  {
+    std::chrono::duration<double> elapsed(now - m_last);
+    m_last = now;
+    m_tokens = std::min(m_tokens + elapsed.count() * m_rate, m_burst);
+  }
+
+  //============================================================
+  // ConnectorRateLimiter
+  //============================================================
+  /*!
+   * @if jp
+   * @brief バイトとサンプル数のバケットの組
+   * @else
+   * @brief A pair of byte and sample buckets
+   * @endif
+   */
+  struct ConnectorRateLimiter::Budget
+  {
+    std::unique_ptr<TokenBucket> bytes;
+    std::unique_ptr<TokenBucket> samples;
+
+    bool tryAcquire(size_t size)
+    {
+      if (bytes && !bytes->tryConsume(static_cast<double>(size)))
+        {
+          return false;
+        }
+      if (samples && !samples->tryConsume(1.0))
+        {
+          if (bytes) { bytes->refund(static_cast<double>(size)); }
+          return false;
+        }
+      return true;
+    }
+
+    void refund(size_t size)
+    {
+      if (bytes) { bytes->refund(static_cast<double>(size)); }
+      if (samples) { samples->refund(1.0); }
+    }
+
+    std::chrono::nanoseconds waitTime(size_t size)
+    {
+      std::chrono::nanoseconds wait(std::chrono::nanoseconds::zero());
+      if (bytes) { wait = std::max(wait, bytes->waitTime(static_cast<double>(size))); }
+      if (samples) { wait = std::max(wait, samples->waitTime(1.0)); }
+      return wait;
+    }
+  };
+
+  namespace
+  {
+    double getRate(const coil::Properties& prop, const char* key)
+    {
+      double rate(0.0);
+      if (!coil::stringTo(rate, prop.getProperty(key, "0").c_str()) ||
+          rate < 0.0)
+        {
+          return 0.0;
+        }
+      return rate;
+    }
+
+    std::shared_ptr<ConnectorRateLimiter::Budget>
+    createBudget(const coil::Properties& prop)
+    {
+      double bps(getRate(prop, "bytes_per_sec"));
+      double sps(getRate(prop, "samples_per_sec"));
+      if (bps <= 0.0 && sps <= 0.0) { return nullptr; }
+
+      std::shared_ptr<ConnectorRateLimiter::Budget>
+        budget(new ConnectorRateLimiter::Budget());
+      if (bps > 0.0)
+        {
+          double burst(getRate(prop, "burst_bytes"));
+          if (burst <= 0.0) { burst = bps * 0.1; }
+          budget->bytes.reset(new TokenBucket(bps, burst));
+        }
+      if (sps > 0.0)
+        {
+          double burst(getRate(prop, "burst_samples"));
+          if (burst <= 0.0) { burst = std::max(sps * 0.1, 1.0); }
+          budget->samples.reset(new TokenBucket(sps, burst));
+        }
+      return budget;
+    }
+
+    // Budgets shared among connectors in the process. A budget lives
+    // while at least one connector refers to it.
+    std::shared_ptr<ConnectorRateLimiter::Budget>
+    sharedBudget(const std::string& name, const coil::Properties& prop)
+    {
+      static std::mutex mutex;
+      static std::map<std::string,
+                      std::weak_ptr<ConnectorRateLimiter::Budget> > budgets;
+
+      std::lock_guard<std::mutex> guard(mutex);
+      std::shared_ptr<ConnectorRateLimiter::Budget> budget(budgets[name].lock());
+      if (!budget)
+        {
+          budget = createBudget(prop);
+          budgets[name] = budget;
+        }
+      return budget;
+    }
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  ConnectorRateLimiter::ConnectorRateLimiter()
+    : m_enabled(false), m_sentCount(0), m_sentBytes(0),
+      m_limitedCount(0), m_droppedCount(0)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  ConnectorRateLimiter::~ConnectorRateLimiter() = default;
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void ConnectorRateLimiter::init(const coil::Properties& prop)
+  {
+    m_budgets[0] = createBudget(prop);
+
+    const coil::Properties* port(prop.findNode("port"));
+    std::string port_name(prop.getProperty("port.budget"));
+    if (port != nullptr && !port_name.empty())
+      {
+        m_budgets[1] = sharedBudget("port:" + port_name, *port);
+      }
+
+    const coil::Properties* shared(prop.findNode("shared"));
+    std::string shared_name(prop.getProperty("shared.budget"));
+    if (shared != nullptr && !shared_name.empty())
+      {
+        m_budgets[2] = sharedBudget("shared:" + shared_name, *shared);
+      }
+
+    m_enabled = m_budgets[0] || m_budgets[1] || m_budgets[2];
+  }
+
+  /*!
+   * @if jp
+   * @brief 1 サンプル分の送信枠を獲得する
+   * @else
+   * @brief Acquire the budget for one sample
+   * @endif
+   */
+  bool ConnectorRateLimiter::tryAcquire(size_t bytes)
+  {
+    if (!m_enabled) { return true; }
+    for (size_t i(0); i < 3; ++i)
+      {
+        if (!m_budgets[i]) { continue; }
+        if (!m_budgets[i]->tryAcquire(bytes))
+          {
+            // give back what the narrower levels already consumed
+            for (size_t j(0); j < i; ++j)
+              {
+                if (m_budgets[j]) { m_budgets[j]->refund(bytes); }
+              }
+            ++m_limitedCount;
+            return false;
+          }
+      }
+    ++m_sentCount;
+    m_sentBytes += static_cast<unsigned long>(bytes);
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信枠が得られるまでの時間を取得する
+   * @else
+   * @brief Get the time until the budget becomes available
+   * @endif
+   */
+  std::chrono::nanoseconds ConnectorRateLimiter::waitTime(size_t bytes)
+  {
+    std::chrono::nanoseconds wait(std::chrono::nanoseconds::zero());
+    for (auto& budget : m_budgets)
+      {
+        if (budget) { wait = std::max(wait, budget->waitTime(bytes)); }
+      }
+    return wait;
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get statistics
+   * @endif
+   */
+  void ConnectorRateLimiter::getStatistics(coil::Properties& stat) const
+  {
+    if (!m_enabled) { return; }
+    stat.setProperty("rate_limit.sent_count", coil::otos(m_sentCount.load()));
+    stat.setProperty("rate_limit.sent_bytes", coil::otos(m_sentBytes.load()));
+    stat.setProperty("rate_limit.limited_count",
+                     coil::otos(m_limitedCount.load()));
+    stat.setProperty("rate_limit.dropped_count",
+                     coil::otos(m_droppedCount.load()));
+  }
+} // namespace RTC
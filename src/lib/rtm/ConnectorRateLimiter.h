@@ -0,0 +1,279 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ConnectorRateLimiter.h
+ * @brief Token bucket based rate limiter for publishers
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_CONNECTORRATELIMITER_H
+#define RTC_CONNECTORRATELIMITER_H
+
+#include <coil/Properties.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TokenBucket
+   * @brief トークンバケット
+   *
+   * rate [トークン/秒] で補充され、最大 burst 個のトークンを保持する。
+   * burst を超える要求はバケットが満杯の場合に限り受け付け、不足分は
+   * 次回以降の補充から差し引く。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class TokenBucket
+   * @brief Token bucket
+   *
+   * The bucket is refilled at rate [tokens/s] and holds at most burst
+   * tokens. A request larger than burst is accepted only when the bucket
+   * is full, and the shortage is paid back from later refills.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class TokenBucket
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @param rate 補充レート [トークン/秒]
+     * @param burst バケット容量
+     * @else
+     * @brief Constructor
+     * @param rate Refill rate [tokens/s]
+     * @param burst Bucket capacity
+     * @endif
+     */
+    TokenBucket(double rate, double burst);
+
+    /*!
+     * @if jp
+     * @brief トークンを消費する
+     * @param n 消費するトークン数
+     * @return true: 消費した, false: トークン不足
+     * @else
+     * @brief Consume tokens
+     * @param n Number of tokens to consume
+     * @return true: consumed, false: not enough tokens
+     * @endif
+     */
+    bool tryConsume(double n);
+
+    /*!
+     * @if jp
+     * @brief 消費したトークンを戻す
+     * @param n 戻すトークン数
+     * @else
+     * @brief Give back consumed tokens
+     * @param n Number of tokens to give back
+     * @endif
+     */
+    void refund(double n);
+
+    /*!
+     * @if jp
+     * @brief n 個のトークンが利用可能になるまでの時間を取得する
+     * @param n トークン数
+     * @return 待ち時間
+     * @else
+     * @brief Get the time until n tokens become available
+     * @param n Number of tokens
+     * @return Waiting time
+     * @endif
+     */
+    std::chrono::nanoseconds waitTime(double n);
+
+    double rate() const { return m_rate; }
+    double burst() const { return m_burst; }
+
+  private:
+    void refill(std::chrono::steady_clock::time_point now);
+
+    const double m_rate;
+    const double m_burst;
+    double m_tokens;
+    std::chrono::steady_clock::time_point m_last;
+    std::mutex m_mutex;
+  };
+
+  /*!
+   * @if jp
+   * @class ConnectorRateLimiter
+   * @brief Publisher 用レート制限
+   *
+   * コネクタ単位、ポート単位、プロセス内で共有する名前付きバジェットの
+   * 3 段階でバイトレートとサンプルレートを制限する。コネクタプロファイ
+   * ルの publisher.rate_limit ノードの以下のプロパティで設定する。
+   *
+   * - bytes_per_sec, samples_per_sec: コネクタ単位の制限
+   * - burst_bytes, burst_samples: コネクタ単位のバースト量
+   * - port.*: 同じ OutPort の全コネクタで共有する制限
+   * - shared.budget: プロセス内で共有するバジェット名
+   * - shared.*: 共有バジェットの制限 (最初に生成したコネクタの値を使用)
+   *
+   * バースト量を省略した場合はレートの 0.1 秒分(最小 1 サンプル)となる。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class ConnectorRateLimiter
+   * @brief Rate limiter for publishers
+   *
+   * This class limits the byte rate and the sample rate at three
+   * levels: per connector, per port, and a named budget shared in the
+   * process. It is configured by the following properties under the
+   * publisher.rate_limit node of the connector properties.
+   *
+   * - bytes_per_sec, samples_per_sec: per connector limits
+   * - burst_bytes, burst_samples: per connector burst sizes
+   * - port.*: limits shared by all connectors of the same OutPort
+   * - shared.budget: name of a budget shared in the process
+   * - shared.*: limits of the shared budget (the values of the connector
+   *             that creates the budget are used)
+   *
+   * If a burst size is omitted, 0.1 seconds worth of the rate (at least
+   * one sample) is used.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ConnectorRateLimiter
+  {
+  public:
+    struct Budget;
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    ConnectorRateLimiter();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~ConnectorRateLimiter();
+
+    /*!
+     * @if jp
+     * @brief 設定初期化
+     * @param prop コネクタプロファイルの publisher.rate_limit ノード
+     * @else
+     * @brief Initializing configuration
+     * @param prop publisher.rate_limit node of the connector properties
+     * @endif
+     */
+    void init(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief レート制限が有効か
+     * @else
+     * @brief Whether rate limiting is enabled
+     * @endif
+     */
+    bool enabled() const { return m_enabled; }
+
+    /*!
+     * @if jp
+     * @brief 1 サンプル分の送信枠を獲得する
+     *
+     * 全ての段階で枠がある場合のみ消費する。
+     *
+     * @param bytes サンプルのバイト数
+     * @return true: 送信可能, false: 制限超過
+     *
+     * @else
+     * @brief Acquire the budget for one sample
+     *
+     * The budget is consumed only if every level has enough tokens.
+     *
+     * @param bytes Size of the sample in bytes
+     * @return true: ready to send, false: over the limit
+     *
+     * @endif
+     */
+    bool tryAcquire(size_t bytes);
+
+    /*!
+     * @if jp
+     * @brief 送信枠が得られるまでの時間を取得する
+     * @param bytes サンプルのバイト数
+     * @return 待ち時間
+     * @else
+     * @brief Get the time until the budget becomes available
+     * @param bytes Size of the sample in bytes
+     * @return Waiting time
+     * @endif
+     */
+    std::chrono::nanoseconds waitTime(size_t bytes);
+
+    /*!
+     * @if jp
+     * @brief 制限により破棄したサンプルを記録する
+     * @else
+     * @brief Record a sample discarded by the limit
+     * @endif
+     */
+    void countDrop() { ++m_droppedCount; }
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     *
+     * rate_limit.sent_count, rate_limit.sent_bytes,
+     * rate_limit.limited_count, rate_limit.dropped_count を設定する。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics
+     *
+     * This operation sets rate_limit.sent_count, rate_limit.sent_bytes,
+     * rate_limit.limited_count and rate_limit.dropped_count.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) const;
+
+  private:
+    bool m_enabled;
+    std::shared_ptr<Budget> m_budgets[3];
+    std::atomic<unsigned long> m_sentCount;
+    std::atomic<unsigned long> m_sentBytes;
+    std::atomic<unsigned long> m_limitedCount;
+    std::atomic<unsigned long> m_droppedCount;
+  };
+} // namespace RTC
+
+#endif  // RTC_CONNECTORRATELIMITER_H
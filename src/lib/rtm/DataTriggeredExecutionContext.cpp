@@ -0,0 +1,284 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DataTriggeredExecutionContext.cpp
+ * @brief ExecutionContext executing components on data arrival
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/DataTriggeredExecutionContext.h>
+#include <rtm/InPortBase.h>
+#include <rtm/RTObject.h>
+#include <coil/stringutil.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @brief デフォルトコンストラクタ
+   * @else
+   * @brief Default constructor
+   * @endif
+   */
+  DataTriggeredExecutionContext::DataTriggeredExecutionContext()
+    : PeriodicExecutionContext(), m_owner(nullptr),
+      m_minInterval(0), m_fallback(true), m_portsChanged(true)
+  {
+    RTC_TRACE(("DataTriggeredExecutionContext()"));
+    setKind(RTC::EVENT_DRIVEN);
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  DataTriggeredExecutionContext::~DataTriggeredExecutionContext()
+  {
+    RTC_TRACE(("~DataTriggeredExecutionContext()"));
+    // the thread must stop before the WaitSet is destroyed
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      m_svc = false;
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_workerthread.mutex_);
+      m_workerthread.running_ = true;
+      m_workerthread.cond_.notify_one();
+    }
+    m_wakeup.notify();
+    wait();
+    m_waitset.clear();
+  }
+
+  void DataTriggeredExecutionContext::init(coil::Properties& props)
+  {
+    RTC_TRACE(("init()"));
+    PeriodicExecutionContext::init(props);
+
+    m_triggerPorts = coil::split(props["trigger_ports"], ",", true);
+    double interval(0.0);
+    getProperty(props, "min_interval", interval);
+    m_minInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(std::max(interval, 0.0)));
+    m_fallback = coil::toBool(props["fallback"], "YES", "NO", true);
+    m_portsChanged = true;
+
+    RTC_DEBUG(("trigger_ports: %s", props["trigger_ports"].c_str()));
+    RTC_DEBUG(("min_interval:  %f [s]", interval));
+    RTC_DEBUG(("fallback:      %s", m_fallback ? "YES" : "NO"));
+  }
+
+  /*!
+   * @if jp
+   * @brief ExecutionContext 用のスレッド実行関数
+   * @else
+   * @brief Thread execution function for ExecutionContext
+   * @endif
+   */
+  int DataTriggeredExecutionContext::svc()
+  {
+    RTC_TRACE(("svc()"));
+    std::chrono::steady_clock::time_point last(
+      std::chrono::steady_clock::now());
+    std::vector<size_t> ready;
+
+    do
+      {
+        ExecutionContextBase::invokeWorkerPreDo();
+        {
+          std::unique_lock<std::mutex> guard(m_workerthread.mutex_);
+          while (!m_workerthread.running_)
+            {
+              m_workerthread.cond_.wait(guard);
+            }
+        }
+        if (m_portsChanged.exchange(false)) { updateTriggerPorts(); }
+
+        Trigger trigger(waitTrigger(last));
+        if (trigger == WAKEUP) { continue; }
+        if (trigger == DATA)
+          {
+            std::this_thread::sleep_until(last + m_minInterval);
+            // data arrived so far is processed by this execution
+            m_waitset.wait(ready, std::chrono::nanoseconds::zero());
+          }
+        last = std::chrono::steady_clock::now();
+        ExecutionContextBase::invokeWorkerDo();
+        ExecutionContextBase::invokeWorkerPostDo();
+      } while (threadRunning());
+
+    RTC_DEBUG(("Thread terminated."));
+    return 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief コンポーネントをバインドする。
+   * @else
+   * @brief Bind the component.
+   * @endif
+   */
+  RTC::ReturnCode_t
+  DataTriggeredExecutionContext::bindComponent(RTC::RTObject_impl* rtc)
+  {
+    RTC::ReturnCode_t ret(ExecutionContextBase::bindComponent(rtc));
+    if (ret == RTC::RTC_OK)
+      {
+        m_owner = rtc;
+        m_portsChanged = true;
+      }
+    return ret;
+  }
+
+  /*!
+   * @brief onStopping() template function
+   */
+  RTC::ReturnCode_t DataTriggeredExecutionContext::onStopping()
+  {
+    RTC::ReturnCode_t ret(PeriodicExecutionContext::onStopping());
+    m_wakeup.notify();
+    return ret;
+  }
+
+  /*!
+   * @brief onWaitingActivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredExecutionContext::
+  onWaitingActivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC::ReturnCode_t ret(
+      PeriodicExecutionContext::onWaitingActivated(comp, count));
+    // ports are created by onInitialize and may have changed
+    m_portsChanged = true;
+    m_wakeup.notify();
+    return ret;
+  }
+
+  /*!
+   * @brief onWaitingDeactivated() template function
+   */
+  RTC::ReturnCode_t DataTriggeredExecutionContext::
+  onWaitingDeactivated(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC::ReturnCode_t ret(
+      PeriodicExecutionContext::onWaitingDeactivated(comp, count));
+    m_wakeup.notify();
+    return ret;
+  }
+
+  /*!
+   * @brief onWaitingReset() template function
+   */
+  RTC::ReturnCode_t DataTriggeredExecutionContext::
+  onWaitingReset(RTC_impl::RTObjectStateMachine* comp, long int count)
+  {
+    RTC::ReturnCode_t ret(
+      PeriodicExecutionContext::onWaitingReset(comp, count));
+    m_wakeup.notify();
+    return ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行のきっかけを待つ
+   * @else
+   * @brief Wait for a trigger of execution
+   * @endif
+   */
+  DataTriggeredExecutionContext::Trigger
+  DataTriggeredExecutionContext::
+  waitTrigger(std::chrono::steady_clock::time_point last)
+  {
+    std::chrono::nanoseconds timeout(std::chrono::nanoseconds::max());
+    if (m_fallback)
+      {
+        timeout = std::max(std::chrono::nanoseconds::zero(),
+                           std::chrono::duration_cast<
+                           std::chrono::nanoseconds>(
+                             last + getPeriod() -
+                             std::chrono::steady_clock::now()));
+      }
+    std::vector<size_t> ready;
+    if (!m_waitset.wait(ready, timeout)) { return PERIOD; }
+    // index 0 is m_wakeup
+    if (ready.size() == 1 && ready[0] == 0) { return WAKEUP; }
+    return DATA;
+  }
+
+  /*!
+   * @if jp
+   * @brief 待機する InPort を WaitSet に登録し直す
+   * @else
+   * @brief Attach the InPorts to wait for to the WaitSet again
+   * @endif
+   */
+  void DataTriggeredExecutionContext::updateTriggerPorts()
+  {
+    RTC_TRACE(("updateTriggerPorts()"));
+    m_waitset.clear();
+    m_waitset.attach(m_wakeup);
+    if (m_owner == nullptr) { return; }
+
+    size_t count(0);
+    for (auto port : m_owner->getInPorts())
+      {
+        // port names are prefixed by the instance name
+        std::string name(port->getName());
+        std::string::size_type pos(name.rfind('.'));
+        std::string local(pos == std::string::npos ?
+                          name : name.substr(pos + 1));
+        if (!m_triggerPorts.empty() &&
+            std::find(m_triggerPorts.begin(), m_triggerPorts.end(), name)
+            == m_triggerPorts.end() &&
+            std::find(m_triggerPorts.begin(), m_triggerPorts.end(), local)
+            == m_triggerPorts.end())
+          {
+            continue;
+          }
+        // attached as a notifier to be woken only by new data
+        m_waitset.attach(port->getEventNotifier());
+        RTC_DEBUG(("trigger port: %s", name.c_str()));
+        ++count;
+      }
+    if (count == 0)
+      {
+        RTC_WARN(("No trigger port found. Executed only by fallback."));
+      }
+  }
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void DataTriggeredExecutionContextInit(RTC::Manager*  /*manager*/)
+  {
+    RTC::ExecutionContextFactory::
+      instance().addFactory("DataTriggeredExecutionContext",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::DataTriggeredExecutionContext>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::DataTriggeredExecutionContext>);
+  }
+}
@@ -0,0 +1,213 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DataTriggeredExecutionContext.h
+ * @brief ExecutionContext executing components on data arrival
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DATATRIGGEREDEXECUTIONCONTEXT_H
+#define RTC_DATATRIGGEREDEXECUTIONCONTEXT_H
+
+#include <rtm/PeriodicExecutionContext.h>
+#include <rtm/EventNotifier.h>
+#include <rtm/WaitSet.h>
+
+#include <atomic>
+#include <chrono>
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @class DataTriggeredExecutionContext
+   * @brief データ到着で実行する ExecutionContext クラス
+   *
+   * オーナーコンポーネントの InPort にデータが到着したときに
+   * on_execute を実行する ExecutionContext。以下のプロパティを
+   * exec_cxt.periodic 以下に指定する。
+   *
+   * - trigger_ports: 実行のきっかけとする InPort 名のカンマ区切りリス
+   *                  ト。空の場合はすべての InPort。
+   * - min_interval: 実行の最小間隔 [s]。間隔内に到着したデータはまと
+   *                 めて次の実行で処理される。デフォルトは 0。
+   * - fallback: YES の場合、データが到着しなくても rate で決まる周期
+   *             で実行する。デフォルトは YES。
+   *
+   * 待機中に複数のデータが到着しても実行は一度にまとめられる。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class DataTriggeredExecutionContext
+   * @brief ExecutionContext class executing on data arrival
+   *
+   * This ExecutionContext executes on_execute when data arrives at the
+   * InPorts of the owner component. The following properties are given
+   * under exec_cxt.periodic.
+   *
+   * - trigger_ports: Comma separated list of the names of the InPorts
+   *                  triggering the execution. All InPorts if empty.
+   * - min_interval: The minimum interval of executions [s]. Data
+   *                 arriving within the interval is processed together
+   *                 by the next execution. The default is 0.
+   * - fallback: If YES, the component is executed at the period given
+   *             by rate even if no data arrives. The default is YES.
+   *
+   * Bursts of data arriving while waiting are coalesced into one
+   * execution.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class DataTriggeredExecutionContext
+    : public virtual RTC_exp::PeriodicExecutionContext
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief デフォルトコンストラクタ
+     *
+     * プロファイルの kind を EVENT_DRIVEN に設定する。
+     *
+     * @else
+     * @brief Default Constructor
+     *
+     * The kind of the profile is set to EVENT_DRIVEN.
+     *
+     * @endif
+     */
+    DataTriggeredExecutionContext();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~DataTriggeredExecutionContext() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContextの初期化を行う
+     * @else
+     * @brief Initialize the ExecutionContext
+     * @endif
+     */
+    void init(coil::Properties& props) override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContext 用のスレッド実行関数
+     *
+     * データの到着、フォールバック周期の経過、または状態遷移の要求を待
+     * ち、データの到着またはフォールバック周期の経過でコンポーネントを
+     * 実行する。
+     *
+     * @return 実行結果
+     *
+     * @else
+     * @brief Thread execution function for ExecutionContext
+     *
+     * This waits for data arrival, the fallback period or a state
+     * transition request, and executes the components on data arrival
+     * or when the fallback period elapses.
+     *
+     * @return The execution result
+     *
+     * @endif
+     */
+    int svc() override;
+
+    /*!
+     * @if jp
+     * @brief コンポーネントをバインドする。
+     * @else
+     * @brief Bind the component.
+     * @endif
+     */
+    RTC::ReturnCode_t bindComponent(RTC::RTObject_impl* rtc) override;
+
+  protected:
+    RTC::ReturnCode_t onStopping() override;
+    RTC::ReturnCode_t
+    onWaitingActivated(RTC_impl::RTObjectStateMachine* comp,
+                       long int count) override;
+    RTC::ReturnCode_t
+    onWaitingDeactivated(RTC_impl::RTObjectStateMachine* comp,
+                         long int count) override;
+    RTC::ReturnCode_t
+    onWaitingReset(RTC_impl::RTObjectStateMachine* comp,
+                   long int count) override;
+
+    /*!
+     * @if jp
+     * @brief 実行のきっかけ
+     * @else
+     * @brief Trigger of execution
+     * @endif
+     */
+    enum Trigger
+      {
+        DATA,
+        PERIOD,
+        WAKEUP
+      };
+
+    /*!
+     * @if jp
+     * @brief 実行のきっかけを待つ
+     * @param last 前回の実行時刻
+     * @return 実行のきっかけ
+     * @else
+     * @brief Wait for a trigger of execution
+     * @param last The time of the previous execution
+     * @return The trigger
+     * @endif
+     */
+    Trigger waitTrigger(std::chrono::steady_clock::time_point last);
+
+    /*!
+     * @if jp
+     * @brief 待機する InPort を WaitSet に登録し直す
+     * @else
+     * @brief Attach the InPorts to wait for to the WaitSet again
+     * @endif
+     */
+    void updateTriggerPorts();
+
+    RTC::RTObject_impl* m_owner;
+    coil::vstring m_triggerPorts;
+    std::chrono::nanoseconds m_minInterval;
+    bool m_fallback;
+    RTC::WaitSet m_waitset;
+    // wakes the thread for state transitions and stopping
+    RTC::EventNotifier m_wakeup;
+    std::atomic<bool> m_portsChanged;
+  };  // class DataTriggeredExecutionContext
+} // namespace RTC_exp
+
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void DataTriggeredExecutionContextInit(RTC::Manager* manager);
+}
+
+#endif  // RTC_DATATRIGGEREDEXECUTIONCONTEXT_H
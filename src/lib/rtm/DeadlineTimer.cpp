@@ -0,0 +1,244 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DeadlineTimer.cpp
+ * @brief Waiting until an absolute deadline
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/DeadlineTimer.h>
+#include <rtm/Barrier.h>
+#include <coil/stringutil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef RTM_OS_LINUX
+#include <cerrno>
+#include <time.h>
+#endif
+
+namespace
+{
+  // sleeps until an absolute time, so that wake-up latency does not shift
+  // the following deadlines
+  void sleepAbsolute(RTC::DeadlineTimer::Clock::time_point deadline)
+  {
+#ifdef RTM_OS_LINUX
+    // steady_clock is CLOCK_MONOTONIC on Linux
+    auto since(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      deadline.time_since_epoch()).count());
+    struct timespec ts;
+    ts.tv_sec = static_cast<time_t>(since / 1000000000);
+    ts.tv_nsec = static_cast<long>(since % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr)
+           == EINTR) {}
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+  }
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  DeadlineTimer::DeadlineTimer()
+    : m_mode(SLEEP), m_yield(false), m_maxMargin(0),
+      m_mean(-1.0), m_deviation(0.0), m_margin(0)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief 待機の方法を設定する
+   * @else
+   * @brief Set how to wait
+   * @endif
+   */
+  void DeadlineTimer::setMode(Mode mode,
+                              std::chrono::nanoseconds margin,
+                              std::chrono::nanoseconds max_margin,
+                              bool yield)
+  {
+    m_yield = yield;
+    m_maxMargin = std::max(max_margin, std::chrono::nanoseconds::zero());
+    // no oversleep observed yet
+    m_mean = -1.0;
+    m_deviation = 0.0;
+    m_margin = mode == HYBRID ?
+      static_cast<long long>(std::min(std::max(margin, margin.zero()),
+                                      m_maxMargin).count()) : 0;
+    m_mode = mode;
+  }
+
+  /*!
+   * @if jp
+   * @brief 待機の方法を取得する
+   * @else
+   * @brief Get how to wait
+   * @endif
+   */
+  DeadlineTimer::Mode DeadlineTimer::getMode() const
+  {
+    return m_mode;
+  }
+
+  /*!
+   * @if jp
+   * @brief デッドラインまで待機する
+   * @else
+   * @brief Wait until a deadline
+   * @endif
+   */
+  void DeadlineTimer::sleepUntil(Clock::time_point deadline)
+  {
+    if (m_mode != HYBRID)
+      {
+        sleepAbsolute(deadline);
+        return;
+      }
+
+    auto wake(deadline - std::chrono::nanoseconds(m_margin.load()));
+    auto now(Clock::now());
+    if (now < wake)
+      {
+        sleepAbsolute(wake);
+        now = Clock::now();
+        auto oversleep(now - wake);
+        m_oversleep.record(oversleep);
+        learn(oversleep);
+      }
+    else
+      {
+        // a margin longer than the wait is never measured, so shrink it
+        decay();
+      }
+
+    auto start(now);
+    unsigned int spins(0);
+    while (now < deadline)
+      {
+        if (m_yield)
+          {
+            std::this_thread::yield();
+          }
+        else
+          {
+            cpuRelax();
+          }
+        now = Clock::now();
+        ++spins;
+      }
+    if (spins != 0) { m_spinTime.record(now - start); }
+  }
+
+  /*!
+   * @if jp
+   * @brief 現在のスピンマージンを取得する
+   * @else
+   * @brief Get the current spin margin
+   * @endif
+   */
+  std::chrono::nanoseconds DeadlineTimer::getSpinMargin() const
+  {
+    return std::chrono::nanoseconds(m_margin.load());
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計値をプロパティに書き込む
+   * @else
+   * @brief Write the statistics to properties
+   * @endif
+   */
+  void DeadlineTimer::toProperties(coil::Properties& prop,
+                                   const std::string& prefix) const
+  {
+    if (m_mode != HYBRID) { return; }
+    prop.setProperty(prefix + ".spin_margin",
+                     coil::otos(std::chrono::duration<double>(
+                       getSpinMargin()).count()));
+    m_oversleep.toProperties(prop, prefix + ".oversleep");
+    m_spinTime.toProperties(prop, prefix + ".spin_time");
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計を消去する
+   * @else
+   * @brief Clear the statistics
+   * @endif
+   */
+  void DeadlineTimer::resetStatistics()
+  {
+    m_oversleep.reset();
+    m_spinTime.reset();
+  }
+
+  /*!
+   * @if jp
+   * @brief 寝過ごし時間からスピンマージンを更新する
+   * @else
+   * @brief Update the spin margin from an oversleep
+   * @endif
+   */
+  void DeadlineTimer::learn(std::chrono::nanoseconds oversleep)
+  {
+    // mean and mean deviation smoothed as in TCP retransmission timers
+    // (RFC 6298). The margin covers the mean plus four deviations.
+    double sample(static_cast<double>(oversleep.count()));
+    if (m_mean < 0.0)
+      {
+        m_mean = sample;
+        m_deviation = sample / 2.0;
+      }
+    else
+      {
+        m_deviation += (std::fabs(sample - m_mean) - m_deviation) / 4.0;
+        m_mean += (sample - m_mean) / 8.0;
+      }
+    updateMargin();
+  }
+
+  /*!
+   * @if jp
+   * @brief スリープしなかった場合にスピンマージンを縮める
+   * @else
+   * @brief Shrink the spin margin when the thread did not sleep
+   * @endif
+   */
+  void DeadlineTimer::decay()
+  {
+    if (m_mean < 0.0)
+      {
+        double margin(static_cast<double>(m_margin.load()));
+        m_mean = margin / 2.0;
+        m_deviation = margin / 8.0;
+      }
+    m_mean -= m_mean / 8.0;
+    m_deviation -= m_deviation / 4.0;
+    updateMargin();
+  }
+
+  void DeadlineTimer::updateMargin()
+  {
+    double margin(std::min(m_mean + 4.0 * m_deviation,
+                           static_cast<double>(m_maxMargin.count())));
+    m_margin = static_cast<long long>(margin);
+  }
+} // namespace RTC
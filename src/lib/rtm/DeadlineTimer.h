@@ -0,0 +1,213 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DeadlineTimer.h
+ * @brief Waiting until an absolute deadline
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DEADLINETIMER_H
+#define RTC_DEADLINETIMER_H
+
+#include <rtm/TimingHistogram.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class DeadlineTimer
+   * @brief 絶対時刻まで待機するタイマー
+   *
+   * SLEEP モードでは単調クロックの絶対時刻までスリープする。一般的な
+   * カーネルでは 50-100 マイクロ秒程度の起床遅れが生じる。
+   *
+   * HYBRID モードではデッドラインのスピンマージン前までスリープし、残
+   * りを単調クロックを監視しながらスピンする。スピンマージンは観測し
+   * た寝過ごし時間の平均と平均偏差から学習し、寝過ごしてもデッドライ
+   * ンを越えないように調整する。スピン中は CPU を占有するため、専用の
+   * コアを割り当てたスレッドで使用する。
+   *
+   * sleepUntil() は一つのスレッドから呼び出す。統計の読み出しは他のス
+   * レッドから行える。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class DeadlineTimer
+   * @brief Timer waiting until an absolute time
+   *
+   * In the SLEEP mode the thread sleeps until an absolute time of the
+   * monotonic clock. Standard kernels wake it up 50-100 microseconds
+   * late.
+   *
+   * In the HYBRID mode the thread sleeps until the spin margin before
+   * the deadline and spins the rest watching the monotonic clock. The
+   * spin margin is learned from the mean and the mean deviation of the
+   * observed oversleep so that an oversleep does not pass the
+   * deadline. Spinning occupies the CPU, so this is meant for threads
+   * on dedicated cores.
+   *
+   * sleepUntil() is called from one thread. The statistics can be read
+   * from other threads.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class DeadlineTimer
+  {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /*!
+     * @if jp
+     * @brief 待機の方法
+     * @else
+     * @brief How to wait
+     * @endif
+     */
+    enum Mode
+      {
+        SLEEP,
+        HYBRID
+      };
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    DeadlineTimer();
+
+    DeadlineTimer(const DeadlineTimer&) = delete;
+    DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+    /*!
+     * @if jp
+     * @brief 待機の方法を設定する
+     * @param mode SLEEP または HYBRID
+     * @param margin スピンマージンの初期値
+     * @param max_margin スピンマージンの上限
+     * @param yield true の場合、スピン中に pause 命令の代わりに
+     *              std::this_thread::yield() を呼ぶ
+     * @else
+     * @brief Set how to wait
+     * @param mode SLEEP or HYBRID
+     * @param margin The initial spin margin
+     * @param max_margin The upper limit of the spin margin
+     * @param yield If true, std::this_thread::yield() is called instead
+     *              of the pause instruction while spinning
+     * @endif
+     */
+    void setMode(Mode mode,
+                 std::chrono::nanoseconds margin,
+                 std::chrono::nanoseconds max_margin,
+                 bool yield);
+
+    /*!
+     * @if jp
+     * @brief 待機の方法を取得する
+     * @return SLEEP または HYBRID
+     * @else
+     * @brief Get how to wait
+     * @return SLEEP or HYBRID
+     * @endif
+     */
+    Mode getMode() const;
+
+    /*!
+     * @if jp
+     * @brief デッドラインまで待機する
+     * @param deadline 単調クロックの絶対時刻
+     * @else
+     * @brief Wait until a deadline
+     * @param deadline Absolute time of the monotonic clock
+     * @endif
+     */
+    void sleepUntil(Clock::time_point deadline);
+
+    /*!
+     * @if jp
+     * @brief 現在のスピンマージンを取得する
+     * @return スピンマージン。SLEEP モードでは 0。
+     * @else
+     * @brief Get the current spin margin
+     * @return The spin margin, or 0 in the SLEEP mode
+     * @endif
+     */
+    std::chrono::nanoseconds getSpinMargin() const;
+
+    /*!
+     * @if jp
+     * @brief 統計値をプロパティに書き込む
+     *
+     * HYBRID モードの場合、<prefix>.spin_margin に現在のスピンマージン
+     * [s] を、<prefix>.oversleep と <prefix>.spin_time にスリープの
+     * 寝過ごし時間とスピンした時間のヒストグラムを書き込む。
+     *
+     * @param prop 書き込むプロパティ
+     * @param prefix キーの接頭辞
+     *
+     * @else
+     * @brief Write the statistics to properties
+     *
+     * In the HYBRID mode the current spin margin [s] is written to
+     * <prefix>.spin_margin, and the histograms of the oversleep of the
+     * sleeps and the spin times to <prefix>.oversleep and
+     * <prefix>.spin_time.
+     *
+     * @param prop The properties to write to
+     * @param prefix The prefix of the keys
+     *
+     * @endif
+     */
+    void toProperties(coil::Properties& prop,
+                      const std::string& prefix) const;
+
+    /*!
+     * @if jp
+     * @brief 統計を消去する
+     *
+     * 学習したスピンマージンは消去しない。
+     *
+     * @else
+     * @brief Clear the statistics
+     *
+     * The learned spin margin is kept.
+     *
+     * @endif
+     */
+    void resetStatistics();
+
+  private:
+    void learn(std::chrono::nanoseconds oversleep);
+    void decay();
+    void updateMargin();
+
+    std::atomic<Mode> m_mode;
+    bool m_yield;
+    std::chrono::nanoseconds m_maxMargin;
+    // oversleep estimator in nanoseconds, updated by sleepUntil() only
+    double m_mean;
+    double m_deviation;
+    std::atomic<long long> m_margin;
+    RTC::TimingHistogram m_oversleep;
+    RTC::TimingHistogram m_spinTime;
+  };
+} // namespace RTC
+
+#endif  // RTC_DEADLINETIMER_H
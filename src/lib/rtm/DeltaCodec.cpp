@@ -0,0 +1,401 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DeltaCodec.cpp
+ * @brief Delta encoding codec for data port connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <coil/stringutil.h>
+#include <rtm/DeltaCodec.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+  /*
+   * Frame format (integers are 32 bit little endian)
+   *
+   * keyframe:  'K' 0 0 0 | seq | data...
+   * delta:     'D' 0 0 0 | seq | base seq | total length | range count |
+   *            { offset | length | data... } * range count
+   */
+  const unsigned char KEYFRAME('K');
+  const unsigned char DELTAFRAME('D');
+  const size_t KEY_HEADER_SIZE(8);
+  const size_t DELTA_HEADER_SIZE(20);
+  const size_t RANGE_HEADER_SIZE(8);
+
+  inline void putU32(unsigned char* p, uint32_t v)
+  {
+    p[0] = static_cast<unsigned char>(v);
+    p[1] = static_cast<unsigned char>(v >> 8);
+    p[2] = static_cast<unsigned char>(v >> 16);
+    p[3] = static_cast<unsigned char>(v >> 24);
+  }
+
+  inline uint32_t getU32(const unsigned char* p)
+  {
+    return static_cast<uint32_t>(p[0]) |
+      (static_cast<uint32_t>(p[1]) << 8) |
+      (static_cast<uint32_t>(p[2]) << 16) |
+      (static_cast<uint32_t>(p[3]) << 24);
+  }
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  DeltaCodec::DeltaCodec()
+    : rtclog("DeltaCodec"),
+      m_keyframeInterval(30), m_refKeyframe(false),
+      m_granularity(4), m_mergeGap(16), m_maxRatio(0.5),
+      m_seq(0), m_sinceKeyframe(0), m_forceKeyframe(true),
+      m_keyframeCount(0), m_deltaCount(0), m_discardCount(0)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  DeltaCodec::~DeltaCodec() = default;
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void DeltaCodec::init(const coil::Properties& prop)
+  {
+    RTC_TRACE(("init()"));
+    RTC_DEBUG_STR((prop));
+
+    if (!coil::stringTo(m_keyframeInterval,
+                        prop.getProperty("keyframe_interval", "30").c_str())
+        || m_keyframeInterval == 0)
+      {
+        RTC_ERROR(("invalid keyframe_interval: %s",
+                   prop["keyframe_interval"].c_str()));
+        m_keyframeInterval = 30;
+      }
+
+    std::string reference(prop.getProperty("reference", "previous"));
+    coil::normalize(reference);
+    m_refKeyframe = (reference == "keyframe");
+
+    if (!coil::stringTo(m_granularity,
+                        prop.getProperty("granularity", "4").c_str())
+        || m_granularity == 0)
+      {
+        m_granularity = 4;
+      }
+    if (!coil::stringTo(m_mergeGap,
+                        prop.getProperty("merge_gap", "16").c_str()))
+      {
+        m_mergeGap = 16;
+      }
+    if (!coil::stringTo(m_maxRatio,
+                        prop.getProperty("max_ratio", "0.5").c_str())
+        || m_maxRatio <= 0.0)
+      {
+        m_maxRatio = 0.5;
+      }
+    reset();
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信データを符号化する
+   * @else
+   * @brief Encode data to send
+   * @endif
+   */
+  bool DeltaCodec::encode(const ByteData& in, ByteData& out)
+  {
+    const unsigned char* buf(in.getBuffer());
+    size_t len(in.getDataLength());
+    ++m_seq;
+
+    const Frame& ref(m_refKeyframe ? m_txKey : m_txPrev);
+    bool keyframe(m_forceKeyframe || !ref.valid ||
+                  m_sinceKeyframe + 1 >= m_keyframeInterval);
+    if (!keyframe && !encodeDelta(buf, len, ref, out))
+      {
+        keyframe = true;
+      }
+
+    if (keyframe)
+      {
+        encodeKeyframe(buf, len, out);
+        m_txKey.seq = m_seq;
+        m_txKey.data.assign(buf, buf + len);
+        m_txKey.valid = true;
+        m_sinceKeyframe = 0;
+        m_forceKeyframe = false;
+        ++m_keyframeCount;
+      }
+    else
+      {
+        ++m_sinceKeyframe;
+        ++m_deltaCount;
+      }
+
+    if (!m_refKeyframe)
+      {
+        m_txPrev.seq = m_seq;
+        m_txPrev.data.assign(buf, buf + len);
+        m_txPrev.valid = true;
+      }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信データを復号する
+   * @else
+   * @brief Decode received data
+   * @endif
+   */
+  bool DeltaCodec::decode(const ByteData& in, ByteData& out)
+  {
+    const unsigned char* buf(in.getBuffer());
+    size_t len(in.getDataLength());
+    if (len < KEY_HEADER_SIZE)
+      {
+        RTC_WARN(("invalid delta frame: too short"));
+        ++m_discardCount;
+        return false;
+      }
+    uint32_t seq(getU32(buf + 4));
+
+    if (buf[0] == KEYFRAME)
+      {
+        m_rxKey.seq = seq;
+        m_rxKey.data.assign(buf + KEY_HEADER_SIZE, buf + len);
+        m_rxKey.valid = true;
+        m_rxPrev = m_rxKey;
+        out.writeData(m_rxKey.data.data(),
+                      static_cast<unsigned long>(m_rxKey.data.size()));
+        return true;
+      }
+
+    if (buf[0] != DELTAFRAME || len < DELTA_HEADER_SIZE)
+      {
+        RTC_WARN(("invalid delta frame: unknown type"));
+        ++m_discardCount;
+        return false;
+      }
+
+    uint32_t base(getU32(buf + 8));
+    size_t total(getU32(buf + 12));
+    uint32_t count(getU32(buf + 16));
+
+    const Frame* ref(nullptr);
+    if (m_rxPrev.valid && m_rxPrev.seq == base) { ref = &m_rxPrev; }
+    else if (m_rxKey.valid && m_rxKey.seq == base) { ref = &m_rxKey; }
+    if (ref == nullptr)
+      {
+        // reference frame lost: wait for the next keyframe
+        RTC_DEBUG(("reference frame %u not found. discarded.", base));
+        ++m_discardCount;
+        return false;
+      }
+
+    m_rxBuf.assign(ref->data.begin(), ref->data.end());
+    m_rxBuf.resize(total, 0);
+
+    size_t pos(DELTA_HEADER_SIZE);
+    for (uint32_t i(0); i < count; ++i)
+      {
+        if (pos + RANGE_HEADER_SIZE > len)
+          {
+            RTC_WARN(("invalid delta frame: truncated"));
+            ++m_discardCount;
+            return false;
+          }
+        size_t offset(getU32(buf + pos));
+        size_t length(getU32(buf + pos + 4));
+        pos += RANGE_HEADER_SIZE;
+        if (pos + length > len || offset + length > total)
+          {
+            RTC_WARN(("invalid delta frame: range out of bounds"));
+            ++m_discardCount;
+            return false;
+          }
+        memcpy(m_rxBuf.data() + offset, buf + pos, length);
+        pos += length;
+      }
+
+    m_rxPrev.seq = seq;
+    m_rxPrev.data.assign(m_rxBuf.begin(), m_rxBuf.end());
+    m_rxPrev.valid = true;
+    out.writeData(m_rxBuf.data(), static_cast<unsigned long>(m_rxBuf.size()));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 状態をリセットする
+   * @else
+   * @brief Reset the state
+   * @endif
+   */
+  void DeltaCodec::reset()
+  {
+    m_forceKeyframe = true;
+    m_txKey.valid = false;
+    m_txPrev.valid = false;
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get statistics
+   * @endif
+   */
+  void DeltaCodec::getStatistics(coil::Properties& stat) const
+  {
+    stat.setProperty("codec.delta.keyframe_count",
+                     coil::otos(m_keyframeCount.load()));
+    stat.setProperty("codec.delta.delta_count",
+                     coil::otos(m_deltaCount.load()));
+    stat.setProperty("codec.delta.discard_count",
+                     coil::otos(m_discardCount.load()));
+  }
+
+  /*!
+   * @if jp
+   * @brief キーフレームを生成する
+   * @else
+   * @brief Build a keyframe
+   * @endif
+   */
+  void DeltaCodec::encodeKeyframe(const unsigned char* buf, size_t len,
+                                  ByteData& out)
+  {
+    m_txBuf.resize(KEY_HEADER_SIZE + len);
+    unsigned char* p(m_txBuf.data());
+    p[0] = KEYFRAME; p[1] = 0; p[2] = 0; p[3] = 0;
+    putU32(p + 4, m_seq);
+    if (len != 0) { memcpy(p + KEY_HEADER_SIZE, buf, len); }
+    out.writeData(m_txBuf.data(), static_cast<unsigned long>(m_txBuf.size()));
+  }
+
+  /*!
+   * @if jp
+   * @brief 差分フレームを生成する
+   * @else
+   * @brief Build a delta frame
+   * @endif
+   */
+  bool DeltaCodec::encodeDelta(const unsigned char* buf, size_t len,
+                               const Frame& ref, ByteData& out)
+  {
+    const size_t limit(static_cast<size_t>(static_cast<double>(len) *
+                                           m_maxRatio));
+    const size_t common(std::min(len, ref.data.size()));
+    const unsigned char* prev(ref.data.data());
+
+    m_txBuf.resize(DELTA_HEADER_SIZE);
+    uint32_t count(0);
+    size_t begin(0), end(0);
+    bool open(false);
+
+    auto flush = [&]()
+      {
+        size_t pos(m_txBuf.size());
+        m_txBuf.resize(pos + RANGE_HEADER_SIZE + (end - begin));
+        putU32(m_txBuf.data() + pos, static_cast<uint32_t>(begin));
+        putU32(m_txBuf.data() + pos + 4, static_cast<uint32_t>(end - begin));
+        memcpy(m_txBuf.data() + pos + RANGE_HEADER_SIZE, buf + begin,
+               end - begin);
+        ++count;
+      };
+
+    for (size_t off(0); off < common; off += m_granularity)
+      {
+        size_t n(std::min(m_granularity, common - off));
+        if (memcmp(buf + off, prev + off, n) == 0) { continue; }
+        if (open && off <= end + m_mergeGap)
+          {
+            end = off + n;
+          }
+        else
+          {
+            if (open) { flush(); }
+            begin = off;
+            end = off + n;
+            open = true;
+          }
+        if (m_txBuf.size() + (end - begin) > limit) { return false; }
+      }
+    // data appended after the reference frame
+    if (len > common)
+      {
+        if (open && common <= end + m_mergeGap)
+          {
+            end = len;
+          }
+        else
+          {
+            if (open) { flush(); }
+            begin = common;
+            end = len;
+            open = true;
+          }
+      }
+    if (open) { flush(); }
+    if (m_txBuf.size() > limit) { return false; }
+
+    unsigned char* p(m_txBuf.data());
+    p[0] = DELTAFRAME; p[1] = 0; p[2] = 0; p[3] = 0;
+    putU32(p + 4, m_seq);
+    putU32(p + 8, ref.seq);
+    putU32(p + 12, static_cast<uint32_t>(len));
+    putU32(p + 16, count);
+    out.writeData(m_txBuf.data(), static_cast<unsigned long>(m_txBuf.size()));
+    return true;
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void DeltaCodecInit(void)
+  {
+    RTC::ConnectorCodecFactory& factory(RTC::ConnectorCodecFactory::instance());
+    factory.addFactory("delta",
+                       ::coil::Creator< ::RTC::ConnectorCodec,
+                                        ::RTC::DeltaCodec>,
+                       ::coil::Destructor< ::RTC::ConnectorCodec,
+                                           ::RTC::DeltaCodec>);
+  }
+}
@@ -0,0 +1,196 @@
+﻿// -*- C++ -*-
+/*!
+ * @file DeltaCodec.h
+ * @brief Delta encoding codec for data port connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_DELTACODEC_H
+#define RTC_DELTACODEC_H
+
+#include <rtm/ConnectorCodec.h>
+#include <rtm/SystemLogger.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class DeltaCodec
+   * @brief 差分符号化コーデック
+   *
+   * 一定間隔でキーフレーム(データ全体)を送信し、その間は参照フレームか
+   * ら変化したバイト範囲のみを送信する。TimedDoubleSeq、TimedFloatSeq、
+   * TimedOctetSeq などの大きなシーケンスのうち一部の要素のみが変化する
+   * データに有効である。
+   *
+   * 各フレームには通し番号が付与され、差分フレームは参照フレームの番号
+   * を持つ。受信側は参照フレームを保持していない差分フレームを破棄し、
+   * 次のキーフレームで自動的に再同期する。接続ごとに状態を持つため、再
+   * 接続後は最初のキーフレームから復号を再開する。
+   * push 型接続では Publisher が実際に送信する時点で符号化するため、
+   * push_policy による間引きやバッファの上書きは参照を失わせない。pull
+   * 型接続では使用できない。
+   *
+   * コネクタプロファイルの codec.delta ノードの以下のプロパティで設定する。
+   *
+   * - keyframe_interval: キーフレームの間隔 [フレーム] (デフォルト: 30)
+   * - reference: previous (直前のフレームとの差分、デフォルト) または
+   *              keyframe (直前のキーフレームとの差分)
+   * - granularity: 差分を検出する単位 [バイト] (デフォルト: 4)
+   * - merge_gap: これ以下の間隔の変化範囲を結合する [バイト] (デフォルト: 16)
+   * - max_ratio: 差分フレームの大きさがデータ全体のこの割合を超える場合は
+   *              キーフレームを送信する (デフォルト: 0.5)
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class DeltaCodec
+   * @brief Delta encoding codec
+   *
+   * This codec sends a keyframe (the whole data) periodically, and in
+   * between only the byte ranges that changed from the reference frame.
+   * It is effective for large sequences such as TimedDoubleSeq,
+   * TimedFloatSeq and TimedOctetSeq where only a part of the elements
+   * change.
+   *
+   * Each frame carries a sequence number, and a delta frame carries the
+   * number of its reference frame. The receiver discards delta frames
+   * whose reference frame it does not hold, and resynchronizes at the
+   * next keyframe automatically. Since the state is held per connection,
+   * decoding restarts at the first keyframe after reconnection.
+   * On push connections data is encoded when the publisher actually
+   * sends it, so skipping by push_policy or buffer overwrites does not
+   * lose references. This codec cannot be used on pull connections.
+   *
+   * It is configured by the following properties under the codec.delta
+   * node of the connector properties.
+   *
+   * - keyframe_interval: Keyframe interval [frames] (default: 30)
+   * - reference: previous (delta from the previous frame, default) or
+   *              keyframe (delta from the last keyframe)
+   * - granularity: Unit of change detection [bytes] (default: 4)
+   * - merge_gap: Changed ranges separated by at most this gap are
+   *              merged [bytes] (default: 16)
+   * - max_ratio: A keyframe is sent if a delta frame would exceed this
+   *              ratio of the whole data (default: 0.5)
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class DeltaCodec
+    : public ConnectorCodec
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    DeltaCodec();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~DeltaCodec() override;
+
+    void init(const coil::Properties& prop) override;
+    bool encode(const ByteData& in, ByteData& out) override;
+    bool decode(const ByteData& in, ByteData& out) override;
+    void reset() override;
+    bool isStateful() const override { return true; }
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     *
+     * codec.delta.keyframe_count, codec.delta.delta_count,
+     * codec.delta.discard_count を設定する。
+     *
+     * @else
+     * @brief Get statistics
+     *
+     * This operation sets codec.delta.keyframe_count,
+     * codec.delta.delta_count and codec.delta.discard_count.
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) const override;
+
+  private:
+    struct Frame
+    {
+      Frame() : seq(0), valid(false) {}
+      uint32_t seq;
+      bool valid;
+      std::vector<unsigned char> data;
+    };
+
+    void encodeKeyframe(const unsigned char* buf, size_t len, ByteData& out);
+    bool encodeDelta(const unsigned char* buf, size_t len,
+                     const Frame& ref, ByteData& out);
+
+    mutable Logger rtclog;
+    unsigned long m_keyframeInterval;
+    bool m_refKeyframe;
+    size_t m_granularity;
+    size_t m_mergeGap;
+    double m_maxRatio;
+
+    // sender side
+    uint32_t m_seq;
+    unsigned long m_sinceKeyframe;
+    bool m_forceKeyframe;
+    Frame m_txKey;
+    Frame m_txPrev;
+    std::vector<unsigned char> m_txBuf;
+
+    // receiver side
+    Frame m_rxKey;
+    Frame m_rxPrev;
+    std::vector<unsigned char> m_rxBuf;
+
+    std::atomic<unsigned long> m_keyframeCount;
+    std::atomic<unsigned long> m_deltaCount;
+    std::atomic<unsigned long> m_discardCount;
+  };
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * DeltaCodec のファクトリを登録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This initialization function registers DeltaCodec's factory.
+   *
+   * @endif
+   */
+  void DeltaCodecInit(void);
+}
+
+#endif  // RTC_DELTACODEC_H
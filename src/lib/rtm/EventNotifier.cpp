@@ -0,0 +1,154 @@
+﻿// -*- C++ -*-
+/*!
+ * @file EventNotifier.cpp
+ * @brief Notification of data arrival to waiting threads
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/config_rtc.h>
+#include <rtm/EventNotifier.h>
+#include <rtm/WaitSet.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#ifdef RTM_OS_LINUX
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace RTC
+{
+  EventNotifier::EventNotifier()
+    : m_count(0), m_fd(-1)
+  {
+  }
+
+  EventNotifier::~EventNotifier()
+  {
+#ifdef RTM_OS_LINUX
+    if (m_fd >= 0) { ::close(m_fd); }
+#endif
+  }
+
+  /*!
+   * @if jp
+   * @brief イベントを通知する
+   * @else
+   * @brief Notify an event
+   * @endif
+   */
+  void EventNotifier::notify()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    ++m_count;
+    m_cond.notify_all();
+    for (auto waitset : m_waitsets)
+      {
+        waitset->signal();
+      }
+#ifdef RTM_OS_LINUX
+    if (m_fd >= 0)
+      {
+        uint64_t one(1);
+        // fails only if the counter would overflow, then it is readable
+        ssize_t ret(::write(m_fd, &one, sizeof(one)));
+        (void)ret;
+      }
+#endif
+  }
+
+  /*!
+   * @if jp
+   * @brief 通知回数を取得する
+   * @else
+   * @brief Get the notification count
+   * @endif
+   */
+  unsigned long long EventNotifier::count() const
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_count;
+  }
+
+  /*!
+   * @if jp
+   * @brief 通知回数が変わるまで待つ
+   * @else
+   * @brief Wait until the notification count changes
+   * @endif
+   */
+  bool EventNotifier::wait(unsigned long long count,
+                           std::chrono::nanoseconds timeout)
+  {
+    std::unique_lock<std::mutex> guard(m_mutex);
+    if (timeout == std::chrono::nanoseconds::max())
+      {
+        m_cond.wait(guard, [this, count] { return m_count != count; });
+        return true;
+      }
+    return m_cond.wait_for(guard, timeout,
+                           [this, count] { return m_count != count; });
+  }
+
+  /*!
+   * @if jp
+   * @brief ポーリング可能なファイルディスクリプタを取得する
+   * @else
+   * @brief Get the pollable file descriptor
+   * @endif
+   */
+  int EventNotifier::getFileDescriptor()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+#ifdef RTM_OS_LINUX
+    if (m_fd < 0)
+      {
+        m_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+      }
+#endif
+    return m_fd;
+  }
+
+  /*!
+   * @if jp
+   * @brief ファイルディスクリプタを読み出し可能でない状態に戻す
+   * @else
+   * @brief Make the file descriptor not readable again
+   * @endif
+   */
+  void EventNotifier::clearFileDescriptor()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+#ifdef RTM_OS_LINUX
+    if (m_fd >= 0)
+      {
+        uint64_t value(0);
+        ssize_t ret(::read(m_fd, &value, sizeof(value)));
+        (void)ret;
+      }
+#endif
+  }
+
+  void EventNotifier::attach(WaitSet* waitset)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_waitsets.push_back(waitset);
+  }
+
+  void EventNotifier::detach(WaitSet* waitset)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_waitsets.erase(std::remove(m_waitsets.begin(), m_waitsets.end(),
+                                 waitset), m_waitsets.end());
+  }
+} // namespace RTC
@@ -0,0 +1,172 @@
+﻿// -*- C++ -*-
+/*!
+ * @file EventNotifier.h
+ * @brief Notification of data arrival to waiting threads
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_EVENTNOTIFIER_H
+#define RTC_EVENTNOTIFIER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace RTC
+{
+  class WaitSet;
+
+  /*!
+   * @if jp
+   * @class EventNotifier
+   * @brief データ到着を待機中のスレッドに通知するクラス
+   *
+   * notify() が呼ばれるたびに通知回数を増やし、wait() で待機している
+   * スレッド、登録された WaitSet およびファイルディスクリプタに通知す
+   * る。InPort はデータを受信したときに通知する。サービスポートの要求
+   * など任意のイベントを WaitSet で待つために単独で使用することもでき
+   * る。
+   *
+   * ファイルディスクリプタは Linux では eventfd であり、
+   * getFileDescriptor() を最初に呼んだときに生成される。通知されると
+   * 読み出し可能になり、clearFileDescriptor() を呼ぶまでその状態が続
+   * く。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class EventNotifier
+   * @brief Class notifying waiting threads of data arrival
+   *
+   * Each notify() call increments the notification count and wakes the
+   * threads waiting in wait(), the attached WaitSets and the file
+   * descriptor. InPort notifies when it receives data. It can also be
+   * used alone to wait for any event, such as service port requests,
+   * with a WaitSet.
+   *
+   * On Linux the file descriptor is an eventfd, created at the first
+   * call of getFileDescriptor(). It becomes readable when notified and
+   * stays readable until clearFileDescriptor() is called.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class EventNotifier
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    EventNotifier();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     *
+     * WaitSet に登録されている場合、先に WaitSet を破棄または clear()
+     * しなければならない。
+     *
+     * @else
+     * @brief Destructor
+     *
+     * If attached to a WaitSet, the WaitSet must be destroyed or
+     * cleared first.
+     *
+     * @endif
+     */
+    ~EventNotifier();
+
+    EventNotifier(const EventNotifier&) = delete;
+    EventNotifier& operator=(const EventNotifier&) = delete;
+
+    /*!
+     * @if jp
+     * @brief イベントを通知する
+     * @else
+     * @brief Notify an event
+     * @endif
+     */
+    void notify();
+
+    /*!
+     * @if jp
+     * @brief 通知回数を取得する
+     * @return 通知回数
+     * @else
+     * @brief Get the notification count
+     * @return The notification count
+     * @endif
+     */
+    unsigned long long count() const;
+
+    /*!
+     * @if jp
+     * @brief 通知回数が変わるまで待つ
+     *
+     * @param count 待機前に count() で取得した通知回数
+     * @param timeout タイムアウト時間。nanoseconds::max() の場合は無期
+     *                限に待つ。
+     *
+     * @return 通知された場合 true、タイムアウトした場合 false
+     *
+     * @else
+     * @brief Wait until the notification count changes
+     *
+     * @param count The notification count got by count() before waiting
+     * @param timeout The timeout. nanoseconds::max() waits forever.
+     *
+     * @return true if notified, false on timeout
+     *
+     * @endif
+     */
+    bool wait(unsigned long long count, std::chrono::nanoseconds timeout);
+
+    /*!
+     * @if jp
+     * @brief ポーリング可能なファイルディスクリプタを取得する
+     * @return ファイルディスクリプタ。対応していない環境では -1
+     * @else
+     * @brief Get the pollable file descriptor
+     * @return The file descriptor, or -1 if not supported
+     * @endif
+     */
+    int getFileDescriptor();
+
+    /*!
+     * @if jp
+     * @brief ファイルディスクリプタを読み出し可能でない状態に戻す
+     * @else
+     * @brief Make the file descriptor not readable again
+     * @endif
+     */
+    void clearFileDescriptor();
+
+  private:
+    friend class WaitSet;
+    void attach(WaitSet* waitset);
+    void detach(WaitSet* waitset);
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_cond;
+    unsigned long long m_count;
+    std::vector<WaitSet*> m_waitsets;
+    int m_fd;
+  };
+} // namespace RTC
+
+#endif  // RTC_EVENTNOTIFIER_H
@@ -19,6 +19,7 @@
 #include <rtm/RTObjectStateMachine.h>
 #include <rtm/ExecutionContextBase.h>
 #include <rtm/RTObject.h>
+#include <coil/stringutil.h>
 #include <cinttypes>
 
 namespace RTC
@@ -28,7 +29,9 @@ namespace RTC
       m_activationTimeout(std::chrono::milliseconds(500)),
       m_deactivationTimeout(std::chrono::milliseconds(500)),
       m_resetTimeout(std::chrono::milliseconds(500)),
-      m_syncActivation(true), m_syncDeactivation(true), m_syncReset(true)
+      m_syncActivation(true), m_syncDeactivation(true), m_syncReset(true),
+      m_statistics(false), m_statisticsResetOnRead(false),
+      m_missedDeadlines(0)
   {
   }
   /*!
@@ -81,6 +84,40 @@ namespace RTC
     setTimeout(props, "deactivation_timeout", m_deactivationTimeout);
     setTimeout(props, "reset_timeout",        m_resetTimeout);
 
+    // getting timing statistics options (off by default, they add a
+    // clock read per component and cycle)
+    m_statistics = coil::toBool(props["statistics"], "YES", "NO", false);
+    m_statisticsResetOnRead =
+      coil::toBool(props["statistics.reset_on_read"], "YES", "NO", false);
+    m_worker.setExecTimeMeasure(m_statistics);
+
+    // getting execution order options (participation order by default)
+    m_worker.setExecutionOrder(coil::split(props["order"], ",", true),
+                               coil::toBool(props["auto_order"],
+                                            "YES", "NO", false));
+
+    // getting rate groups
+    std::vector<RTC_impl::ExecutionContextWorker::RateGroup> groups;
+    for (auto & name : coil::split(props["rate_groups"], ",", true))
+      {
+        RTC_impl::ExecutionContextWorker::RateGroup group;
+        std::string key("rate_group." + name);
+        group.name = name;
+        int divisor(1);
+        int phase(-1);
+        coil::stringTo(divisor, props[key + ".divisor"].c_str());
+        // "auto" or empty leaves the phase automatic
+        if (!coil::stringTo(phase, props[key + ".phase"].c_str()))
+          {
+            phase = -1;
+          }
+        group.divisor = divisor > 0 ? static_cast<unsigned int>(divisor) : 1;
+        group.phase = phase;
+        group.members = coil::split(props[key + ".members"], ",", true);
+        groups.push_back(group);
+      }
+    m_worker.setRateGroups(groups);
+
     RTC_DEBUG(("ExecutionContext's configurations:"));
     RTC_DEBUG(("Exec rate   : %f [Hz]", getRate()));
     RTC_DEBUG(("Activation  : Sync = %s, Timeout = %f",
@@ -657,6 +694,25 @@ namespace RTC
     return onGetComponentState(state);
   }
 
+  /*!
+   * @if jp
+   * @brief 全参加コンポーネントの状態を取得する
+   * @else
+   * @brief Get the states of all participating components
+   * @endif
+   */
+  std::vector<std::pair<RTC::LightweightRTObject_var, RTC::LifeCycleState> >
+  ExecutionContextBase::getComponentStates()
+  {
+    RTC_TRACE(("getComponentStates()"));
+    auto states(m_worker.getComponentStates());
+    for (auto & state : states)
+      {
+        state.second = onGetComponentState(state.second);
+      }
+    return states;
+  }
+
   const char* ExecutionContextBase::getStateString(RTC::LifeCycleState state)
   {
     return m_worker.getStateString(state);
@@ -721,7 +777,52 @@ namespace RTC
     coil::Properties props;
     NVUtil::copyToProperties(props, prof->properties);
     RTC_DEBUG_STR((props));
-    return onGetProfile(prof);
+
+    if (m_statistics)
+      {
+        coil::Properties stat;
+        m_jitter.toProperties(stat, "statistics.jitter");
+        m_wakeupLatency.toProperties(stat, "statistics.wakeup_latency");
+        stat.setProperty("statistics.missed_deadlines",
+                         coil::otos(getMissedDeadlines()));
+        m_worker.getExecTimeStatistics(stat, "statistics.exec_time");
+        m_worker.getRateGroupStatistics(stat, "statistics.rate_group");
+        SDOPackage::NVList nv;
+        NVUtil::copyFromProperties(nv, stat);
+        NVUtil::append(prof->properties, nv);
+      }
+    // derived classes may add their statistics
+    prof = onGetProfile(prof);
+    if (m_statistics && m_statisticsResetOnRead) { resetStatistics(); }
+    return prof;
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行タイミングの統計を消去する
+   * @else
+   * @brief Clear the timing statistics
+   * @endif
+   */
+  void ExecutionContextBase::resetStatistics()
+  {
+    RTC_TRACE(("resetStatistics()"));
+    m_jitter.reset();
+    m_wakeupLatency.reset();
+    m_missedDeadlines = 0;
+    m_worker.resetExecTimeStatistics();
+  }
+
+  /*!
+   * @if jp
+   * @brief デッドラインを過ぎた実行の回数を取得する
+   * @else
+   * @brief Get the number of executions which missed the deadline
+   * @endif
+   */
+  unsigned long ExecutionContextBase::getMissedDeadlines() const
+  {
+    return m_missedDeadlines.load();
   }
 
   //============================================================
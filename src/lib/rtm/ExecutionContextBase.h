@@ -25,6 +25,9 @@
 #include <rtm/Factory.h>
 #include <rtm/ExecutionContextProfile.h>
 #include <rtm/ExecutionContextWorker.h>
+#include <rtm/TimingHistogram.h>
+
+#include <atomic>
 
 #define DEFAULT_EXECUTION_RATE 1000
 
@@ -770,6 +773,37 @@ namespace RTC
      * @endif
      */
     RTC::LifeCycleState getComponentState(RTC::LightweightRTObject_ptr comp);
+
+    /*!
+     * @if jp
+     * @brief 全参加コンポーネントの状態を取得する
+     *
+     * getComponentState() をコンポーネントごとに呼ぶ代わりに、一度に全
+     * 参加コンポーネントの状態を取得する。
+     *
+     * この関数は ExecutionContextService の IDL にはなく、CORBA 経由で
+     * は呼び出せない。同じプロセス内の C++ からのみ使用できる。リモー
+     * トのツールは従来通り get_component_state() を呼ぶ。
+     *
+     * @return 参加コンポーネントとその状態のリスト
+     *
+     * @else
+     * @brief Get the states of all participating components
+     *
+     * This gets the states of all participants at once instead of
+     * calling getComponentState() for each component.
+     *
+     * This function is not part of the ExecutionContextService IDL, so
+     * it cannot be called through CORBA. Only C++ code in the same
+     * process can use it. Remote tools still call
+     * get_component_state() for each component.
+     *
+     * @return The list of the participants and their states
+     *
+     * @endif
+     */
+    std::vector<std::pair<RTC::LightweightRTObject_var, RTC::LifeCycleState> >
+    getComponentStates();
     const char* getStateString(RTC::LifeCycleState state);
 
     /*!
@@ -817,6 +851,35 @@ namespace RTC
      */
     RTC::ExecutionContextProfile* getProfile();
 
+    /*!
+     * @if jp
+     * @brief 実行タイミングの統計を消去する
+     *
+     * 周期のジッタ、起床遅延、コンポーネントごとの on_execute の実行時
+     * 間のヒストグラムとデッドラインを過ぎた回数を消去する。
+     *
+     * @else
+     * @brief Clear the timing statistics
+     *
+     * This clears the histograms of the period jitter, the wake-up
+     * latency and the on_execute time per component, and the number of
+     * missed deadlines.
+     *
+     * @endif
+     */
+    virtual void resetStatistics();
+
+    /*!
+     * @if jp
+     * @brief デッドラインを過ぎた実行の回数を取得する
+     * @return デッドラインを過ぎた回数
+     * @else
+     * @brief Get the number of executions which missed the deadline
+     * @return The number of missed deadlines
+     * @endif
+     */
+    unsigned long getMissedDeadlines() const;
+
     //============================================================
     // Delegated functions to ExecutionContextProfile
     //============================================================
@@ -1195,6 +1258,35 @@ namespace RTC
     bool m_syncActivation;
     bool m_syncDeactivation;
     bool m_syncReset;
+
+    /*!
+     * @if jp
+     * @brief 実行タイミングの統計
+     *
+     * m_jitter は周期の予定開始時刻と実際の開始時刻の差、
+     * m_wakeupLatency は指定した起床時刻と実際の起床時刻の差を記録する。
+     * 周期実行する ExecutionContext が m_statistics が true の場合に記
+     * 録する。statistics プロパティ (デフォルト NO) で設定し、
+     * getProfile() でプロファイルの properties の statistics 以下に出
+     * 力される。
+     *
+     * @else
+     * @brief Timing statistics
+     *
+     * m_jitter records the difference between the scheduled and the
+     * actual start of a cycle, and m_wakeupLatency the difference
+     * between the requested and the actual wake-up time. Periodic
+     * ExecutionContexts record them if m_statistics is true. They are
+     * configured by the statistics property (NO by default) and output
+     * under statistics in the properties of the profile by getProfile().
+     *
+     * @endif
+     */
+    bool m_statistics;
+    bool m_statisticsResetOnRead;
+    RTC::TimingHistogram m_jitter;
+    RTC::TimingHistogram m_wakeupLatency;
+    std::atomic<unsigned long> m_missedDeadlines;
   };  // class ExecutionContextBase
 
   typedef coil::GlobalFactory<ExecutionContextBase> ExecutionContextFactory;
@@ -19,11 +19,108 @@
 #include <rtm/RTObject.h>
 #include <rtm/RTObjectStateMachine.h>
 #include <rtm/ExecutionContextWorker.h>
+#include <rtm/InPortBase.h>
+#include <rtm/OutPortBase.h>
+#include <rtm/PortBase.h>
+#include <rtm/TaskGraph.h>
+#include <coil/stringutil.h>
 
 #include <algorithm>
 #include <iostream>
+#include <map>
 
 #define DEEFAULT_PERIOD 0.000001
+namespace
+{
+  using RateGroup = RTC_impl::ExecutionContextWorker::RateGroup;
+
+  // longest hyperperiod searched for the automatic phases
+  const unsigned long long MAX_HYPERPERIOD(65536);
+
+  unsigned long long gcd(unsigned long long a, unsigned long long b)
+  {
+    while (b != 0) { unsigned long long t(a % b); a = b; b = t; }
+    return a;
+  }
+
+  // Phases of the groups without one are decided greedily from the
+  // heaviest group, each taking the phase whose busiest cycle in the
+  // hyperperiod is least loaded.
+  void assignPhases(std::vector<RateGroup>& groups)
+  {
+    unsigned long long hyperperiod(1);
+    for (auto & group : groups)
+      {
+        hyperperiod = hyperperiod / gcd(hyperperiod, group.divisor)
+          * group.divisor;
+        if (hyperperiod > MAX_HYPERPERIOD) { break; }
+      }
+    std::vector<size_t> load;
+    if (hyperperiod <= MAX_HYPERPERIOD)
+      {
+        load.assign(static_cast<size_t>(hyperperiod), 0);
+      }
+    auto weight = [](const RateGroup& group)
+      {
+        return std::max(group.members.size(), static_cast<size_t>(1));
+      };
+    auto place = [&load, &weight](const RateGroup& group)
+      {
+        for (size_t k(static_cast<size_t>(group.phase)); k < load.size();
+             k += group.divisor)
+          {
+            load[k] += weight(group);
+          }
+      };
+
+    std::vector<size_t> automatic;
+    for (size_t i(0); i < groups.size(); ++i)
+      {
+        if (groups[i].phase >= 0) { place(groups[i]); }
+        else { automatic.push_back(i); }
+      }
+    std::stable_sort(automatic.begin(), automatic.end(),
+                     [&groups, &weight](size_t a, size_t b)
+                     {
+                       return weight(groups[a]) > weight(groups[b]);
+                     });
+
+    size_t offset(0);
+    for (auto i : automatic)
+      {
+        RateGroup& group(groups[i]);
+        if (load.empty())
+          {
+            // too long hyperperiod, shift the phases one by one
+            group.phase = static_cast<int>(offset++ % group.divisor);
+            continue;
+          }
+        size_t best(0);
+        size_t bestMax(0);
+        size_t bestSum(0);
+        for (size_t p(0); p < group.divisor; ++p)
+          {
+            size_t peak(0);
+            size_t sum(0);
+            for (size_t k(p); k < load.size(); k += group.divisor)
+              {
+                peak = std::max(peak, load[k]);
+                sum += load[k];
+              }
+            if (p == 0 || peak < bestMax ||
+                (peak == bestMax && sum < bestSum))
+              {
+                best = p;
+                bestMax = peak;
+                bestSum = sum;
+              }
+          }
+        group.phase = static_cast<int>(best);
+        place(group);
+      }
+  }
+} // namespace
+
 namespace RTC_impl
 {
   /*!
@@ -35,7 +132,9 @@ namespace RTC_impl
    */
   ExecutionContextWorker::ExecutionContextWorker()
     : rtclog("ec_worker"),
-      m_running(false)
+      m_running(false), m_measureExecTime(false),
+      m_autoOrder(false), m_orderChanged(true), m_orderRevision(0),
+      m_cycle(0)
   {
     RTC_TRACE(("ExecutionContextWorker()"));
   }
@@ -336,6 +435,10 @@ namespace RTC_impl
     RTC::LightweightRTObject_var comp
       = RTC::LightweightRTObject::_duplicate(rtc->getObjRef());
     m_comps.push_back(new RTObjectStateMachine(id, comp));
+    m_comps.back()->setExecTimeMeasure(m_measureExecTime);
+    addIndex(m_comps.back());
+    m_orderChanged = true;
+    updateSchedule();
     RTC_DEBUG(("bindComponent() succeeded."));
 
     return RTC::RTC_OK;
@@ -380,11 +483,16 @@ namespace RTC_impl
 
   void ExecutionContextWorker::updateComponentList()
   {
+    bool changed(false);
     {    // adding component
       std::lock_guard<std::mutex> addedGuard(m_addedMutex);
       for (auto & m_addedComp : m_addedComps)
         {
+          m_addedComp->setExecTimeMeasure(m_measureExecTime);
           m_comps.push_back(m_addedComp);
+          addIndex(m_addedComp);
+          m_orderChanged = true;
+          changed = true;
           RTC_TRACE(("Component added."));
         }
       m_addedComps.clear();
@@ -399,27 +507,69 @@ namespace RTC_impl
           it = std::find(m_comps.begin(), m_comps.end(), rtobj);
           assert(*it == rtobj);
           m_comps.erase(it);
+          // also drops the other references added by findComponent()
+          for (auto idx = m_index.begin(); idx != m_index.end();)
+            {
+              if (idx->second == rtobj) { idx = m_index.erase(idx); }
+              else { ++idx; }
+            }
           delete rtobj;
+          m_orderChanged = true;
+          changed = true;
           RTC_TRACE(("Component deleted."));
         }
       m_removedComps.clear();
     }
+    if (changed) { updateSchedule(); }
   }
 
   RTObjectStateMachine*
   ExecutionContextWorker::findComponent(RTC::LightweightRTObject_ptr comp)
   {
+    CORBA::ULong key(RTObjectStateMachine::objectHash(comp));
     std::lock_guard<std::mutex> guard(m_mutex);
+    auto range = m_index.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second->isEquivalent(comp)) { return it->second; }
+      }
+    // the same object may be given by a reference with another hash
     for (auto & rtobj : m_comps)
       {
         if (rtobj->isEquivalent(comp))
           {
+            // found by the index from now on, so logged once
+            RTC_DEBUG(("participant %s found by _is_equivalent(). "
+                       "its other reference is indexed.",
+                       rtobj->getInstanceName().c_str()));
+            m_index.emplace(key, rtobj);
             return rtobj;
           }
       }
     return nullptr;
   }
 
+  std::vector<std::pair<RTC::LightweightRTObject_var, RTC::LifeCycleState> >
+  ExecutionContextWorker::getComponentStates()
+  {
+    RTC_TRACE(("getComponentStates()"));
+    std::vector<std::pair<RTC::LightweightRTObject_var,
+                          RTC::LifeCycleState> > states;
+    std::lock_guard<std::mutex> guard(m_mutex);
+    states.reserve(m_comps.size());
+    for (auto & rtobj : m_comps)
+      {
+        RTC::LightweightRTObject_var comp = rtobj->getRTObject();
+        states.emplace_back(comp, rtobj->getState());
+      }
+    return states;
+  }
+
+  void ExecutionContextWorker::addIndex(RTObjectStateMachine* rtobj)
+  {
+    m_index.emplace(rtobj->getObjectHash(), rtobj);
+  }
+
   bool ExecutionContextWorker::
   isAllCurrentState(ExecContextState state)
   {
@@ -464,13 +614,62 @@ namespace RTC_impl
     return false;
   }
 
+  void ExecutionContextWorker::setExecTimeMeasure(bool measure)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_measureExecTime = measure;
+    for (auto & comp : m_comps) { comp->setExecTimeMeasure(measure); }
+  }
+
+  void ExecutionContextWorker::
+  getExecTimeStatistics(coil::Properties& prop, const std::string& prefix)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (size_t i(0); i < m_comps.size(); ++i)
+      {
+        std::string name(m_comps[i]->getInstanceName());
+        if (name.empty()) { name = "comp" + coil::otos(i); }
+        m_comps[i]->getExecTimeHistogram().toProperties(prop,
+                                                        prefix + "." + name);
+      }
+  }
+
+  void ExecutionContextWorker::
+  getRateGroupStatistics(coil::Properties& prop, const std::string& prefix)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (size_t i(0); i < m_groups.size(); ++i)
+      {
+        std::string key(prefix + "." + m_groups[i].name);
+        const RateGroupStatistics& stat(*m_groupStatistics[i]);
+        prop.setProperty(key + ".divisor", coil::otos(m_groups[i].divisor));
+        prop.setProperty(key + ".phase", coil::otos(m_groups[i].phase));
+        prop.setProperty(key + ".activations",
+                         coil::otos(stat.activations.load()));
+        stat.execTime.toProperties(prop, key + ".exec_time");
+      }
+  }
+
+  void ExecutionContextWorker::resetExecTimeStatistics()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto & comp : m_comps) { comp->getExecTimeHistogram().reset(); }
+    for (auto & stat : m_groupStatistics)
+      {
+        stat->activations = 0;
+        stat->execTime.reset();
+      }
+  }
+
   void ExecutionContextWorker::invokeWorker()
   {
     RTC_PARANOID(("invokeWorker()"));
+    updateExecutionOrder();
     // m_comps never changes its size here
     for (auto & comp : m_comps) { comp->workerPreDo();  }
-    for (auto & comp : m_comps) { comp->workerDo();     }
-    for (auto & comp : m_comps) { comp->workerPostDo(); }
+    invokeScheduled(false);
+    invokeScheduled(true);
+    endCycle();
     std::lock_guard<std::mutex> guard(m_mutex);
     updateComponentList();
   }
@@ -478,6 +677,7 @@ namespace RTC_impl
   void ExecutionContextWorker::invokeWorkerPreDo()
   {
     RTC_PARANOID(("invokeWorkerPreDo()"));
+    updateExecutionOrder();
     // m_comps never changes its size here
     for (auto & comp : m_comps) { comp->workerPreDo();  }
   }
@@ -486,18 +686,257 @@ namespace RTC_impl
   {
     RTC_PARANOID(("invokeWorkerDo()"));
     // m_comps never changes its size here
-    for (auto & comp : m_comps) { comp->workerDo();     }
+    invokeScheduled(false);
   }
 
   void ExecutionContextWorker::invokeWorkerPostDo()
   {
     RTC_PARANOID(("invokeWorkerPostDo()"));
     // m_comps never changes its size here
-    for (auto & comp : m_comps) { comp->workerPostDo(); }
+    invokeScheduled(true);
+    endCycle();
     // m_comps might be changed here
     std::lock_guard<std::mutex> guard(m_mutex);
     updateComponentList();
   }
 
+  void ExecutionContextWorker::invokeWorkerUpdate()
+  {
+    RTC_PARANOID(("invokeWorkerUpdate()"));
+    endCycle();
+    std::lock_guard<std::mutex> guard(m_mutex);
+    updateComponentList();
+  }
+
+  void ExecutionContextWorker::invokeScheduled(bool postDo)
+  {
+    for (size_t i(0); i < m_comps.size(); ++i)
+      {
+        if (!isScheduled(i)) { continue; }
+        if (m_schedule[i].group < 0 || !m_measureExecTime)
+          {
+            if (postDo) { m_comps[i]->workerPostDo(); }
+            else        { m_comps[i]->workerDo();     }
+            continue;
+          }
+        auto start = std::chrono::steady_clock::now();
+        if (postDo) { m_comps[i]->workerPostDo(); }
+        else        { m_comps[i]->workerDo();     }
+        addExecTime(i, std::chrono::steady_clock::now() - start);
+      }
+  }
+
+  void ExecutionContextWorker::
+  addExecTime(size_t index, std::chrono::nanoseconds time)
+  {
+    int group(m_schedule[index].group);
+    if (group < 0 || !m_measureExecTime) { return; }
+    m_groupStatistics[static_cast<size_t>(group)]->time += time.count();
+  }
+
+  void ExecutionContextWorker::endCycle()
+  {
+    for (size_t i(0); i < m_groups.size(); ++i)
+      {
+        if (m_cycle % m_groups[i].divisor !=
+            static_cast<unsigned int>(m_groups[i].phase))
+          {
+            continue;
+          }
+        RateGroupStatistics& stat(*m_groupStatistics[i]);
+        ++stat.activations;
+        if (m_measureExecTime)
+          {
+            stat.execTime.record(
+              std::chrono::nanoseconds(stat.time.exchange(0)));
+          }
+      }
+    ++m_cycle;
+  }
+
+  void ExecutionContextWorker::
+  setRateGroups(const std::vector<RateGroup>& groups)
+  {
+    std::vector<RateGroup> tmp(groups);
+    for (auto & group : tmp)
+      {
+        if (group.divisor == 0) { group.divisor = 1; }
+        if (group.phase >= 0)
+          {
+            group.phase %= static_cast<int>(group.divisor);
+          }
+      }
+    assignPhases(tmp);
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_groups.swap(tmp);
+    m_groupStatistics.clear();
+    for (auto & group : m_groups)
+      {
+        m_groupStatistics.emplace_back(new RateGroupStatistics());
+        RTC_DEBUG(("rate group %s: divisor = %u, phase = %d, members = %s",
+                   group.name.c_str(), group.divisor, group.phase,
+                   coil::flatten(group.members).c_str()));
+      }
+    m_cycle = 0;
+    updateSchedule();
+  }
+
+  void ExecutionContextWorker::updateSchedule()
+  {
+    m_schedule.assign(m_comps.size(), Schedule{1, 0, -1});
+    if (m_groups.empty()) { return; }
+    for (size_t i(0); i < m_comps.size(); ++i)
+      {
+        std::string name(m_comps[i]->getInstanceName());
+        if (name.empty()) { continue; }
+        for (size_t g(0); g < m_groups.size(); ++g)
+          {
+            const coil::vstring& members(m_groups[g].members);
+            if (std::find(members.begin(), members.end(), name)
+                == members.end())
+              {
+                continue;
+              }
+            if (m_schedule[i].group >= 0)
+              {
+                RTC_WARN(("%s belongs to rate groups %s and %s. "
+                          "The first one is used.", name.c_str(),
+                          m_groups[static_cast<size_t>(m_schedule[i].group)]
+                          .name.c_str(), m_groups[g].name.c_str()));
+                break;
+              }
+            m_schedule[i].divisor = m_groups[g].divisor;
+            m_schedule[i].phase = static_cast<unsigned int>(m_groups[g].phase);
+            m_schedule[i].group = static_cast<int>(g);
+          }
+      }
+  }
+
+  const std::vector<RTC_impl::RTObjectStateMachine*>&
+  ExecutionContextWorker::getComponentList() const
+  {
+    return m_comps;
+  }
+
+  void ExecutionContextWorker::updateExecutionOrder()
+  {
+    if (!m_autoOrder && m_order.empty()) { return; }
+    // read first not to miss connections made while sorting
+    unsigned long revision(RTC::PortBase::getConnectionRevision());
+    if (!m_orderChanged && (!m_autoOrder || revision == m_orderRevision))
+      {
+        return;
+      }
+    m_orderChanged = false;
+    m_orderRevision = revision;
+
+    RTC::TaskGraph graph;
+    if (buildDependencyGraph(graph, m_autoOrder) != 0)
+      {
+        RTC_WARN(("Cyclic dependencies found. The dependencies closing "
+                  "the cycles are ignored."));
+      }
+    std::vector<RTC_impl::RTObjectStateMachine*> comps;
+    for (auto node : graph.getOrder()) { comps.push_back(m_comps[node]); }
+    if (comps == m_comps) { return; }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_comps.swap(comps);
+    updateSchedule();
+    for (auto & comp : m_comps)
+      {
+        RTC_DEBUG(("execution order: %s", comp->getInstanceName().c_str()));
+      }
+  }
+
+  void ExecutionContextWorker::
+  setExecutionOrder(const coil::vstring& order, bool automatic)
+  {
+    RTC_TRACE(("setExecutionOrder(%s, %s)", coil::flatten(order).c_str(),
+               automatic ? "automatic" : "manual"));
+    m_order = order;
+    m_autoOrder = automatic;
+    m_orderChanged = true;
+  }
+
+  size_t ExecutionContextWorker::
+  buildDependencyGraph(RTC::TaskGraph& graph, bool connections)
+  {
+    RTC_TRACE(("buildDependencyGraph()"));
+    graph.reset(m_comps.size());
+    size_t dropped(0);
+    std::vector<std::string> names;
+    for (auto & comp : m_comps) { names.push_back(comp->getInstanceName()); }
+
+    // explicit constraints "A>B>C"
+    for (auto & seq : m_order)
+      {
+        coil::vstring chain(coil::split(seq, ">", true));
+        std::vector<size_t> nodes;
+        for (auto & name : chain)
+          {
+            auto it = std::find(names.begin(), names.end(), name);
+            if (it == names.end())
+              {
+                RTC_DEBUG(("%s in the order is not participating.",
+                           name.c_str()));
+                continue;
+              }
+            nodes.push_back(static_cast<size_t>(it - names.begin()));
+          }
+        for (size_t i(1); i < nodes.size(); ++i)
+          {
+            if (nodes[i - 1] == nodes[i]) { continue; }
+            if (!graph.addEdge(nodes[i - 1], nodes[i]))
+              {
+                RTC_WARN(("Order %s > %s makes a cycle. Ignored.",
+                          names[nodes[i - 1]].c_str(),
+                          names[nodes[i]].c_str()));
+                ++dropped;
+              }
+          }
+      }
+
+    if (!connections) { return dropped; }
+
+    // data port connections between the participants
+    std::map<std::string, std::vector<size_t> > producers;
+    for (size_t i(0); i < m_comps.size(); ++i)
+      {
+        RTC::RTObject_impl* rtobj(m_comps[i]->getRTObjectPtr());
+        if (rtobj == nullptr) { continue; }
+        for (auto port : rtobj->getOutPorts())
+          {
+            for (auto & id : port->getConnectorIds())
+              {
+                producers[id].push_back(i);
+              }
+          }
+      }
+    for (size_t i(0); i < m_comps.size(); ++i)
+      {
+        RTC::RTObject_impl* rtobj(m_comps[i]->getRTObjectPtr());
+        if (rtobj == nullptr) { continue; }
+        for (auto port : rtobj->getInPorts())
+          {
+            for (auto & id : port->getConnectorIds())
+              {
+                auto it = producers.find(id);
+                if (it == producers.end()) { continue; }
+                for (auto from : it->second)
+                  {
+                    if (from == i || graph.addEdge(from, i)) { continue; }
+                    RTC_WARN(("Connection %s from %s to %s makes a cycle. "
+                              "Ignored.", id.c_str(), names[from].c_str(),
+                              names[i].c_str()));
+                    ++dropped;
+                  }
+              }
+          }
+      }
+    return dropped;
+  }
+
 } // namespace RTC_impl
 
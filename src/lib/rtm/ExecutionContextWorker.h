@@ -23,6 +23,15 @@
 
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/SystemLogger.h>
+#include <rtm/TimingHistogram.h>
+#include <coil/Properties.h>
+#include <coil/stringutil.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #define NUM_OF_LIFECYCLESTATE 4
@@ -30,6 +39,7 @@
 namespace RTC
 {
   class RTObject_impl;
+  class TaskGraph;
 } // namespace RTC
 namespace RTC_impl
 {
@@ -112,6 +122,31 @@ namespace RTC_impl
   {
 
   public:
+    /*!
+     * @if jp
+     * @brief レートグループの設定
+     *
+     * members のコンポーネントの on_execute と on_state_update は
+     * divisor 周期ごとに、周期番号を divisor で割った余りが phase にな
+     * る周期に実行される。phase が負の場合は自動で割り当てる。
+     *
+     * @else
+     * @brief Settings of a rate group
+     *
+     * on_execute and on_state_update of the components in members are
+     * executed every divisor cycles, in the cycles whose number modulo
+     * divisor is phase. A negative phase is assigned automatically.
+     *
+     * @endif
+     */
+    struct RateGroup
+    {
+      std::string name;
+      unsigned int divisor;
+      int phase;
+      coil::vstring members;
+    };
+
     /*!
      * @if jp
      * @brief デフォルトコンストラクタ
@@ -533,8 +568,62 @@ namespace RTC_impl
      * @endif
      */
     RTC::ReturnCode_t removeComponent(RTC::LightweightRTObject_ptr comp);
+
+    /*!
+     * @if jp
+     * @brief 参加コンポーネントを検索する
+     *
+     * 参加時にキャッシュした参照の _hash() の索引から、リモート呼び出
+     * しや文字列の生成なしに定数時間で検索する。同じオブジェクトが異な
+     * るハッシュの参照で与えられ索引にない場合のみ、_is_equivalent() で
+     * 全参加コンポーネントと比較し、見つかった参照を索引に追加する。こ
+     * のため全体の比較は参照ごとに一度のみで、参加していないコンポー
+     * ネントの検索 (エラーとなる呼び出し) でのみ繰り返される。
+     *
+     * @param comp 検索するコンポーネント
+     * @return 状態マシン。参加していない場合は nullptr。
+     *
+     * @else
+     * @brief Find a participating component
+     *
+     * The component is looked up in constant time, without remote calls
+     * or building strings, in the index of the reference _hash() values
+     * cached when the components joined. Only if the same object is
+     * given by a reference with another hash missing in the index, it
+     * is compared with all participants by _is_equivalent() and the
+     * reference found is added to the index. Hence the full comparison
+     * is made once per reference, and is only repeated for components
+     * not participating, i.e. for calls failing anyway.
+     *
+     * @param comp The component to find
+     * @return The state machine, or nullptr if it is not participating
+     *
+     * @endif
+     */
     RTObjectStateMachine* findComponent(RTC::LightweightRTObject_ptr comp);
 
+    /*!
+     * @if jp
+     * @brief 全参加コンポーネントの状態を取得する
+     *
+     * 一度のロックで全参加コンポーネントの状態を取得する。リモート呼び
+     * 出しは行わない。
+     *
+     * @return 参加コンポーネントとその状態のリスト
+     *
+     * @else
+     * @brief Get the states of all participating components
+     *
+     * The states of all participants are taken under a single lock.
+     * No remote call is made.
+     *
+     * @return The list of the participants and their states
+     *
+     * @endif
+     */
+    std::vector<std::pair<RTC::LightweightRTObject_var, RTC::LifeCycleState> >
+    getComponentStates();
+
     bool isAllCurrentState(RTC::LifeCycleState state);
     bool isAllNextState(RTC::LifeCycleState state);
     bool isOneOfCurrentState(RTC::LifeCycleState state);
@@ -545,6 +634,264 @@ namespace RTC_impl
     void invokeWorkerDo();
     void invokeWorkerPostDo();
 
+    /*!
+     * @if jp
+     * @brief ロックを取得してコンポーネントリストを更新する
+     *
+     * invokeWorkerPostDo() の代わりに ExecutionContext 自身がコンポー
+     * ネントの処理を実行した後に呼び出す。
+     *
+     * @else
+     * @brief Update the component list taking the lock
+     *
+     * This is called after the ExecutionContext itself invokes the
+     * workers of the components instead of invokeWorkerPostDo().
+     *
+     * @endif
+     */
+    void invokeWorkerUpdate();
+
+    /*!
+     * @if jp
+     * @brief 参加コンポーネントのリストを取得する
+     *
+     * リストは ExecutionContext のスレッドで invokeWorkerPostDo() など
+     * によってのみ変更されるため、同じスレッドからはロックせずに参照で
+     * きる。
+     *
+     * @return 参加コンポーネントのリスト
+     *
+     * @else
+     * @brief Get the list of the participating components
+     *
+     * The list is changed only by invokeWorkerPostDo() and the like in
+     * the thread of the ExecutionContext, so that thread can refer to it
+     * without lock.
+     *
+     * @return The list of the participating components
+     *
+     * @endif
+     */
+    const std::vector<RTC_impl::RTObjectStateMachine*>&
+    getComponentList() const;
+
+    /*!
+     * @if jp
+     * @brief 実行順序を設定する
+     *
+     * order は "A>B>C" 形式のインスタンス名の列のリストで、A, B, C の
+     * 順に実行する制約を与える。automatic が true の場合、参加コンポー
+     * ネント間のデータポートの接続から、データを出力するコンポーネント
+     * を受け取るコンポーネントより先に実行する順序に並べ替える。並べ替
+     * えは参加コンポーネントまたは接続が変わったときに
+     * invokeWorker() または invokeWorkerPreDo() の最初で行われる。
+     *
+     * @param order 明示的な実行順序の制約
+     * @param automatic 接続から実行順序を決める場合 true
+     *
+     * @else
+     * @brief Set the execution order
+     *
+     * order is a list of sequences of instance names in the form
+     * "A>B>C" constraining A, B and C to be executed in that order. If
+     * automatic is true, the components are sorted from the data port
+     * connections between them so that a component writing data is
+     * executed before the components receiving it. The components are
+     * sorted at the beginning of invokeWorker() or invokeWorkerPreDo()
+     * when the participants or the connections change.
+     *
+     * @param order The explicit constraints of the execution order
+     * @param automatic true to order by the connections
+     *
+     * @endif
+     */
+    void setExecutionOrder(const coil::vstring& order, bool automatic);
+
+    /*!
+     * @if jp
+     * @brief レートグループを設定する
+     *
+     * どのグループにも属さないコンポーネントは毎周期実行する。状態遷
+     * 移は全コンポーネントで毎周期処理する。自動の位相は、グループを
+     * 構成するコンポーネント数を負荷として、各周期に実行されるコンポー
+     * ネント数の最大値が最小になるように大きいグループから順に決める。
+     *
+     * @param groups レートグループのリスト
+     *
+     * @else
+     * @brief Set the rate groups
+     *
+     * Components not belonging to any group are executed every cycle.
+     * State transitions of all components are handled every cycle.
+     * Automatic phases are decided from the largest group taking the
+     * number of member components as the load, so that the maximum
+     * number of components executed in a cycle is minimized.
+     *
+     * @param groups The list of the rate groups
+     *
+     * @endif
+     */
+    void setRateGroups(const std::vector<RateGroup>& groups);
+
+    /*!
+     * @if jp
+     * @brief コンポーネントを現在の周期で実行するか判定する
+     *
+     * 各段階を自身で実行する ExecutionContext は、false のコンポーネン
+     * トの workerDo() と workerPostDo() を呼ばない。
+     *
+     * @param index getComponentList() のインデックス
+     * @return 実行する場合 true
+     *
+     * @else
+     * @brief Check if a component is executed in the current cycle
+     *
+     * ExecutionContexts invoking the phases by themselves do not call
+     * workerDo() and workerPostDo() of the components for which this
+     * returns false.
+     *
+     * @param index The index in getComponentList()
+     * @return true if the component is executed
+     *
+     * @endif
+     */
+    bool isScheduled(size_t index) const
+    {
+      const Schedule& schedule(m_schedule[index]);
+      return schedule.divisor <= 1 ||
+        m_cycle % schedule.divisor == schedule.phase;
+    }
+
+    /*!
+     * @if jp
+     * @brief レートグループの実行時間に加算する
+     *
+     * 各段階を自身で実行する ExecutionContext が、workerDo() と
+     * workerPostDo() の実行時間を通知する。複数のスレッドから呼び出せ
+     * る。
+     *
+     * @param index getComponentList() のインデックス
+     * @param time 実行時間
+     *
+     * @else
+     * @brief Add to the execution time of a rate group
+     *
+     * ExecutionContexts invoking the phases by themselves report the
+     * times of workerDo() and workerPostDo(). This can be called from
+     * multiple threads.
+     *
+     * @param index The index in getComponentList()
+     * @param time The execution time
+     *
+     * @endif
+     */
+    void addExecTime(size_t index, std::chrono::nanoseconds time);
+
+    /*!
+     * @if jp
+     * @brief 参加コンポーネントの依存関係グラフを作成する
+     *
+     * グラフのノード i は getComponentList() の i 番目のコンポーネント
+     * である。setExecutionOrder() で与えた順序の制約を追加した後、
+     * connections が true の場合は参加コンポーネント間のデータポートの
+     * 接続ごとに OutPort 側から InPort 側への辺を追加する。閉路を作る依
+     * 存関係は追加せず警告を出力する。
+     *
+     * @param graph 作成するグラフ
+     * @param connections データポートの接続を依存関係とする場合 true
+     * @return 閉路を作るため追加しなかった依存関係の数
+     *
+     * @else
+     * @brief Build the dependency graph of the participating components
+     *
+     * Node i of the graph is the i-th component of getComponentList().
+     * After the order constraints given by setExecutionOrder(), an edge
+     * from the OutPort side to the InPort side is added for each data
+     * port connection between the participating components if
+     * connections is true. Dependencies which make a cycle are not
+     * added and reported as warnings.
+     *
+     * @param graph The graph to build
+     * @param connections true to add the data port connections
+     * @return The number of dependencies not added because of a cycle
+     *
+     * @endif
+     */
+    size_t buildDependencyGraph(RTC::TaskGraph& graph,
+                                bool connections = true);
+
+    /*!
+     * @if jp
+     * @brief on_execute の実行時間の計測を設定する
+     * @param measure 計測する場合 true
+     * @else
+     * @brief Set the measurement of the on_execute time
+     * @param measure true to measure
+     * @endif
+     */
+    void setExecTimeMeasure(bool measure);
+
+    /*!
+     * @if jp
+     * @brief コンポーネントごとの on_execute の実行時間の統計を取得する
+     *
+     * prefix.<インスタンス名>.* に統計値を書き込む。インスタンス名が得
+     * られないリモートのコンポーネントは comp<番号> とする。
+     *
+     * @param prop 書き込むプロパティ
+     * @param prefix キーの接頭辞
+     *
+     * @else
+     * @brief Get the statistics of the on_execute time per component
+     *
+     * The statistics are written to prefix.<instance name>.*. Remote
+     * components whose instance name is not available are named
+     * comp<index>.
+     *
+     * @param prop The properties to write to
+     * @param prefix The prefix of the keys
+     *
+     * @endif
+     */
+    void getExecTimeStatistics(coil::Properties& prop,
+                               const std::string& prefix);
+
+    /*!
+     * @if jp
+     * @brief レートグループごとの統計を取得する
+     *
+     * prefix.<グループ名> 以下に divisor, phase, 実行回数 activations
+     * と、1 回の実行でのメンバーの on_execute と on_state_update の合
+     * 計時間の統計 exec_time.* を書き込む。
+     *
+     * @param prop 書き込むプロパティ
+     * @param prefix キーの接頭辞
+     *
+     * @else
+     * @brief Get the statistics per rate group
+     *
+     * divisor, phase, the number of activations and the statistics of
+     * the total time of on_execute and on_state_update of the members
+     * in an activation (exec_time.*) are written under
+     * prefix.<group name>.
+     *
+     * @param prop The properties to write to
+     * @param prefix The prefix of the keys
+     *
+     * @endif
+     */
+    void getRateGroupStatistics(coil::Properties& prop,
+                                const std::string& prefix);
+
+    /*!
+     * @if jp
+     * @brief on_execute の実行時間の統計を消去する
+     * @else
+     * @brief Clear the statistics of the on_execute time
+     * @endif
+     */
+    void resetExecTimeStatistics();
+
     /*!
      * @if jp
      * @brief コンポーネントリストの更新
@@ -554,6 +901,55 @@ namespace RTC_impl
      */
     void updateComponentList();
 
+    /*!
+     * @if jp
+     * @brief 実行順序を必要であれば並べ替える
+     * @else
+     * @brief Sort the execution order if needed
+     * @endif
+     */
+    void updateExecutionOrder();
+
+  protected:
+    /*!
+     * @if jp
+     * @brief コンポーネントのレートグループを求め直す
+     * @else
+     * @brief Resolve the rate groups of the components again
+     * @endif
+     */
+    void updateSchedule();
+
+    /*!
+     * @if jp
+     * @brief 周期の終わりにレートグループの統計を更新する
+     * @else
+     * @brief Update the statistics of the rate groups at the end of a
+     *        cycle
+     * @endif
+     */
+    void endCycle();
+
+    /*!
+     * @if jp
+     * @brief コンポーネントを索引に登録する
+     * @else
+     * @brief Register a component in the index
+     * @endif
+     */
+    void addIndex(RTObjectStateMachine* rtobj);
+
+    /*!
+     * @if jp
+     * @brief 現在の周期で実行するコンポーネントの workerDo() または
+     *        workerPostDo() を呼び出す
+     * @else
+     * @brief Call workerDo() or workerPostDo() of the components
+     *        executed in the current cycle
+     * @endif
+     */
+    void invokeScheduled(bool postDo);
+
     //------------------------------------------------------------
     // member variables
   protected:
@@ -594,6 +990,79 @@ namespace RTC_impl
     mutable std::mutex m_removedMutex;
     typedef std::vector<RTC_impl::RTObjectStateMachine*>::iterator CompItr;
 
+    /*!
+     * @if jp
+     * @brief オブジェクトキーによる m_comps の索引
+     * @else
+     * @brief Index of m_comps by the object key
+     * @endif
+     */
+    std::unordered_multimap<CORBA::ULong,
+                            RTC_impl::RTObjectStateMachine*> m_index;
+
+    /*!
+     * @if jp
+     * @brief on_execute の実行時間を計測するか
+     * @else
+     * @brief Whether the on_execute time is measured
+     * @endif
+     */
+    bool m_measureExecTime;
+
+    /*!
+     * @if jp
+     * @brief 実行順序の設定
+     *
+     * m_orderChanged は参加コンポーネントが変わったとき、
+     * m_orderRevision は並べ替えたときの接続のリビジョンである。
+     *
+     * @else
+     * @brief Settings of the execution order
+     *
+     * m_orderChanged is set when the participants change, and
+     * m_orderRevision is the revision of the connections when the
+     * components were sorted.
+     *
+     * @endif
+     */
+    coil::vstring m_order;
+    bool m_autoOrder;
+    bool m_orderChanged;
+    unsigned long m_orderRevision;
+
+    /*!
+     * @if jp
+     * @brief レートグループ
+     *
+     * m_schedule は m_comps と同じ順序で各コンポーネントの実行周期を
+     * 保持する。m_cycle は実行した周期の数である。
+     *
+     * @else
+     * @brief Rate groups
+     *
+     * m_schedule holds the execution cycle of each component in the
+     * same order as m_comps. m_cycle is the number of executed cycles.
+     *
+     * @endif
+     */
+    struct Schedule
+    {
+      unsigned int divisor;
+      unsigned int phase;
+      int group;
+    };
+    struct RateGroupStatistics
+    {
+      RateGroupStatistics() : time(0), activations(0) {}
+      std::atomic<long long> time;
+      std::atomic<unsigned long long> activations;
+      RTC::TimingHistogram execTime;
+    };
+    std::vector<RateGroup> m_groups;
+    std::vector<std::unique_ptr<RateGroupStatistics> > m_groupStatistics;
+    std::vector<Schedule> m_schedule;
+    unsigned long long m_cycle;
+
   };  // class PeriodicExecutionContext
 } // namespace RTC_impl
 
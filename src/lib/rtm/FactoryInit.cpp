@@ -52,6 +52,10 @@
 #include <rtm/InPortCorbaCdrUDPConsumer.h>
 #endif
 
+// Codecs
+#include <rtm/DeltaCodec.h>
+#include <rtm/LZCodec.h>
+
 // RTC name numbering policy
 #include <rtm/NumberingPolicy.h>
 #include <rtm/NamingServiceNumberingPolicy.h>
@@ -101,6 +105,10 @@ namespace RTM
     InPortCorbaCdrUDPConsumerInit();
 #endif
 
+    // Codecs
+    DeltaCodecInit();
+    LZCodecInit();
+
     // Naming Policy
     ProcessUniquePolicyInit();
 	NamingServiceNumberingPolicyInit();
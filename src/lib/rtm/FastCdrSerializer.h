@@ -0,0 +1,692 @@
+﻿// -*- C++ -*-
+/*!
+ * @file FastCdrSerializer.h
+ * @brief CDR serializer specialized at compile time for fixed layout types
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_FASTCDRSERIALIZER_H
+#define RTC_FASTCDRSERIALIZER_H
+
+#include <rtm/ByteDataStreamBase.h>
+#include <rtm/ByteSwap.h>
+#include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/idl/BasicDataTypeSkel.h>
+#include <rtm/idl/ExtendedDataTypesSkel.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @namespace FastCdr
+   * @brief fast_cdr シリアライザの実装
+   *
+   * データ型の構造をテンプレートで展開し、CORBA の CDR ストリームと同
+   * じバイト列を直接生成、解析する。以下の型に対応する。
+   *
+   * - 整数、浮動小数点数、char、boolean、octet
+   * - RTC::Time
+   * - double のみからなる ExtendedDataTypes の構造体 (Point3D, Pose2D
+   *   など)。メモリ上の配置が CDR と一致するため一括でコピーする。
+   * - 上記の型のシーケンス。一括でコピーし、バイトオーダーが異なる場合は
+   *   ByteSwap の SIMD カーネルで変換する。
+   * - 上記の型の tm と data からなる Timed 型
+   *
+   * @else
+   * @namespace FastCdr
+   * @brief Implementation of the fast_cdr serializer
+   *
+   * The structure of data types is expanded by templates, and the same
+   * bytes as a CORBA CDR stream are generated and parsed directly. The
+   * following types are supported.
+   *
+   * - Integers, floating point numbers, char, boolean and octet
+   * - RTC::Time
+   * - Structures of ExtendedDataTypes consisting only of doubles
+   *   (Point3D, Pose2D, etc.). They are copied at once since their
+   *   memory layout is the same as CDR.
+   * - Sequences of primitive types, copied at once. When the byte
+   *   order differs they are converted by the SIMD kernels of ByteSwap.
+   * - Timed types consisting of tm and data of the above types
+   *
+   * @endif
+   */
+  namespace FastCdr
+  {
+    /*!
+     * @if jp
+     * @brief CDR のプリミティブ型か判定する
+     * @else
+     * @brief Whether the type is a CDR primitive type
+     * @endif
+     */
+    template <class T>
+    struct IsPrimitive
+      : std::integral_constant<bool,
+          std::is_arithmetic<T>::value &&
+          !std::is_same<T, bool>::value &&
+          !std::is_same<T, wchar_t>::value &&
+          !std::is_same<T, long double>::value &&
+          (sizeof(T) == 1 || sizeof(T) == 2 ||
+           sizeof(T) == 4 || sizeof(T) == 8)>
+    {
+    };
+
+    /*!
+     * @if jp
+     * @brief double のみからなる構造体か判定する
+     *
+     * これらの型はメモリ上で double の配列と同じ配置となり、CDR でも
+     * 8 バイト境界から連続した double として符号化される。
+     *
+     * @else
+     * @brief Whether the type is a structure of doubles only
+     *
+     * The memory layout of these types is the same as an array of
+     * doubles, and they are encoded in CDR as consecutive doubles from
+     * an 8 byte boundary.
+     *
+     * @endif
+     */
+    template <class T>
+    struct IsDoubleBlock : std::false_type
+    {
+    };
+
+#define RTC_FASTCDR_DOUBLE_BLOCK(T)                                     \
+    template <> struct IsDoubleBlock< ::RTC::T> : std::true_type        \
+    {                                                                   \
+      static_assert(sizeof(::RTC::T) % sizeof(::CORBA::Double) == 0,    \
+                    #T " is not a block of doubles");                   \
+    }
+
+    RTC_FASTCDR_DOUBLE_BLOCK(RGBColour);
+    RTC_FASTCDR_DOUBLE_BLOCK(Point2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Vector2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Pose2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Velocity2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Acceleration2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(PoseVel2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Size2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Geometry2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Covariance2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(PointCovariance2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Carlike);
+    RTC_FASTCDR_DOUBLE_BLOCK(SpeedHeading2D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Point3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Vector3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Orientation3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Pose3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Velocity3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(AngularVelocity3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Acceleration3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(AngularAcceleration3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(PoseVel3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Size3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Geometry3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(Covariance3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(SpeedHeading3D);
+    RTC_FASTCDR_DOUBLE_BLOCK(OAP);
+    RTC_FASTCDR_DOUBLE_BLOCK(Quaternion);
+
+#undef RTC_FASTCDR_DOUBLE_BLOCK
+
+    /*!
+     * @if jp
+     * @brief RTC::Time tm と data のみからなる Timed 型か判定する
+     *
+     * tm と data を持つ任意の型を Timed 型とみなすと、それ以外のメンバ
+     * が黙って失われるため、対象の型を明示的に列挙する。各型について
+     * tm と data 以外のメンバを持たないことをコンパイル時に確認する。
+     *
+     * @else
+     * @brief Whether the type is a Timed type of RTC::Time tm and data only
+     *
+     * Treating any type that has tm and data as a Timed type would
+     * silently drop its other members, so the supported types are
+     * listed explicitly. For each of them it is checked at compile time
+     * that it has no members other than tm and data.
+     *
+     * @endif
+     */
+    template <class T>
+    struct IsTimed : std::false_type
+    {
+    };
+
+    template <class D>
+    struct TimedLayout
+    {
+      ::RTC::Time tm;
+      D data;
+    };
+
+#define RTC_FASTCDR_TIMED(T)                                            \
+    template <> struct IsTimed< ::RTC::T> : std::true_type              \
+    {                                                                   \
+      static_assert(sizeof(::RTC::T) ==                                 \
+                    sizeof(TimedLayout<decltype(::RTC::T::data)>),      \
+                    #T " has members other than tm and data");          \
+    }
+
+    RTC_FASTCDR_TIMED(TimedState);
+    RTC_FASTCDR_TIMED(TimedShort);
+    RTC_FASTCDR_TIMED(TimedLong);
+    RTC_FASTCDR_TIMED(TimedUShort);
+    RTC_FASTCDR_TIMED(TimedULong);
+    RTC_FASTCDR_TIMED(TimedFloat);
+    RTC_FASTCDR_TIMED(TimedDouble);
+    RTC_FASTCDR_TIMED(TimedChar);
+    RTC_FASTCDR_TIMED(TimedWChar);
+    RTC_FASTCDR_TIMED(TimedBoolean);
+    RTC_FASTCDR_TIMED(TimedOctet);
+    RTC_FASTCDR_TIMED(TimedString);
+    RTC_FASTCDR_TIMED(TimedWString);
+    RTC_FASTCDR_TIMED(TimedShortSeq);
+    RTC_FASTCDR_TIMED(TimedLongSeq);
+    RTC_FASTCDR_TIMED(TimedUShortSeq);
+    RTC_FASTCDR_TIMED(TimedULongSeq);
+    RTC_FASTCDR_TIMED(TimedFloatSeq);
+    RTC_FASTCDR_TIMED(TimedDoubleSeq);
+    RTC_FASTCDR_TIMED(TimedCharSeq);
+    RTC_FASTCDR_TIMED(TimedWCharSeq);
+    RTC_FASTCDR_TIMED(TimedBooleanSeq);
+    RTC_FASTCDR_TIMED(TimedOctetSeq);
+    RTC_FASTCDR_TIMED(TimedStringSeq);
+    RTC_FASTCDR_TIMED(TimedWStringSeq);
+    RTC_FASTCDR_TIMED(TimedRGBColour);
+    RTC_FASTCDR_TIMED(TimedPoint2D);
+    RTC_FASTCDR_TIMED(TimedVector2D);
+    RTC_FASTCDR_TIMED(TimedPose2D);
+    RTC_FASTCDR_TIMED(TimedVelocity2D);
+    RTC_FASTCDR_TIMED(TimedAcceleration2D);
+    RTC_FASTCDR_TIMED(TimedPoseVel2D);
+    RTC_FASTCDR_TIMED(TimedSize2D);
+    RTC_FASTCDR_TIMED(TimedGeometry2D);
+    RTC_FASTCDR_TIMED(TimedCovariance2D);
+    RTC_FASTCDR_TIMED(TimedPointCovariance2D);
+    RTC_FASTCDR_TIMED(TimedCarlike);
+    RTC_FASTCDR_TIMED(TimedSpeedHeading2D);
+    RTC_FASTCDR_TIMED(TimedPoint3D);
+    RTC_FASTCDR_TIMED(TimedVector3D);
+    RTC_FASTCDR_TIMED(TimedOrientation3D);
+    RTC_FASTCDR_TIMED(TimedPose3D);
+    RTC_FASTCDR_TIMED(TimedVelocity3D);
+    RTC_FASTCDR_TIMED(TimedAngularVelocity3D);
+    RTC_FASTCDR_TIMED(TimedAcceleration3D);
+    RTC_FASTCDR_TIMED(TimedAngularAcceleration3D);
+    RTC_FASTCDR_TIMED(TimedPoseVel3D);
+    RTC_FASTCDR_TIMED(TimedSize3D);
+    RTC_FASTCDR_TIMED(TimedGeometry3D);
+    RTC_FASTCDR_TIMED(TimedCovariance3D);
+    RTC_FASTCDR_TIMED(TimedSpeedHeading3D);
+    RTC_FASTCDR_TIMED(TimedOAP);
+    RTC_FASTCDR_TIMED(TimedQuaternion);
+
+#undef RTC_FASTCDR_TIMED
+
+    inline bool isHostLittleEndian()
+    {
+      const uint16_t v(1);
+      return *reinterpret_cast<const unsigned char*>(&v) == 1;
+    }
+
+    template <class T>
+    inline T byteSwap(T v)
+    {
+      unsigned char b[sizeof(T)];
+      memcpy(b, &v, sizeof(T));
+      for (size_t i(0); i < sizeof(T) / 2; ++i)
+        {
+          unsigned char t(b[i]);
+          b[i] = b[sizeof(T) - 1 - i];
+          b[sizeof(T) - 1 - i] = t;
+        }
+      memcpy(&v, b, sizeof(T));
+      return v;
+    }
+
+    /*!
+     * @if jp
+     * @brief 小さなデータをヒープ確保なしで保持するバッファ
+     * @else
+     * @brief Buffer holding small data without heap allocation
+     * @endif
+     */
+    class Buffer
+    {
+    public:
+      Buffer() : m_data(m_inline), m_size(0), m_capacity(sizeof(m_inline)) {}
+      Buffer(const Buffer&) = delete;
+      Buffer& operator=(const Buffer&) = delete;
+
+      unsigned char* data() { return m_data; }
+      const unsigned char* data() const { return m_data; }
+      size_t size() const { return m_size; }
+      void setSize(size_t size) { m_size = size; }
+
+      void reserve(size_t size)
+      {
+        if (size <= m_capacity) { return; }
+        size_t capacity(m_capacity * 2 > size ? m_capacity * 2 : size);
+        std::vector<unsigned char> heap(capacity);
+        // the writer may have written beyond m_size
+        memcpy(heap.data(), m_data, m_capacity);
+        m_heap.swap(heap);
+        m_data = m_heap.data();
+        m_capacity = capacity;
+      }
+
+    private:
+      unsigned char m_inline[128];
+      std::vector<unsigned char> m_heap;
+      unsigned char* m_data;
+      size_t m_size;
+      size_t m_capacity;
+    };
+
+    /*!
+     * @if jp
+     * @brief CDR 書き込み
+     * @else
+     * @brief CDR writer
+     * @endif
+     */
+    class Writer
+    {
+    public:
+      Writer(Buffer& buffer, bool little_endian)
+        : m_buffer(buffer), m_pos(0),
+          m_swap(little_endian != isHostLittleEndian())
+      {
+      }
+
+      template <class T>
+      void primitive(const T& v)
+      {
+        align(sizeof(T));
+        m_buffer.reserve(m_pos + sizeof(T));
+        T tmp(m_swap ? byteSwap(v) : v);
+        memcpy(m_buffer.data() + m_pos, &tmp, sizeof(T));
+        m_pos += sizeof(T);
+      }
+
+      template <class T>
+      void array(const T* v, size_t n)
+      {
+        if (n == 0) { return; }
+        align(sizeof(T));
+        m_buffer.reserve(m_pos + n * sizeof(T));
+        unsigned char* p(m_buffer.data() + m_pos);
+        if (m_swap)
+          {
+            ByteSwap::copy<sizeof(T)>(p, v, n);
+          }
+        else
+          {
+            memcpy(p, v, n * sizeof(T));
+          }
+        m_pos += n * sizeof(T);
+      }
+
+      template <class Seq>
+      void sequence(Seq& v)
+      {
+        ::CORBA::ULong len(v.length());
+        primitive(len);
+        array(v.get_buffer(), len);
+      }
+
+      void finish() { m_buffer.setSize(m_pos); }
+
+    private:
+      void align(size_t n)
+      {
+        size_t pos((m_pos + n - 1) & ~(n - 1));
+        if (pos == m_pos) { return; }
+        m_buffer.reserve(pos);
+        memset(m_buffer.data() + m_pos, 0, pos - m_pos);
+        m_pos = pos;
+      }
+
+      Buffer& m_buffer;
+      size_t m_pos;
+      bool m_swap;
+    };
+
+    /*!
+     * @if jp
+     * @brief CDR 読み込み
+     * @else
+     * @brief CDR reader
+     * @endif
+     */
+    class Reader
+    {
+    public:
+      Reader(const unsigned char* data, size_t length, bool little_endian)
+        : m_data(data), m_length(length), m_pos(0), m_good(true),
+          m_swap(little_endian != isHostLittleEndian())
+      {
+      }
+
+      template <class T>
+      void primitive(T& v)
+      {
+        if (!align(sizeof(T)) || m_length - m_pos < sizeof(T))
+          {
+            m_good = false;
+            return;
+          }
+        memcpy(&v, m_data + m_pos, sizeof(T));
+        if (m_swap) { v = byteSwap(v); }
+        m_pos += sizeof(T);
+      }
+
+      template <class T>
+      void array(T* v, size_t n)
+      {
+        if (n == 0) { return; }
+        if (!align(sizeof(T)) || (m_length - m_pos) / sizeof(T) < n)
+          {
+            m_good = false;
+            return;
+          }
+        if (m_swap)
+          {
+            ByteSwap::copy<sizeof(T)>(v, m_data + m_pos, n);
+          }
+        else
+          {
+            memcpy(v, m_data + m_pos, n * sizeof(T));
+          }
+        m_pos += n * sizeof(T);
+      }
+
+      template <class Seq>
+      void sequence(Seq& v)
+      {
+        typedef typename std::remove_reference<
+          decltype(*v.get_buffer())>::type Element;
+        ::CORBA::ULong len(0);
+        primitive(len);
+        if (!m_good) { return; }
+        // check the length before allocating
+        size_t pos((m_pos + sizeof(Element) - 1) & ~(sizeof(Element) - 1));
+        if (len != 0 &&
+            (pos > m_length || (m_length - pos) / sizeof(Element) < len))
+          {
+            m_good = false;
+            return;
+          }
+        if (len > v.maximum())
+          {
+            // the old elements are overwritten, so do not copy them
+            v.replace(len, len, Seq::allocbuf(len), true);
+          }
+        else
+          {
+            // keeps the allocated buffer
+            v.length(len);
+          }
+        array(v.get_buffer(), len);
+      }
+
+      bool good() const { return m_good; }
+
+    private:
+      bool align(size_t n)
+      {
+        if (!m_good) { return false; }
+        size_t pos((m_pos + n - 1) & ~(n - 1));
+        if (pos > m_length) { return false; }
+        m_pos = pos;
+        return true;
+      }
+
+      const unsigned char* m_data;
+      size_t m_length;
+      size_t m_pos;
+      bool m_good;
+      bool m_swap;
+    };
+
+    // primitive types
+    template <class S, class T>
+    inline typename std::enable_if<IsPrimitive<T>::value>::type
+    marshal(S& s, T& v)
+    {
+      s.primitive(v);
+    }
+
+    // structures of doubles only
+    template <class S, class T>
+    inline typename std::enable_if<IsDoubleBlock<T>::value>::type
+    marshal(S& s, T& v)
+    {
+      s.array(reinterpret_cast< ::CORBA::Double*>(&v),
+              sizeof(T) / sizeof(::CORBA::Double));
+    }
+
+    // RTC::Time
+    template <class S>
+    inline void marshal(S& s, ::RTC::Time& v)
+    {
+      s.primitive(v.sec);
+      s.primitive(v.nsec);
+    }
+
+    // sequences of primitive types
+    template <class S, class Seq>
+    inline auto marshal(S& s, Seq& v)
+      -> typename std::enable_if<
+           IsPrimitive<typename std::remove_reference<
+             decltype(*v.get_buffer())>::type>::value &&
+           std::is_same<decltype(v.length()), ::CORBA::ULong>::value>::type
+    {
+      s.sequence(v);
+    }
+
+    // Timed types: struct { Time tm; T data; }
+    template <class S, class T>
+    inline auto marshal(S& s, T& v)
+      -> typename std::enable_if<IsTimed<T>::value,
+                                 decltype(marshal(s, v.data))>::type
+    {
+      marshal(s, v.tm);
+      marshal(s, v.data);
+    }
+
+    /*!
+     * @if jp
+     * @brief fast_cdr で扱える型か判定する
+     * @else
+     * @brief Whether the type can be handled by fast_cdr
+     * @endif
+     */
+    template <class T, class = void>
+    struct IsSupported : std::false_type
+    {
+    };
+
+    template <class T>
+    struct IsSupported<T,
+      decltype(marshal(std::declval<Writer&>(), std::declval<T&>()),
+               marshal(std::declval<Reader&>(), std::declval<T&>()))>
+      : std::true_type
+    {
+    };
+  } // namespace FastCdr
+
+  /*!
+   * @if jp
+   * @class FastCdrSerializer
+   * @brief 固定レイアウト型向け CDR シリアライザ
+   *
+   * marshaling_type に fast_cdr を指定すると使用される。CORBA の CDR
+   * ストリームを介さず、コンパイル時に展開したデータ型の構造に従って
+   * CDR のバイト列を直接生成、解析する。生成するバイト列は
+   * CORBA_CdrSerializer (corba) と同一であり、接続の相手側は corba、
+   * fast_cdr のいずれを使用してもよい。
+   *
+   * FastCdr で扱えない型 (文字列を含む型など) では CORBA_CdrSerializer
+   * と同じ動作となる。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class FastCdrSerializer
+   * @brief CDR serializer for fixed layout types
+   *
+   * This serializer is used when fast_cdr is specified as
+   * marshaling_type. Without going through the CORBA CDR stream, it
+   * generates and parses CDR bytes directly according to the structure
+   * of the data type expanded at compile time. The generated bytes are
+   * identical to CORBA_CdrSerializer (corba), so the other end of the
+   * connection may use either corba or fast_cdr.
+   *
+   * For types FastCdr cannot handle (e.g. types including strings) it
+   * behaves the same as CORBA_CdrSerializer.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  template <class DataType,
+            bool Supported = FastCdr::IsSupported<DataType>::value>
+  class FastCdrSerializer : public CORBA_CdrSerializer<DataType>
+  {
+  };
+
+  template <class DataType>
+  class FastCdrSerializer<DataType, true> : public ByteDataStream<DataType>
+  {
+  public:
+    FastCdrSerializer()
+      : m_extData(nullptr), m_extLength(0), m_littleEndian(true)
+    {
+    }
+
+    ~FastCdrSerializer() override
+    {
+    }
+
+    FastCdrSerializer(const FastCdrSerializer&) = delete;
+    FastCdrSerializer& operator=(const FastCdrSerializer&) = delete;
+
+    void init(const coil::Properties& /*prop*/) override
+    {
+    }
+
+    void writeData(const unsigned char* buffer, unsigned long length) override
+    {
+      materialize();
+      size_t size(m_buffer.size());
+      m_buffer.reserve(size + length);
+      memcpy(m_buffer.data() + size, buffer, length);
+      m_buffer.setSize(size + length);
+    }
+
+    void readData(unsigned char* buffer, unsigned long length) const override
+    {
+      memcpy(buffer, data(), length);
+    }
+
+    unsigned long getDataLength() const override
+    {
+      return static_cast<unsigned long>(size());
+    }
+
+    void attachData(const unsigned char* buffer,
+                    unsigned long length) override
+    {
+      m_buffer.setSize(0);
+      m_extData = buffer;
+      m_extLength = length;
+    }
+
+    bool serialize(const DataType& data) override
+    {
+      m_extData = nullptr;
+      m_extLength = 0;
+      FastCdr::Writer writer(m_buffer, m_littleEndian);
+      FastCdr::marshal(writer, const_cast<DataType&>(data));
+      writer.finish();
+      return true;
+    }
+
+    bool deserialize(DataType& data) override
+    {
+      FastCdr::Reader reader(this->data(), size(), m_littleEndian);
+      FastCdr::marshal(reader, data);
+      return reader.good();
+    }
+
+    void isLittleEndian(bool little_endian) override
+    {
+      m_littleEndian = little_endian;
+    }
+
+  private:
+    const unsigned char* data() const
+    {
+      return m_extData != nullptr ? m_extData : m_buffer.data();
+    }
+
+    size_t size() const
+    {
+      return m_extData != nullptr ? m_extLength : m_buffer.size();
+    }
+
+    // copies the attached data into the own buffer
+    void materialize()
+    {
+      if (m_extData == nullptr) { return; }
+      m_buffer.reserve(m_extLength);
+      memcpy(m_buffer.data(), m_extData, m_extLength);
+      m_buffer.setSize(m_extLength);
+      m_extData = nullptr;
+      m_extLength = 0;
+    }
+
+    FastCdr::Buffer m_buffer;
+    const unsigned char* m_extData;
+    size_t m_extLength;
+    bool m_littleEndian;
+  };
+} // namespace RTC
+
+/*!
+ * @if jp
+ * @brief fast_cdr シリアライザの初期化関数
+ * @else
+ * @brief Initialization function of the fast_cdr serializer
+ * @endif
+ */
+template <class DataType>
+void FastCdrSerializerInit()
+{
+  coil::GlobalFactory < ::RTC::ByteDataStream<DataType> > ::
+    instance().addFactory("fast_cdr",
+      ::coil::Creator< ::RTC::ByteDataStream<DataType>,
+                       ::RTC::FastCdrSerializer<DataType> >,
+      ::coil::Destructor< ::RTC::ByteDataStream<DataType>,
+                          ::RTC::FastCdrSerializer<DataType> > );
+}
+
+#endif  // RTC_FASTCDRSERIALIZER_H
@@ -21,6 +21,8 @@
 #define RTC_INPORT_H
 
 #include <coil/OS.h>
+#include <algorithm>
+#include <limits>
 #include <mutex>
 
 #include <rtm/RTC.h>
@@ -32,6 +34,7 @@
 #include <rtm/Timestamp.h>
 #include <rtm/DirectInPortBase.h>
 #include <rtm/CORBA_CdrMemoryStream.h>
+#include <rtm/FastCdrSerializer.h>
 
 
 
@@ -125,6 +128,7 @@ namespace RTC
 	  m_directport = this;
 
       CdrMemoryStreamInit<DataType>();
+      FastCdrSerializerInit<DataType>();
 
       std::string serializer_types = coil::flatten(coil::GlobalFactory < ByteDataStream<DataType> >::instance().getIdentifiers());
       coil::eraseBlank(serializer_types);
@@ -419,9 +423,12 @@ namespace RTC
 
     void write(DataType& data) override
     {
-      std::lock_guard<std::mutex> guard(m_valueMutex);
-      m_value = data;
-      m_directNewData = true;
+      {
+        std::lock_guard<std::mutex> guard(m_valueMutex);
+        m_value = data;
+        m_directNewData = true;
+      }
+      m_notifier.notify();
     }
 
     /*!
@@ -508,98 +515,220 @@ namespace RTC
           RTC_TRACE(("OnRead called"));
         }
       // 1) direct connection
-      {
-        std::lock_guard<std::mutex> guard(m_valueMutex);
-        if (m_directNewData == true)
-          {
-            RTC_DEBUG(("Direct data transfer"));
-            if (m_OnReadConvert != nullptr)
-              {
-                m_value = (*m_OnReadConvert)(m_value);
-                RTC_DEBUG(("OnReadConvert for direct data called"));
-                return true;
-              }
-            m_directNewData = false;
-            return true;
-          }
-      }
+      if (readDirect()) { return true; }
+
       // 2) network connection
-      
       DataPortStatus ret;
+      bool direct(false);
       {
+        // held until the read, so that the connector is not deleted
         std::lock_guard<std::mutex> guard(m_connectorsMutex);
         if (m_connectors.empty())
           {
             RTC_DEBUG(("no connectors"));
             return false;
           }
+        InPortConnector* connector(nullptr);
+        if (name.empty())
+          {
+            connector = m_connectors[0];
+          }
+        else
+          {
+            for (auto & con : m_connectors)
+              {
+                if (name == con->name())
+                  {
+                    connector = con;
+                    break;
+                  }
+              }
+          }
 
-        
+        if (connector == nullptr)
+        {
+            RTC_ERROR(("can not find %s",name.c_str()));
+            return false;
+        }
+        ret = readConnectorLocked(connector, direct);
       }
+      return direct || readResult(ret);
+    }
 
-      InPortConnector* connector = nullptr;
+    /*!
+     * @if jp
+     *
+     * @brief 指定したコネクタから値を読み出す
+     *
+     * read(std::string) と同様に、指定したコネクタのデータをバインドさ
+     * れた変数に読み込む。コネクタは getConnectorByName() や
+     * connectors() であらかじめ取得しておいたものを指定する。読み出し
+     * ごとにコネクタ名を比較しないため、周期的に特定のコネクタから読み
+     * 出す場合に使用する。切断されたコネクタを指定した場合は false を返
+     * す。
+     *
+     * @param connector 読み出すコネクタ
+     *
+     * @return 読み出し処理結果(読み出し成功:true、読み出し失敗:false)
+     *
+     * @else
+     *
+     * @brief Read data from the given connector
+     *
+     * This reads the data of the given connector into the bound
+     * variable in the same way as read(std::string). The connector is
+     * obtained beforehand by getConnectorByName() or connectors().
+     * Use this to read from a specific connector periodically, since
+     * no connector names are compared on each read. False is returned
+     * if the connector has been disconnected.
+     *
+     * @param connector The connector to read from
+     *
+     * @return Readout result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool read(InPortConnector* connector)
+    {
+      RTC_TRACE(("DataType read(InPortConnector*)"));
 
-      if (name.empty())
-      {
-          connector = m_connectors[0];
-      }
-      else
+      if (m_OnRead != nullptr)
+        {
+          (*m_OnRead)();
+          RTC_TRACE(("OnRead called"));
+        }
+      if (readDirect()) { return true; }
+
+      DataPortStatus ret;
+      bool direct(false);
       {
-          for(auto & con : m_connectors)
+        // held until the read, so that the connector is not deleted
+        std::lock_guard<std::mutex> guard(m_connectorsMutex);
+        if (std::find(m_connectors.begin(), m_connectors.end(), connector)
+            == m_connectors.end())
           {
-              if (std::string(con->name()) == name)
-              {
-                  connector = con;
-              }
+            RTC_ERROR(("the connector is not connected"));
+            return false;
           }
+        ret = readConnectorLocked(connector, direct);
       }
+      return direct || readResult(ret);
+    }
+
+    /*!
+     * @if jp
+     *
+     * @brief 全てのコネクタから読み出せるデータをまとめて読み出す
+     *
+     * 各コネクタから一つずつ順番に、待たずに読み出せるデータを最大
+     * max 個まで data に読み出す。push 型のコネクタは呼び出し時点でバ
+     * ッファにある未読データを、pull 型のコネクタは一つのデータを読み
+     * 出す。コネクタのロックは一回の呼び出しにつき一度で済み、シリア
+     * ライザは各コネクタが再利用する。
+     *
+     * data の要素は上書きして再利用し、読み出したデータ数に合わせて大
+     * きさを変える。OnRead は最初に一度、OnReadConvert は各データに対
+     * して呼ばれる。バインドされた変数は変更しない。
+     *
+     * @param data 読み出したデータを格納するベクタ
+     * @param max 読み出す最大数。0 の場合は制限しない
+     *
+     * @return 読み出したデータ数
+     *
+     * @else
+     *
+     * @brief Read the data readable from all connectors at once
+     *
+     * This reads up to max data, which can be read without waiting,
+     * into data taking one from each connector in turn. Push type
+     * connectors give the unread data in their buffer at the time of
+     * the call, and pull type connectors give one data. The connectors
+     * are locked only once per call, and each connector reuses its
+     * serializer.
+     *
+     * The elements of data are overwritten and reused, and data is
+     * resized to the number of data read. OnRead is called once at
+     * first and OnReadConvert is called for each data. The bound
+     * variable is not changed.
+     *
+     * @param data The vector to store the data
+     * @param max The maximum number of data to read. 0 means no limit.
+     *
+     * @return The number of data read
+     *
+     * @endif
+     */
+    size_t readAll(std::vector<DataType>& data, size_t max = 0)
+    {
+      RTC_TRACE(("DataType readAll()"));
 
-      if (connector == nullptr)
+      if (m_OnRead != nullptr)
+        {
+          (*m_OnRead)();
+          RTC_TRACE(("OnRead called"));
+        }
+      if (max == 0) { max = (std::numeric_limits<size_t>::max)(); }
+
+      size_t count(0);
+      // 1) direct connection
       {
-          RTC_ERROR(("can not find %s",name.c_str()));
-          return false;
+        std::lock_guard<std::mutex> guard(m_valueMutex);
+        if (m_directNewData && count < max)
+          {
+            if (count == data.size()) { data.emplace_back(); }
+            data[count++] = m_value;
+            m_directNewData = false;
+          }
       }
 
-      if (!connector->getDirectData(m_value))
+      // 2) network connections
       {
+        std::lock_guard<std::mutex> guard(m_connectorsMutex);
+        // the storage is kept for the next call
+        std::vector<Source>& sources(m_sources);
+        sources.clear();
+        for (auto & con : m_connectors)
           {
-              std::lock_guard<std::mutex> guard(m_connectorsMutex);
-              // In single-buffer mode, all connectors share the same buffer. This
-              // means that we only need to read from the first connector to get data
-              // received by any connector.
-              ret = connector->read(m_value);
+            size_t readable(con->readable());
+            if (readable == 0) { continue; }
+            sources.push_back({con, readable});
           }
-          m_status[0] = ret;
-          if (ret == DataPortStatus::PORT_OK)
-          {
-              std::lock_guard<std::mutex> guard(m_valueMutex);
-              RTC_DEBUG(("data read succeeded"));
 
-              if (m_OnReadConvert != nullptr)
+        // one data from each connector in turn
+        bool remaining(!sources.empty());
+        while (remaining && count < max)
+          {
+            remaining = false;
+            for (auto & src : sources)
               {
-                  m_value = (*m_OnReadConvert)(m_value);
-                  RTC_DEBUG(("OnReadConvert called"));
-                  return true;
+                if (src.readable == 0 || count >= max) { continue; }
+                --src.readable;
+                if (count == data.size()) { data.emplace_back(); }
+                if (!src.connector->getDirectData(data[count]) &&
+                    src.connector->read(data[count])
+                    != DataPortStatus::PORT_OK)
+                  {
+                    src.readable = 0;
+                    continue;
+                  }
+                ++count;
+                remaining = remaining || src.readable > 0;
               }
-              return true;
           }
-          else if (ret == DataPortStatus::BUFFER_EMPTY)
-          {
-              RTC_WARN(("buffer empty"));
-              return false;
-          }
-          else if (ret == DataPortStatus::BUFFER_TIMEOUT)
-          {
-              RTC_WARN(("buffer read timeout"));
-              return false;
-          }
-      }
-      else
-      {
-          return true;
+        sources.clear();
       }
-      RTC_ERROR(("unknown retern value from buffer.read()"));
-      return false;
+      data.resize(count);
+
+      if (m_OnReadConvert != nullptr)
+        {
+          for (auto & value : data)
+            {
+              value = (*m_OnReadConvert)(value);
+            }
+          RTC_DEBUG(("OnReadConvert called"));
+        }
+      RTC_DEBUG(("%d data read", count));
+      return count;
     }
 
 
@@ -783,6 +912,131 @@ namespace RTC
     }
 
   private:
+    /*!
+     * @if jp
+     * @brief ダイレクト接続で書き込まれたデータを読み出す
+     * @return 未読のデータがあった場合 true
+     * @else
+     * @brief Read the data written by the direct connection
+     * @return true if there was unread data
+     * @endif
+     */
+    bool readDirect()
+    {
+      std::lock_guard<std::mutex> guard(m_valueMutex);
+      if (m_directNewData == true)
+        {
+          RTC_DEBUG(("Direct data transfer"));
+          if (m_OnReadConvert != nullptr)
+            {
+              m_value = (*m_OnReadConvert)(m_value);
+              RTC_DEBUG(("OnReadConvert for direct data called"));
+              return true;
+            }
+          m_directNewData = false;
+          return true;
+        }
+      return false;
+    }
+
+    /*!
+     * @if jp
+     * @brief コネクタからバインドされた変数にデータを読み出す
+     *
+     * 呼び出し側は m_connectorsMutex をロックしていなければならない。
+     * 読み出し中にコネクタが切断、削除されないようにするため、コネク
+     * タの検索から読み出しまでロックを保持する。
+     *
+     * @param connector 読み出すコネクタ
+     * @param direct ダイレクト接続のデータを読み出した場合 true
+     * @return コネクタの読み出し結果
+     * @else
+     * @brief Read data from the connector into the bound variable
+     *
+     * The caller must hold m_connectorsMutex. The lock is held from
+     * looking up the connector until it has been read, so that the
+     * connector is not disconnected and deleted while it is read.
+     *
+     * @param connector The connector to read from
+     * @param direct true if the data of a direct connection was read
+     * @return The result of reading the connector
+     * @endif
+     */
+    DataPortStatus readConnectorLocked(InPortConnector* connector,
+                                       bool& direct)
+    {
+      direct = connector->getDirectData(m_value);
+      if (direct)
+      {
+          return DataPortStatus::PORT_OK;
+      }
+      // In single-buffer mode, all connectors share the same buffer. This
+      // means that we only need to read from the first connector to get data
+      // received by any connector.
+      return connector->read(m_value);
+    }
+
+    /*!
+     * @if jp
+     * @brief コネクタの読み出し結果を処理する
+     *
+     * m_connectorsMutex を解放してから呼び出す。OnReadConvert を呼び出す。
+     *
+     * @param ret readConnectorLocked() の戻り値
+     * @return 読み出し処理結果(読み出し成功:true、読み出し失敗:false)
+     * @else
+     * @brief Handle the result of reading a connector
+     *
+     * This is called after m_connectorsMutex is released. It calls
+     * OnReadConvert.
+     *
+     * @param ret The return value of readConnectorLocked()
+     * @return Readout result (Successful:true, Failed:false)
+     * @endif
+     */
+    bool readResult(DataPortStatus ret)
+    {
+      m_status[0] = ret;
+      if (ret == DataPortStatus::PORT_OK)
+      {
+          std::lock_guard<std::mutex> guard(m_valueMutex);
+          RTC_DEBUG(("data read succeeded"));
+
+          if (m_OnReadConvert != nullptr)
+          {
+              m_value = (*m_OnReadConvert)(m_value);
+              RTC_DEBUG(("OnReadConvert called"));
+              return true;
+          }
+          return true;
+      }
+      else if (ret == DataPortStatus::BUFFER_EMPTY)
+      {
+          RTC_WARN(("buffer empty"));
+          return false;
+      }
+      else if (ret == DataPortStatus::BUFFER_TIMEOUT)
+      {
+          RTC_WARN(("buffer read timeout"));
+          return false;
+      }
+      RTC_ERROR(("unknown retern value from buffer.read()"));
+      return false;
+    }
+
+    /*!
+     * @if jp
+     * @brief readAll() で読み出し中のコネクタ
+     * @else
+     * @brief A connector being read by readAll()
+     * @endif
+     */
+    struct Source
+    {
+      InPortConnector* connector;
+      size_t readable;
+    };
+
     std::string m_typename;
     /*!
      * @if jp
@@ -838,6 +1092,23 @@ namespace RTC
      * @endif
      */
     bool m_directNewData;
+
+    /*!
+     * @if jp
+     * @brief readAll() で読み出すコネクタ
+     *
+     * 呼び出しごとに確保し直さないよう保持する。m_connectorsMutex で
+     * 保護される。
+     *
+     * @else
+     * @brief The connectors read by readAll()
+     *
+     * This is kept so that it is not reallocated on each call. It is
+     * guarded by m_connectorsMutex.
+     *
+     * @endif
+     */
+    std::vector<Source> m_sources;
   };
 } // namespace RTC
 
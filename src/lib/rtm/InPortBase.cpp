@@ -27,6 +27,7 @@
 #include <rtm/InPortPullConnector.h>
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <string>
 
@@ -166,6 +167,133 @@ namespace RTC
     return m_connectors;
   }
 
+  namespace
+  {
+    // refers to the data given by a connector without copying
+    class SerializedData : public ByteDataStreamBase
+    {
+    public:
+      SerializedData() : m_data(nullptr), m_length(0) {}
+      void writeData(const unsigned char* buffer,
+                     unsigned long length) override
+      {
+        m_copy.writeData(buffer, length);
+        m_data = m_copy.getBuffer();
+        m_length = length;
+      }
+      void attachData(const unsigned char* buffer,
+                      unsigned long length) override
+      {
+        m_data = buffer;
+        m_length = length;
+      }
+      void readData(unsigned char* buffer,
+                    unsigned long length) const override
+      {
+        memcpy(buffer, m_data, length);
+      }
+      unsigned long getDataLength() const override
+      {
+        return m_length;
+      }
+      const unsigned char* data() const
+      {
+        return m_data;
+      }
+    private:
+      ByteData m_copy;
+      const unsigned char* m_data;
+      unsigned long m_length;
+    };
+  } // namespace
+
+  /*!
+   * @if jp
+   * @brief シリアライズされたままのデータを読み出す
+   * @else
+   * @brief Read the data still serialized
+   * @endif
+   */
+  size_t InPortBase::readSerialized(
+    const std::function<void(InPortConnector&, const unsigned char*,
+                             unsigned long)>& func)
+  {
+    RTC_TRACE(("readSerialized()"));
+    std::lock_guard<std::mutex> guard(m_connectorsMutex);
+    size_t count(0);
+    SerializedData data;
+    for (auto & connector : m_connectors)
+      {
+        for (size_t n(connector->readable()); n > 0; --n)
+          {
+            if (connector->read(&data) != DataPortStatus::PORT_OK)
+              {
+                break;
+              }
+            func(*connector, data.data(), data.getDataLength());
+            ++count;
+          }
+      }
+    return count;
+  }
+
+  /*!
+   * @if jp
+   * @brief 未読データがあるか確認する
+   * @else
+   * @brief Check whether there is unread data
+   * @endif
+   */
+  bool InPortBase::isNew()
+  {
+    std::lock_guard<std::mutex> guard(m_connectorsMutex);
+    for (auto & connector : m_connectors)
+      {
+        if (connector->readable() > 0) { return true; }
+      }
+    return false;
+  }
+
+  /*!
+   * @if jp
+   * @brief データが到着するまで待つ
+   * @else
+   * @brief Wait until data arrives
+   * @endif
+   */
+  bool InPortBase::waitForData(std::chrono::nanoseconds timeout)
+  {
+    RTC_TRACE(("waitForData()"));
+    using Clock = std::chrono::steady_clock;
+    const bool forever(timeout == std::chrono::nanoseconds::max());
+    const Clock::time_point start(Clock::now());
+    for (;;)
+      {
+        // data written after this point changes the count
+        unsigned long long count(m_notifier.count());
+        if (isNew()) { return true; }
+        std::chrono::nanoseconds remain(timeout);
+        if (!forever)
+          {
+            remain = timeout - (Clock::now() - start);
+            if (remain.count() <= 0) { return false; }
+          }
+        if (!m_notifier.wait(count, remain)) { return isNew(); }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief データ到着の通知オブジェクトを取得する
+   * @else
+   * @brief Get the notifier of data arrival
+   * @endif
+   */
+  EventNotifier& InPortBase::getEventNotifier()
+  {
+    return m_notifier;
+  }
+
   /*!
    * @if jp
    * @brief ConnectorProfile を取得
@@ -485,6 +613,12 @@ namespace RTC
         return returnvalue;
       }
 
+    // codecs available on this side
+    CORBA_SeqUtil::
+      push_back(cprof.properties,
+                NVUtil::newNV("dataport.codec.inport_supported",
+                              ConnectorCodecChain::supported().c_str()));
+
     // prop: [port.outport].
     coil::Properties prop(m_properties);
     {
@@ -502,6 +636,8 @@ namespace RTC
     RTC_DEBUG(("ConnectorProfile::properties are as follows."));
     RTC_DEBUG_STR((prop));
 
+    selectCodecs(cprof, prop);
+
     /*
      * ここで, ConnectorProfile からの properties がマージされたため、
      * prop["dataflow_type"]: データフロータイプ
@@ -583,6 +719,13 @@ namespace RTC
       }
     RTC_TRACE(("endian: %s", littleEndian ? "little" : "big"));
 
+    // the codecs recorded by selectCodecs(), or none if the peer does
+    // not support codecs
+    prop["codec_type"] =
+      ConnectorCodecChain::negotiate(prop["codec_type"],
+                                     prop["codec.outport_supported"]);
+    RTC_DEBUG(("codec_type: %s", prop["codec_type"].c_str()));
+
     /*
      * ここで, ConnectorProfile からの properties がマージされたため、
      * prop["dataflow_type"]: データフロータイプ
@@ -605,6 +748,7 @@ namespace RTC
             return RTC::RTC_ERROR;
           }
         conn->setEndian(littleEndian);
+        conn->setCodecs(prop);
 
         RTC_DEBUG(("subscribeInterfaces() successfully finished."));
         return RTC::RTC_OK;
@@ -626,6 +770,7 @@ namespace RTC
           {
             return RTC::RTC_ERROR;
           }
+        connector->setEndian(littleEndian);
 
         RTC_DEBUG(("subscribeInterfaces() successfully finished."));
         return RTC::RTC_OK;
@@ -815,6 +960,43 @@ namespace RTC
     return false;
   }
 
+  /*!
+   * @if jp
+   * @brief 接続で使用するコーデックを決定する
+   * @else
+   * @brief Select the codecs used by the connection
+   * @endif
+   */
+  void InPortBase::selectCodecs(ConnectorProfile& cprof,
+                                coil::Properties& prop)
+  {
+    std::string codec_type(prop["codec_type"]);
+    bool agreed(prop.findNode("codec.outport_supported") != nullptr);
+    if (agreed)
+      {
+        codec_type = ConnectorCodecChain::
+          negotiate(codec_type, prop["codec.outport_supported"]);
+      }
+    CORBA::Long index(NVUtil::find_index(cprof.properties,
+                                         "dataport.codec_type"));
+    if (index < 0)
+      {
+        CORBA_SeqUtil::push_back(cprof.properties,
+          NVUtil::newNV("dataport.codec_type", codec_type.c_str()));
+      }
+    else
+      {
+        cprof.properties[index].value <<= codec_type.c_str();
+      }
+    RTC_DEBUG(("codec_type: %s (%s)", codec_type.c_str(),
+               agreed ? "agreed" : "requested"));
+
+    // set again in subscribeInterfaces() once the peer has published
+    prop["codec_type"] = agreed ? codec_type :
+      ConnectorCodecChain::negotiate(codec_type,
+                                     ConnectorCodecChain::supported());
+  }
+
 
 
   /*!
@@ -962,6 +1144,7 @@ namespace RTC
             return nullptr;
           }
         RTC_TRACE(("InPortPushConnector created"));
+        connector->setEventNotifier(&m_notifier);
 
         m_connectors.push_back(connector);
         RTC_PARANOID(("connector push backed: %d", m_connectors.size()));
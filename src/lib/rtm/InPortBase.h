@@ -25,6 +25,10 @@
 #include <rtm/CdrBufferBase.h>
 #include <rtm/ConnectorListener.h>
 #include <rtm/OutPortBase.h>
+#include <rtm/EventNotifier.h>
+
+#include <chrono>
+#include <functional>
 
 /*!
  * @if jp
@@ -178,6 +182,109 @@ namespace RTC
      */
     const std::vector<InPortConnector*>& connectors();
 
+    /*!
+     * @if jp
+     * @brief シリアライズされたままのデータを読み出す
+     *
+     * 各コネクタから待たずに読み出せるデータを、復号化せずに一つずつ
+     * func に渡す。バッファのポインタは func の呼び出し中のみ有効であ
+     * る。データは通常の読み出しと同様にバッファから取り除かれ、リスナ
+     * も呼び出される。ダイレクト接続のデータは対象としない。
+     *
+     * @param func コネクタとデータのバッファ、長さを受け取る関数
+     *
+     * @return 読み出したデータ数
+     *
+     * @else
+     * @brief Read the data still serialized
+     *
+     * This passes the data readable from each connector without
+     * waiting to func one by one without deserializing it. The buffer
+     * pointer is valid only during the call of func. The data is
+     * removed from the buffer and the listeners are called as with a
+     * normal read. Data of direct connections is not included.
+     *
+     * @param func The function receiving the connector, the buffer and
+     *             the length of the data
+     *
+     * @return The number of data read
+     *
+     * @endif
+     */
+    size_t readSerialized(
+      const std::function<void(InPortConnector&, const unsigned char*,
+                               unsigned long)>& func);
+
+    /*!
+     * @if jp
+     * @brief 未読データがあるか確認する
+     *
+     * いずれかのコネクタから待たずに読み出せるデータがある場合 true を
+     * 返す。InPort はダイレクト接続のデータも含めて判定する。
+     *
+     * @return 未読データがある場合 true
+     *
+     * @else
+     * @brief Check whether there is unread data
+     *
+     * This returns true if data is readable from any connector without
+     * waiting. InPort also takes the data of direct connections into
+     * account.
+     *
+     * @return true if there is unread data
+     *
+     * @endif
+     */
+    virtual bool isNew();
+
+    /*!
+     * @if jp
+     * @brief データが到着するまで待つ
+     *
+     * 未読データがあればすぐに戻る。なければコネクタのバッファへの書き
+     * 込みまたはダイレクト接続の書き込みがあるまでスレッドを停止する。
+     *
+     * @param timeout タイムアウト時間。nanoseconds::max() の場合は無期
+     *                限に待つ。
+     *
+     * @return 未読データがある場合 true、タイムアウトした場合 false
+     *
+     * @else
+     * @brief Wait until data arrives
+     *
+     * This returns at once if there is unread data. Otherwise it blocks
+     * the thread until a connector writes to its buffer or data is
+     * written through a direct connection.
+     *
+     * @param timeout The timeout. nanoseconds::max() waits forever.
+     *
+     * @return true if there is unread data, false on timeout
+     *
+     * @endif
+     */
+    bool waitForData(std::chrono::nanoseconds timeout);
+
+    /*!
+     * @if jp
+     * @brief データ到着の通知オブジェクトを取得する
+     *
+     * WaitSet への登録や、getFileDescriptor() で得られる eventfd を外部
+     * の epoll ループに組み込むために使用する。
+     *
+     * @return EventNotifier
+     *
+     * @else
+     * @brief Get the notifier of data arrival
+     *
+     * This is used to attach the port to a WaitSet, or to add the
+     * eventfd given by getFileDescriptor() to an external epoll loop.
+     *
+     * @return The EventNotifier
+     *
+     * @endif
+     */
+    EventNotifier& getEventNotifier();
+
     /*!
      * @if jp
      * @brief ConnectorProfile を取得
@@ -755,6 +862,45 @@ namespace RTC
      */
     bool checkEndian(const coil::Properties& prop, bool& littleEndian);
 
+    /*!
+     * @if jp
+     * @brief 接続で使用するコーデックを決定する
+     *
+     * 最初に publishInterfaces() を行う Port は、要求するコーデック
+     * (codec_type) を ConnectorProfile の dataport.codec_type に記録す
+     * る。2 番目の Port は双方が対応するコーデックの一覧を知っているた
+     * め、合意したコーデックを dataport.codec_type に記録する。
+     * subscribeInterfaces() では両端ともこの記録された値を使用する。
+     *
+     * 接続相手がまだ公開していない場合、この時点で生成するコネクタには
+     * 要求のうちこのプロセスが対応するコーデックを設定し、
+     * subscribeInterfaces() で合意した値に設定し直す。
+     *
+     * @param cprof ConnectorProfile
+     * @param prop 接続プロパティ。codec_type を生成するコネクタに設定す
+     *             る値に書き換える。
+     *
+     * @else
+     * @brief Select the codecs used by the connection
+     *
+     * The port calling publishInterfaces() first records its requested
+     * codecs (codec_type) in dataport.codec_type of the
+     * ConnectorProfile. The second port knows the codecs supported by
+     * both ends, and records the agreed codecs in dataport.codec_type.
+     * Both ends use this recorded value in subscribeInterfaces().
+     *
+     * If the peer has not published yet, a connector created now gets
+     * the requested codecs this process supports, and is set to the
+     * agreed ones in subscribeInterfaces().
+     *
+     * @param cprof ConnectorProfile
+     * @param prop Connection properties. codec_type is replaced with the
+     *             value for the connector created now.
+     *
+     * @endif
+     */
+    void selectCodecs(ConnectorProfile& cprof, coil::Properties& prop);
+
     /*!
      * @if jp
      * @brief InPort provider の生成
@@ -885,6 +1031,15 @@ namespace RTC
      * @endif
      */
     ConnectorListeners m_listeners;
+
+    /*!
+     * @if jp
+     * @brief データ到着の通知オブジェクト
+     * @else
+     * @brief Notifier of data arrival
+     * @endif
+     */
+    EventNotifier m_notifier;
   };
 } // namespace RTC
 
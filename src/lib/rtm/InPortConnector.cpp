@@ -33,8 +33,10 @@ namespace RTC
                                    ConnectorListeners& listeners,
                                    CdrBufferBase* buffer)
     : rtclog("InPortConnector"), m_profile(info),
-	m_listeners(listeners), m_buffer(buffer), m_littleEndian(true), m_outPortListeners(nullptr), m_directOutPort(nullptr), m_marshaling_type("corba")
+	m_listeners(listeners), m_buffer(buffer), m_littleEndian(true), m_outPortListeners(nullptr), m_directOutPort(nullptr), m_marshaling_type("corba"), m_serializer(nullptr),
+    m_deleteSerializer(nullptr), m_notifier(nullptr)
   {
+    m_codecs.init(info.properties);
   }
 
   /*!
@@ -46,6 +48,10 @@ namespace RTC
    */
   InPortConnector::~InPortConnector()
   {
+    if (m_serializer != nullptr)
+      {
+        m_deleteSerializer(m_serializer);
+      }
   }
 
   /*!
@@ -123,6 +129,18 @@ namespace RTC
     return m_buffer;
   }
 
+  /*!
+   * @if jp
+   * @brief 待たずに読み出せるデータ数を取得する
+   * @else
+   * @brief Get the number of data readable without waiting
+   * @endif
+   */
+  size_t InPortConnector::readable()
+  {
+    return m_buffer != nullptr ? m_buffer->readable() : 0;
+  }
+
   /*!
    * @if jp
    * @brief endianタイプ設定
@@ -140,6 +158,58 @@ namespace RTC
   {
     RTC_TRACE(("setEndian() = %s", endian_type ? "little":"big"));
     m_littleEndian = endian_type;
+    // listeners decode data with this property
+    m_profile.properties["serializer.cdr.endian"] =
+      endian_type ? "little" : "big";
+  }
+
+  /*!
+   * @if jp
+   * @brief データ到着の通知先を設定する
+   * @else
+   * @brief Set the notifier of data arrival
+   * @endif
+   */
+  void InPortConnector::setEventNotifier(EventNotifier* notifier)
+  {
+    m_notifier = notifier;
+  }
+
+  /*!
+   * @if jp
+   * @brief コーデック設定
+   * @else
+   * @brief Setting codecs
+   * @endif
+   */
+  void InPortConnector::setCodecs(const coil::Properties& prop)
+  {
+    RTC_TRACE(("setCodecs(%s)", prop["codec_type"].c_str()));
+    m_codecs.init(prop);
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信データを復号する
+   * @else
+   * @brief Decode received data
+   * @endif
+   */
+  bool InPortConnector::decode(ByteData& cdr)
+  {
+    return m_codecs.empty() || m_codecs.decode(cdr);
+  }
+
+  /*!
+   * @if jp
+   * @brief コネクタの統計情報を取得する
+   * @else
+   * @brief Get statistics of the connector
+   * @endif
+   */
+  void InPortConnector::getStatistics(coil::Properties& stat)
+  {
+    m_codecs.getStatistics(stat);
   }
 
   /*!
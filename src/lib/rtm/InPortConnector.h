@@ -25,6 +25,8 @@
 #include <rtm/DirectOutPortBase.h>
 #include <rtm/PortBase.h>
 #include <rtm/ByteData.h>
+#include <rtm/ConnectorCodec.h>
+#include <rtm/EventNotifier.h>
 
 
 namespace RTC
@@ -203,6 +205,8 @@ namespace RTC
      * @if jp
      * @brief データ型の変換テンプレート
      *
+     * シリアライザは最初の読み出しで生成し、以後はコネクタが破棄される
+     * まで再利用する。1つのコネクタからは同じデータ型のみを読み出すこと。
      *
      * @param data データを格納する変数
      *
@@ -211,6 +215,9 @@ namespace RTC
      * @else
      * @brief 
      *
+     * The serializer is created on the first read and reused until the
+     * connector is destroyed, so a connector must always be read into
+     * the same data type.
      *
      * @param data
      * @return 
@@ -220,24 +227,98 @@ namespace RTC
     template<class DataType>
     DataPortStatus read(DataType& data)
     {
-        ::RTC::ByteDataStream<DataType> *cdr = coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().createObject(m_marshaling_type);
-
-        
-        if (!cdr)
+        // createObject() allocates the factory's bookkeeping, so it is
+        // called only once per connector
+        if (m_serializer == nullptr)
         {
-            RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
-            return DataPortStatus::PORT_ERROR;
+            ::RTC::ByteDataStream<DataType> *obj = coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().createObject(m_marshaling_type);
+            if (!obj)
+            {
+                RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
+                return DataPortStatus::PORT_ERROR;
+            }
+            m_serializer = obj;
+            m_deleteSerializer = [](ByteDataStreamBase* base)
+              {
+                ::RTC::ByteDataStream<DataType> *cdr = static_cast< ::RTC::ByteDataStream<DataType>* >(base);
+                coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().deleteObject(cdr);
+              };
         }
-        DataPortStatus ret = read((ByteDataStreamBase*)cdr);
+        return read(data, *static_cast< ::RTC::ByteDataStream<DataType>* >(m_serializer));
+    }
+
+    /*!
+     * @if jp
+     * @brief 与えられたシリアライザでデータを読み出す
+     *
+     * 複数のデータを続けて読み出す場合に、シリアライザの生成を一度で済
+     * ませるために使用する。シリアライザは marshalingType() の種類で生
+     * 成したものでなければならない。
+     *
+     * @param data データを格納する変数
+     * @param cdr シリアライザ
+     *
+     * @return ReturnCode
+     *
+     * @else
+     * @brief Read data with the given serializer
+     *
+     * This is used to create the serializer only once when several
+     * data are read in a row. The serializer must be created with the
+     * type of marshalingType().
+     *
+     * @param data The variable to store the data
+     * @param cdr The serializer
+     *
+     * @return ReturnCode
+     *
+     * @endif
+     */
+    template<class DataType>
+    DataPortStatus read(DataType& data, ::RTC::ByteDataStream<DataType>& cdr)
+    {
+        DataPortStatus ret = read(static_cast<ByteDataStreamBase*>(&cdr));
         if (ret == DataPortStatus::PORT_OK)
         {
-            cdr->isLittleEndian(isLittleEndian());
-            cdr->deserialize(data);
+            cdr.isLittleEndian(isLittleEndian());
+            cdr.deserialize(data);
         }
-        coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().deleteObject(cdr);
         return ret;
     }
 
+    /*!
+     * @if jp
+     * @brief 待たずに読み出せるデータ数を取得する
+     *
+     * push 型ではバッファ内の未読データ数を返す。
+     *
+     * @return 読み出せるデータ数
+     *
+     * @else
+     * @brief Get the number of data readable without waiting
+     *
+     * The push type returns the number of unread data in the buffer.
+     *
+     * @return The number of readable data
+     *
+     * @endif
+     */
+    virtual size_t readable();
+
+    /*!
+     * @if jp
+     * @brief シリアライザの種類を取得する
+     * @return シリアライザの種類
+     * @else
+     * @brief Get the marshaling type
+     * @return The marshaling type
+     * @endif
+     */
+    const std::string& marshalingType() const
+    {
+        return m_marshaling_type;
+    }
+
     /*!
      * @if jp
      * @brief endianタイプ設定
@@ -257,6 +338,93 @@ namespace RTC
      */
     virtual void setEndian(bool endian_type);
 
+    /*!
+     * @if jp
+     * @brief データ到着の通知先を設定する
+     *
+     * バッファにデータを書き込んだときに通知する。
+     *
+     * @param notifier 通知先
+     *
+     * @else
+     * @brief Set the notifier of data arrival
+     *
+     * The notifier is notified when data is written to the buffer.
+     *
+     * @param notifier The notifier
+     *
+     * @endif
+     */
+    void setEventNotifier(EventNotifier* notifier);
+
+    /*!
+     * @if jp
+     * @brief コーデック設定
+     *
+     * 接続相手とのネゴシエーションで決定した codec_type に従ってコーデッ
+     * クを設定する。
+     *
+     * @param prop コネクタプロファイルのプロパティ
+     *
+     * @else
+     * @brief Setting codecs
+     *
+     * This operation sets the codecs according to codec_type decided by
+     * negotiation with the peer.
+     *
+     * @param prop Connector properties
+     *
+     * @endif
+     */
+    void setCodecs(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 受信データを復号する
+     *
+     * 設定されたコーデックで受信データをその場で復号する。プロバイダは
+     * ON_RECEIVED リスナを呼ぶ前にこの関数を呼び、リスナやバッファには
+     * 復号済みのデータのみが渡るようにする。コーデックが無い場合は何
+     * もしない。
+     *
+     * @param cdr 受信データ
+     * @return true: 復号済み, false: 次のキーフレームまで復号できない
+     *
+     * @else
+     * @brief Decode received data
+     *
+     * This operation decodes the received data in place with the codecs
+     * set. Providers call it before the ON_RECEIVED listeners so that
+     * listeners and the buffer only see decoded data. Without codecs it
+     * does nothing.
+     *
+     * @param cdr Received data
+     * @return true: decoded, false: not decodable until the next keyframe
+     *
+     * @endif
+     */
+    bool decode(ByteData& cdr);
+
+    /*!
+     * @if jp
+     * @brief コネクタの統計情報を取得する
+     *
+     * コーデックなどコネクタ内部の統計情報を引数のプロパティに書き込む。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics of the connector
+     *
+     * This operation writes statistics inside the connector, such as
+     * codecs, into the given properties.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    virtual void getStatistics(coil::Properties& stat);
+
     /*!
      * @if jp
      * @brief endian 設定を返す
@@ -439,6 +607,42 @@ namespace RTC
      */
     std::string m_marshaling_type;
 
+    /*!
+     * @if jp
+     * @brief 受信側コーデック
+     * @else
+     * @brief Receiver side codecs
+     * @endif
+     */
+    ConnectorCodecChain m_codecs;
+
+    /*!
+     * @if jp
+     * @brief read() で再利用するシリアライザ
+     * @else
+     * @brief Serializer reused by read()
+     * @endif
+     */
+    ByteDataStreamBase* m_serializer;
+
+    /*!
+     * @if jp
+     * @brief m_serializer を生成したファクトリで破棄する関数
+     * @else
+     * @brief Function to delete m_serializer with its factory
+     * @endif
+     */
+    void (*m_deleteSerializer)(ByteDataStreamBase*);
+
+    /*!
+     * @if jp
+     * @brief データ到着の通知先
+     * @else
+     * @brief Notifier of data arrival
+     * @endif
+     */
+    EventNotifier* m_notifier;
+
   };
 } // namespace RTC
 
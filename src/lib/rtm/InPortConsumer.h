@@ -145,6 +145,52 @@ namespace RTC
      */
 	virtual DataPortStatus put(ByteData& data) = 0;
 
+    /*!
+     * @if jp
+     * @brief 接続先が受け付け可能なデータ数を取得する
+     *
+     * 接続先の InPort が最後に通知した、現在受け付け可能なデータ数(クレ
+     * ジット)を返す。接続先がクレジットを通知しない場合は -1 を返す。
+     * この関数は通信を行わない。
+     *
+     * @return クレジット数、不明な場合は -1
+     *
+     * @else
+     * @brief Get the number of samples the destination can accept
+     *
+     * This operation returns the number of samples (credit) that the
+     * destination InPort advertised it can accept. If the destination
+     * does not advertise credit, -1 is returned. This operation never
+     * communicates with the destination.
+     *
+     * @return Credit, or -1 if unknown
+     *
+     * @endif
+     */
+    virtual long int getCredit() { return -1; }
+
+    /*!
+     * @if jp
+     * @brief 接続先にクレジットを問い合わせる
+     *
+     * 接続先の InPort に現在のクレジットを問い合わせ、保持している値を
+     * 更新する。接続先がクレジットを通知しない場合は -1 を返す。
+     *
+     * @return 更新後のクレジット数、不明な場合は -1
+     *
+     * @else
+     * @brief Query the destination for its current credit
+     *
+     * This operation queries the destination InPort for its current
+     * credit and updates the stored value. If the destination does not
+     * advertise credit, -1 is returned.
+     *
+     * @return Updated credit, or -1 if unknown
+     *
+     * @endif
+     */
+    virtual long int refreshCredit() { return -1; }
+
     /*!
      * @if jp
      * @brief InterfaceProfile情報を公開する
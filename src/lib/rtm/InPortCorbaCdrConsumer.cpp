@@ -88,6 +88,14 @@ namespace RTC
       {
         // return code conversion
         // (IDL)OpenRTM::DataPort::ReturnCode_t -> DataPortStatus
+        if (!CORBA::is_nil(m_flowControl.in()))
+          {
+            CORBA::ULong credit(0);
+            OpenRTM::PortStatus ret(m_flowControl->put_with_credit(tmp,
+                                                                   credit));
+            m_credit.store(static_cast<long int>(credit));
+            return convertReturnCode(ret);
+          }
         return convertReturnCode(_ptr()->put(tmp));
       }
     catch (...)
@@ -97,6 +105,42 @@ namespace RTC
     return DataPortStatus::UNKNOWN_ERROR;
   }
 
+  /*!
+   * @if jp
+   * @brief 接続先が受け付け可能なデータ数を取得する
+   * @else
+   * @brief Get the number of samples the destination can accept
+   * @endif
+   */
+  long int InPortCorbaCdrConsumer::getCredit()
+  {
+    // read from getStatistics() while the publisher thread updates it
+    return m_credit.load();
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続先にクレジットを問い合わせる
+   * @else
+   * @brief Query the destination for its current credit
+   * @endif
+   */
+  long int InPortCorbaCdrConsumer::refreshCredit()
+  {
+    if (CORBA::is_nil(m_flowControl.in())) { return -1; }
+    long int credit(-1);
+    try
+      {
+        credit = static_cast<long int>(m_flowControl->get_credit());
+      }
+    catch (...)
+      {
+        RTC_WARN(("get_credit() failed."));
+      }
+    m_credit.store(credit);
+    return credit;
+  }
+
   /*!
    * @if jp
    * @brief InterfaceProfile情報を公開する
@@ -124,10 +168,18 @@ namespace RTC
     RTC_DEBUG_STR((NVUtil::toString(properties)));
 
     // getting InPort's ref from IOR string
-    if (subscribeFromIor(properties)) { return true; }
+    if (subscribeFromIor(properties))
+      {
+        setupFlowControl(properties);
+        return true;
+      }
 
     // getting InPort's ref from Object reference
-    if (subscribeFromRef(properties)) { return true; }
+    if (subscribeFromRef(properties))
+      {
+        setupFlowControl(properties);
+        return true;
+      }
 
     return false;
   }
@@ -145,6 +197,8 @@ namespace RTC
     RTC_TRACE(("unsubscribeInterface()"));
     RTC_DEBUG_STR((NVUtil::toString(properties)));
 
+    m_flowControl = ::OpenRTM::InPortCdrFlowControl::_nil();
+    m_credit = -1;
     if (unsubscribeFromIor(properties)) { return; }
     unsubscribeFromRef(properties);
   }
@@ -313,6 +367,30 @@ namespace RTC
     return true;
   }
 
+  /*!
+   * @if jp
+   * @brief クレジット通知を有効にする
+   * @else
+   * @brief Enable credit notification
+   * @endif
+   */
+  void InPortCorbaCdrConsumer::
+  setupFlowControl(const SDOPackage::NVList& properties)
+  {
+    m_flowControl = ::OpenRTM::InPortCdrFlowControl::_nil();
+    m_credit = -1;
+    if (!NVUtil::isStringValue(properties,
+                               "dataport.corba_cdr.flow_control", "credit"))
+      {
+        return;
+      }
+    // The provider advertises credit support in its interface profile,
+    // so the reference can be narrowed without a remote type check.
+    m_flowControl =
+      ::OpenRTM::InPortCdrFlowControl::_unchecked_narrow(_ptr());
+    RTC_DEBUG(("credit based flow control enabled."));
+  }
+
   /*!
    * @if jp
    * @brief リターンコード変換
@@ -27,6 +27,8 @@
 #include <rtm/InPortConsumer.h>
 #include <rtm/Manager.h>
 
+#include <atomic>
+
 namespace RTC
 {
   /*!
@@ -155,6 +157,49 @@ namespace RTC
      */
 	DataPortStatus put(ByteData& data) override;
 
+    /*!
+     * @if jp
+     * @brief 接続先が受け付け可能なデータ数を取得する
+     *
+     * 接続先の InPort が最後に通知したクレジットを返す。接続先が
+     * OpenRTM::InPortCdrFlowControl を提供しない場合は -1 を返す。
+     *
+     * @return クレジット数、不明な場合は -1
+     *
+     * @else
+     * @brief Get the number of samples the destination can accept
+     *
+     * This operation returns the credit last advertised by the
+     * destination InPort. If the destination does not provide
+     * OpenRTM::InPortCdrFlowControl, -1 is returned.
+     *
+     * @return Credit, or -1 if unknown
+     *
+     * @endif
+     */
+    long int getCredit() override;
+
+    /*!
+     * @if jp
+     * @brief 接続先にクレジットを問い合わせる
+     *
+     * OpenRTM::InPortCdrFlowControl::get_credit() を呼び出し、保持して
+     * いるクレジットを更新する。
+     *
+     * @return 更新後のクレジット数、不明な場合は -1
+     *
+     * @else
+     * @brief Query the destination for its current credit
+     *
+     * This operation calls OpenRTM::InPortCdrFlowControl::get_credit()
+     * and updates the stored credit.
+     *
+     * @return Updated credit, or -1 if unknown
+     *
+     * @endif
+     */
+    long int refreshCredit() override;
+
     /*!
      * @if jp
      * @brief InterfaceProfile情報を公開する
@@ -294,8 +339,28 @@ namespace RTC
      */
     DataPortStatus convertReturnCode(OpenRTM::PortStatus ret);
 
+    /*!
+     * @if jp
+     * @brief クレジット通知を有効にする
+     *
+     * 接続プロファイルに dataport.corba_cdr.flow_control = credit が
+     * 含まれる場合、InPortCdrFlowControl 参照を取得する。
+     *
+     * @else
+     * @brief Enable credit notification
+     *
+     * If the connector profile contains
+     * dataport.corba_cdr.flow_control = credit, this operation obtains
+     * the InPortCdrFlowControl reference.
+     *
+     * @endif
+     */
+    void setupFlowControl(const SDOPackage::NVList& properties);
+
     mutable Logger rtclog;
     coil::Properties m_properties;
+    ::OpenRTM::InPortCdrFlowControl_var m_flowControl;
+    std::atomic<long int> m_credit{-1};
   };
 } // namespace RTC
 
@@ -50,6 +50,10 @@ namespace RTC
     CORBA_SeqUtil::
       push_back(m_properties,
                 NVUtil::newNV("dataport.corba_cdr.inport_ref", m_objref));
+    // this provider implements OpenRTM::InPortCdrFlowControl
+    CORBA_SeqUtil::
+      push_back(m_properties,
+                NVUtil::newNV("dataport.corba_cdr.flow_control", "credit"));
   }
 
   /*!
@@ -169,12 +173,60 @@ namespace RTC
     cdr.writeData(const_cast<unsigned char*>(data.get_buffer()), static_cast<CORBA::ULong>(data.length()));
     RTC_PARANOID(("converted CDR data size: %d", cdr.getDataLength()));
 
+    // listeners see the data as the sender wrote it
+    if (!m_connector->decode(cdr))
+      {
+        RTC_PARANOID(("undecodable data discarded."));
+        return ::OpenRTM::PORT_OK;
+      }
     onReceived(cdr);
     BufferStatus ret = m_connector->write(cdr);
 
     return convertReturn(ret, cdr);
   }
 
+  /*!
+   * @if jp
+   * @brief バッファにデータを書き込みクレジットを返す
+   * @else
+   * @brief Write data into the buffer and return credit
+   * @endif
+   */
+  ::OpenRTM::PortStatus
+  InPortCorbaCdrProvider::put_with_credit(const ::OpenRTM::CdrData& data,
+                                          ::CORBA::ULong& credit)
+  {
+    ::OpenRTM::PortStatus ret(put(data));
+    credit = currentCredit();
+    RTC_PARANOID(("credit: %u", credit));
+    return ret;
+  }
+
+  /*!
+   * @if jp
+   * @brief 現在のクレジットを取得する
+   * @else
+   * @brief Get the current credit
+   * @endif
+   */
+  ::CORBA::ULong InPortCorbaCdrProvider::get_credit()
+  {
+    return currentCredit();
+  }
+
+  /*!
+   * @if jp
+   * @brief バッファが受け付け可能なデータ数を取得する
+   * @else
+   * @brief Get the number of samples the buffer can accept
+   * @endif
+   */
+  ::CORBA::ULong InPortCorbaCdrProvider::currentCredit()
+  {
+    if (m_buffer == nullptr) { return 0; }
+    return static_cast< ::CORBA::ULong>(m_buffer->writable());
+  }
+
   /*!
    * @if jp
    * @brief リターンコード変換
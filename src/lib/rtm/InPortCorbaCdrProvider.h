@@ -56,7 +56,7 @@ namespace RTC
    */
   class InPortCorbaCdrProvider
     : public InPortProvider,
-      public virtual POA_OpenRTM::InPortCdr,
+      public virtual POA_OpenRTM::InPortCdrFlowControl,
       public virtual PortableServer::RefCountServantBase
   {
   public:
@@ -242,7 +242,49 @@ namespace RTC
      */
     ::OpenRTM::PortStatus put(const ::OpenRTM::CdrData& data) override;
 
+    /*!
+     * @if jp
+     * @brief [CORBA interface] バッファにデータを書き込みクレジットを返す
+     *
+     * put() と同様にデータをバッファに書き込み、書き込み後にバッファが
+     * 受け付け可能なデータ数(クレジット)を返す。
+     *
+     * @param data 書込対象データ
+     * @param credit 書き込み後のクレジット
+     *
+     * @else
+     * @brief [CORBA interface] Write data into the buffer and return credit
+     *
+     * Write data into the buffer as put() does, and return the number
+     * of samples (credit) the buffer can accept after the write.
+     *
+     * @param data The target data for writing
+     * @param credit Credit after the write
+     *
+     * @endif
+     */
+    ::OpenRTM::PortStatus put_with_credit(const ::OpenRTM::CdrData& data,
+                                          ::CORBA::ULong& credit) override;
+
+    /*!
+     * @if jp
+     * @brief [CORBA interface] 現在のクレジットを取得する
+     * @else
+     * @brief [CORBA interface] Get the current credit
+     * @endif
+     */
+    ::CORBA::ULong get_credit() override;
+
   private:
+    /*!
+     * @if jp
+     * @brief バッファが受け付け可能なデータ数を取得する
+     * @else
+     * @brief Get the number of samples the buffer can accept
+     * @endif
+     */
+    ::CORBA::ULong currentCredit();
+
     /*!
      * @if jp
      * @brief リターンコード変換
@@ -168,7 +168,12 @@ namespace RTC
     cdr.writeData(const_cast<unsigned char*>(data.get_buffer()), static_cast<CORBA::ULong>(data.length()));
     RTC_PARANOID(("converted CDR data size: %d", cdr.getDataLength()));
 
-
+    // listeners see the data as the sender wrote it
+    if (!m_connector->decode(cdr))
+      {
+        RTC_PARANOID(("undecodable data discarded."));
+        return ::RTC::PORT_OK;
+      }
     onReceived(cdr);
     BufferStatus ret = m_connector->write(cdr);
 
@@ -86,12 +86,32 @@ namespace RTC
       {
         return DataPortStatus::PORT_ERROR;
       }
-    ByteData tmp;
-    DataPortStatus ret = m_consumer->get(tmp);
-    data->writeData(tmp.getBuffer(), tmp.getDataLength());
+    DataPortStatus ret = m_consumer->get(m_data);
+    if (ret != DataPortStatus::PORT_OK)
+      {
+        return ret;
+      }
+    if (!m_codecs.empty() && !m_codecs.decode(m_data))
+      {
+        RTC_PARANOID(("undecodable data discarded."));
+        return DataPortStatus::BUFFER_EMPTY;
+      }
+    data->attachData(m_data.getBuffer(), m_data.getDataLength());
     return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief 待たずに読み出せるデータ数を取得する
+   * @else
+   * @brief Get the number of data readable without waiting
+   * @endif
+   */
+  size_t InPortPullConnector::readable()
+  {
+    return m_consumer != nullptr ? 1 : 0;
+  }
+
   /*!
    * @if jp
    * @brief 接続解除関数
@@ -184,6 +184,27 @@ namespace RTC
      */
     DataPortStatus read(ByteDataStreamBase* data) override;
 
+    /*!
+     * @if jp
+     * @brief 待たずに読み出せるデータ数を取得する
+     *
+     * pull 型では読み出しごとに OutPort から最新のデータを一つ取得する
+     * ため、1 を返す。
+     *
+     * @return 読み出せるデータ数
+     *
+     * @else
+     * @brief Get the number of data readable without waiting
+     *
+     * This returns 1 since the pull type fetches the latest data from
+     * the OutPort on each read.
+     *
+     * @return The number of readable data
+     *
+     * @endif
+     */
+    size_t readable() override;
+
     /*!
      * @if jp
      * @brief 接続解除関数
@@ -303,6 +324,22 @@ namespace RTC
      * @endif
      */
     ConnectorListeners& m_listeners;
+
+    /*!
+     * @if jp
+     * @brief 読み出したデータ
+     *
+     * 読み出しごとに再利用し、シリアライザにはコピーせずに渡す。
+     *
+     * @else
+     * @brief The data read
+     *
+     * This is reused for every read and passed to the serializer
+     * without copying.
+     *
+     * @endif
+     */
+    ByteData m_data;
   };
 } // namespace RTC
 
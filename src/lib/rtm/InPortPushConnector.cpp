@@ -122,9 +122,7 @@ namespace RTC
             }
         }
     }
-    ByteData tmp;
-    BufferStatus ret = m_buffer->read(tmp);
-    data->writeData(tmp.getBuffer(), tmp.getDataLength());
+    BufferStatus ret = m_buffer->read(m_data);
 
     if (m_sync_readwrite)
     {
@@ -143,15 +141,17 @@ namespace RTC
     switch (ret)
       {
       case BufferStatus::OK:
-        onBufferRead(tmp);
+        onBufferRead(m_data);
+        // passed after the listeners so that their changes take effect
+        data->attachData(m_data.getBuffer(), m_data.getDataLength());
         return DataPortStatus::PORT_OK;
         break;
       case BufferStatus::EMPTY:
-        onBufferEmpty(tmp);
+        onBufferEmpty(m_data);
         return DataPortStatus::BUFFER_EMPTY;
         break;
       case BufferStatus::TIMEOUT:
-        onBufferReadTimeout(tmp);
+        onBufferReadTimeout(m_data);
         return DataPortStatus::BUFFER_TIMEOUT;
         break;
       case BufferStatus::PRECONDITION_NOT_MET:
@@ -162,6 +162,22 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief endianタイプ設定
+   * @else
+   * @brief Setting an endian type
+   * @endif
+   */
+  void InPortPushConnector::setEndian(bool endian_type)
+  {
+    InPortConnector::setEndian(endian_type);
+    if (m_provider != nullptr)
+      {
+        m_provider->setListener(m_profile, &m_listeners);
+      }
+  }
+
   /*!
    * @if jp
    * @brief 接続解除
@@ -232,6 +248,7 @@ namespace RTC
 
   BufferStatus InPortPushConnector::write(ByteData &cdr)
   {
+      // cdr has been decoded by the provider, see decode()
       if (m_sync_readwrite)
       {
           {
@@ -246,6 +263,10 @@ namespace RTC
       
 
       BufferStatus ret = m_buffer->write(cdr);
+      if (ret == BufferStatus::OK && m_notifier != nullptr)
+      {
+          m_notifier->notify();
+      }
 
       if (m_sync_readwrite)
       {
@@ -199,6 +199,22 @@ namespace RTC
      */
     DataPortStatus disconnect() override;
 
+    /*!
+     * @if jp
+     * @brief endianタイプ設定
+     *
+     * endianタイプを設定し、プロバイダが保持するコネクタ情報にも反映する
+     *
+     * @else
+     * @brief Setting an endian type
+     *
+     * This operation sets this connector's endian type and reflects it
+     * to the connector information held by the provider.
+     *
+     * @endif
+     */
+    void setEndian(bool endian_type) override;
+
     /*!
      * @if jp
      * @brief アクティブ化
@@ -310,6 +326,22 @@ namespace RTC
      */
     ConnectorListeners& m_listeners;
 
+    /*!
+     * @if jp
+     * @brief 読み出したデータ
+     *
+     * 読み出しごとに再利用し、シリアライザにはコピーせずに渡す。
+     *
+     * @else
+     * @brief The data read
+     *
+     * This is reused for every read and passed to the serializer
+     * without copying.
+     *
+     * @endif
+     */
+    ByteData m_data;
+
     bool m_deleteBuffer;
 
     bool m_sync_readwrite;
@@ -139,7 +139,13 @@ namespace RTC
 	{
 
 	}
-	
+
+	// listeners see the data as the sender wrote it
+	if (!m_connector->decode(cdr))
+	{
+		RTC_PARANOID(("undecodable data discarded."));
+		return ::OpenRTM::PORT_OK;
+	}
 	onReceived(cdr);
 	
     BufferStatus ret = m_connector->write(cdr);
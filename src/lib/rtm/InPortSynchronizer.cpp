@@ -0,0 +1,268 @@
+﻿// -*- C++ -*-
+/*!
+ * @file InPortSynchronizer.cpp
+ * @brief Timestamp aligned reading of several InPorts
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/InPortSynchronizer.h>
+#include <rtm/InPortConnector.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+  // tm.sec and tm.nsec are the first two ULongs of the data
+  unsigned long readULong(const unsigned char* buffer, bool little)
+  {
+    if (little)
+      {
+        return static_cast<unsigned long>(buffer[0]) |
+          (static_cast<unsigned long>(buffer[1]) << 8) |
+          (static_cast<unsigned long>(buffer[2]) << 16) |
+          (static_cast<unsigned long>(buffer[3]) << 24);
+      }
+    return static_cast<unsigned long>(buffer[3]) |
+      (static_cast<unsigned long>(buffer[2]) << 8) |
+      (static_cast<unsigned long>(buffer[1]) << 16) |
+      (static_cast<unsigned long>(buffer[0]) << 24);
+  }
+} // namespace
+
+namespace RTC
+{
+  InPortSynchronizer::InPortSynchronizer()
+    : m_policy(EXACT_TIME), m_tolerance(0), m_queueLength(10),
+      m_discarded(0), rtclog("InPortSynchronizer")
+  {
+  }
+
+  InPortSynchronizer::~InPortSynchronizer() = default;
+
+  /*!
+   * @if jp
+   * @brief InPort を登録する
+   * @else
+   * @brief Register an InPort
+   * @endif
+   */
+  size_t InPortSynchronizer::addPort(InPortBase& port)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    Port entry;
+    entry.port = &port;
+    m_ports.push_back(std::move(entry));
+    RTC_DEBUG(("port %s added as %lu.", port.getName(),
+               static_cast<unsigned long>(m_ports.size() - 1)));
+    return m_ports.size() - 1;
+  }
+
+  /*!
+   * @if jp
+   * @brief 一致の判定方法を設定する
+   * @else
+   * @brief Set the matching policy
+   * @endif
+   */
+  void InPortSynchronizer::setPolicy(Policy policy,
+                                     std::chrono::nanoseconds tolerance)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_policy = policy;
+    m_tolerance = policy == APPROXIMATE_TIME ?
+      std::max(static_cast<long long>(tolerance.count()), 0LL) : 0;
+  }
+
+  /*!
+   * @if jp
+   * @brief ポートごとのキュー長を設定する
+   * @else
+   * @brief Set the queue length per port
+   * @endif
+   */
+  void InPortSynchronizer::setQueueLength(size_t length)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_queueLength = std::max(length, static_cast<size_t>(1));
+    for (auto& port : m_ports)
+      {
+        while (port.queue.size() > m_queueLength) { discard(port); }
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 組が揃ったときに呼び出すコールバックを設定する
+   * @else
+   * @brief Set the callback called when a set is complete
+   * @endif
+   */
+  void InPortSynchronizer::setCallback(Callback callback)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_callback = std::move(callback);
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信データを取り込んで組を探す
+   * @else
+   * @brief Take in the received data and look for a set
+   * @endif
+   */
+  bool InPortSynchronizer::sync()
+  {
+    Callback callback;
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_ports.empty()) { return false; }
+      for (auto& port : m_ports)
+        {
+          Port& target(port);
+          port.port->readSerialized(
+            [this, &target](InPortConnector& connector,
+                            const unsigned char* buffer,
+                            unsigned long length)
+            {
+              enqueue(target, connector, buffer, length);
+            });
+        }
+      if (!match()) { return false; }
+      callback = m_callback;
+    }
+    // the callback may call read()
+    if (callback) { callback(*this); }
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 一致せずに破棄したデータ数を取得する
+   * @else
+   * @brief Get the number of data discarded without a match
+   * @endif
+   */
+  unsigned long InPortSynchronizer::discarded() const
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_discarded;
+  }
+
+  /*!
+   * @if jp
+   * @brief シリアライズされたデータをキューに加える
+   * @else
+   * @brief Add serialized data to the queue
+   * @endif
+   */
+  void InPortSynchronizer::enqueue(Port& port, InPortConnector& connector,
+                                   const unsigned char* buffer,
+                                   unsigned long length)
+  {
+    const std::string& marshaling(connector.marshalingType());
+    if (marshaling != "corba" && marshaling != "fast_cdr")
+      {
+        RTC_WARN(("unsupported marshaling type: %s", marshaling.c_str()));
+        return;
+      }
+    if (length < 8)
+      {
+        RTC_WARN(("data too short to have a timestamp: %lu", length));
+        return;
+      }
+    if (port.queue.size() >= m_queueLength) { discard(port); }
+
+    port.queue.emplace_back();
+    Sample& sample(port.queue.back());
+    if (!m_spare.empty())
+      {
+        sample.data.swap(m_spare.back());
+        m_spare.pop_back();
+      }
+    sample.data.assign(buffer, buffer + length);
+    sample.marshaling = marshaling;
+    sample.little = connector.isLittleEndian();
+    sample.stamp =
+      static_cast<long long>(readULong(buffer, sample.little)) * 1000000000LL
+      + static_cast<long long>(readULong(buffer + 4, sample.little));
+  }
+
+  /*!
+   * @if jp
+   * @brief キューの先頭のデータを破棄する
+   * @else
+   * @brief Discard the data at the head of the queue
+   * @endif
+   */
+  void InPortSynchronizer::discard(Port& port)
+  {
+    if (port.queue.empty()) { return; }
+    if (m_spare.size() < m_queueLength * m_ports.size())
+      {
+        m_spare.push_back(std::move(port.queue.front().data));
+      }
+    port.queue.pop_front();
+    ++m_discarded;
+  }
+
+  /*!
+   * @if jp
+   * @brief キューの先頭から一致する組を探す
+   *
+   * 先頭のタイムスタンプの差が許容値を超える間、最も古い先頭を破棄す
+   * る。それより新しいデータとしか組めないため、以後一致することはない。
+   *
+   * @else
+   * @brief Look for a matching set from the queue heads
+   *
+   * While the timestamps of the heads differ by more than the
+   * tolerance, the oldest head is discarded. It could only be matched
+   * with newer data, so it can never match later.
+   *
+   * @endif
+   */
+  bool InPortSynchronizer::match()
+  {
+    for (;;)
+      {
+        Port* oldest(nullptr);
+        long long newest(0);
+        for (auto& port : m_ports)
+          {
+            if (port.queue.empty()) { return false; }
+            long long stamp(port.queue.front().stamp);
+            if (oldest == nullptr || stamp < oldest->queue.front().stamp)
+              {
+                oldest = &port;
+              }
+            newest = std::max(newest, stamp);
+          }
+        if (newest - oldest->queue.front().stamp <= m_tolerance) { break; }
+        discard(*oldest);
+      }
+
+    for (auto& port : m_ports)
+      {
+        std::swap(port.matched, port.queue.front());
+        Sample& spent(port.queue.front());
+        if (!spent.data.empty() &&
+            m_spare.size() < m_queueLength * m_ports.size())
+          {
+            m_spare.push_back(std::move(spent.data));
+          }
+        port.queue.pop_front();
+      }
+    RTC_PARANOID(("set matched at %lld.", m_ports.front().matched.stamp));
+    return true;
+  }
+} // namespace RTC
@@ -0,0 +1,330 @@
+﻿// -*- C++ -*-
+/*!
+ * @file InPortSynchronizer.h
+ * @brief Timestamp aligned reading of several InPorts
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_INPORTSYNCHRONIZER_H
+#define RTC_INPORTSYNCHRONIZER_H
+
+#include <coil/Factory.h>
+#include <rtm/ByteDataStreamBase.h>
+#include <rtm/InPortBase.h>
+#include <rtm/SystemLogger.h>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class InPortSynchronizer
+   * @brief 複数の InPort のデータをタイムスタンプで揃えて読み出すクラス
+   *
+   * 登録した InPort のコネクタから受信データをシリアライズされたまま取
+   * り出してポートごとの有限長キューに格納し、先頭データの tm を比較し
+   * て全ポートのデータが揃った組を探す。EXACT_TIME ではタイムスタンプ
+   * が一致する組を、APPROXIMATE_TIME では最新と最古の差が許容値以内の
+   * 組を一致とみなす。揃わなかったデータは復号化せずに破棄する。
+   *
+   * 一致した組は read() でまとめて、または readAt() でポートごとに復号
+   * 化して取り出す。コールバックを設定した場合、sync() で組が揃ったとき
+   * に呼び出される。
+   *
+   * データ型は tm を先頭に持つ型でなければならず、マーシャリング方式は
+   * CDR 形式 (corba, fast_cdr) のみを対象とする。ダイレクト接続のデー
+   * タと OnReadConvert は扱わない。sync() と read() は同じスレッドから
+   * 呼び出すこと。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class InPortSynchronizer
+   * @brief Class reading the data of several InPorts aligned by timestamp
+   *
+   * This takes the received data still serialized from the connectors
+   * of the registered InPorts into a bounded queue per port, and looks
+   * for a set in which every port has data by comparing tm of the queue
+   * heads. EXACT_TIME matches a set with equal timestamps, and
+   * APPROXIMATE_TIME matches a set whose newest and oldest timestamps
+   * differ by no more than the tolerance. Data which cannot be matched
+   * is discarded without being deserialized.
+   *
+   * The matched set is deserialized at once by read() or per port by
+   * readAt(). If a callback is set, it is called by sync() when a set
+   * is complete.
+   *
+   * The data types must start with tm, and only the CDR marshaling
+   * types (corba, fast_cdr) are supported. The data of direct
+   * connections and OnReadConvert are not handled. sync() and read()
+   * must be called from the same thread.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class InPortSynchronizer
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief 一致の判定方法
+     * @else
+     * @brief Matching policy
+     * @endif
+     */
+    enum Policy
+      {
+        EXACT_TIME,
+        APPROXIMATE_TIME
+      };
+
+    typedef std::function<void(InPortSynchronizer&)> Callback;
+
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     *
+     * 判定方法は EXACT_TIME、キュー長は 10 で初期化される。
+     *
+     * @else
+     * @brief Constructor
+     *
+     * The policy is initialized to EXACT_TIME and the queue length to
+     * 10.
+     *
+     * @endif
+     */
+    InPortSynchronizer();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~InPortSynchronizer();
+
+    InPortSynchronizer(const InPortSynchronizer&) = delete;
+    InPortSynchronizer& operator=(const InPortSynchronizer&) = delete;
+
+    /*!
+     * @if jp
+     * @brief InPort を登録する
+     * @param port InPort
+     * @return read() の引数および readAt() で使用するポートの番号
+     * @else
+     * @brief Register an InPort
+     * @param port The InPort
+     * @return The index of the port used by read() and readAt()
+     * @endif
+     */
+    size_t addPort(InPortBase& port);
+
+    /*!
+     * @if jp
+     * @brief 一致の判定方法を設定する
+     * @param policy 判定方法
+     * @param tolerance APPROXIMATE_TIME で許容するタイムスタンプの差
+     * @else
+     * @brief Set the matching policy
+     * @param policy The policy
+     * @param tolerance The timestamp difference allowed by
+     *                  APPROXIMATE_TIME
+     * @endif
+     */
+    void setPolicy(Policy policy, std::chrono::nanoseconds tolerance
+                   = std::chrono::nanoseconds(0));
+
+    /*!
+     * @if jp
+     * @brief ポートごとのキュー長を設定する
+     *
+     * キューが満杯の場合、最も古いデータを破棄する。
+     *
+     * @param length キュー長 (1 以上)
+     * @else
+     * @brief Set the queue length per port
+     *
+     * The oldest data is discarded when a queue is full.
+     *
+     * @param length The queue length (1 or more)
+     * @endif
+     */
+    void setQueueLength(size_t length);
+
+    /*!
+     * @if jp
+     * @brief 組が揃ったときに呼び出すコールバックを設定する
+     * @param callback コールバック
+     * @else
+     * @brief Set the callback called when a set is complete
+     * @param callback The callback
+     * @endif
+     */
+    void setCallback(Callback callback);
+
+    /*!
+     * @if jp
+     * @brief 受信データを取り込んで組を探す
+     *
+     * 各ポートのコネクタから読み出せるデータをキューに取り込み、一致す
+     * る組を探す。組が揃った場合はそれを一致した組とし、コールバックを
+     * 呼び出す。
+     *
+     * @return 組が揃った場合 true
+     *
+     * @else
+     * @brief Take in the received data and look for a set
+     *
+     * This takes the data readable from the connectors of each port into
+     * the queues and looks for a matching set. If a set is complete, it
+     * becomes the matched set and the callback is called.
+     *
+     * @return true if a set is complete
+     *
+     * @endif
+     */
+    bool sync();
+
+    /*!
+     * @if jp
+     * @brief 一致した組のデータを一つ復号化する
+     * @param index ポートの番号
+     * @param data データを格納する変数
+     * @return 成功した場合 true
+     * @else
+     * @brief Deserialize one data of the matched set
+     * @param index The index of the port
+     * @param data The variable to store the data
+     * @return true if successful
+     * @endif
+     */
+    template <class DataType>
+    bool readAt(size_t index, DataType& data)
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (index >= m_ports.size() || m_ports[index].matched.data.empty())
+        {
+          return false;
+        }
+      const Sample& sample(m_ports[index].matched);
+      auto& factory(coil::GlobalFactory< ::RTC::ByteDataStream<DataType> >::
+                    instance());
+      ::RTC::ByteDataStream<DataType>* cdr(
+        factory.createObject(sample.marshaling));
+      if (cdr == nullptr)
+        {
+          RTC_ERROR(("Can not find Marshalizer: %s",
+                     sample.marshaling.c_str()));
+          return false;
+        }
+      cdr->attachData(sample.data.data(),
+                      static_cast<unsigned long>(sample.data.size()));
+      cdr->isLittleEndian(sample.little);
+      bool ret(cdr->deserialize(data));
+      factory.deleteObject(cdr);
+      return ret;
+    }
+
+    /*!
+     * @if jp
+     * @brief 一致した組のデータを復号化する
+     *
+     * 引数は addPort() で登録した順に与える。
+     *
+     * @param data データを格納する変数
+     * @return すべて成功した場合 true
+     *
+     * @else
+     * @brief Deserialize the data of the matched set
+     *
+     * The arguments are given in the order the ports were added by
+     * addPort().
+     *
+     * @param data The variables to store the data
+     * @return true if all were successful
+     *
+     * @endif
+     */
+    template <class... DataTypes>
+    bool read(DataTypes&... data)
+    {
+      return readFrom(0, data...);
+    }
+
+    /*!
+     * @if jp
+     * @brief 一致せずに破棄したデータ数を取得する
+     * @return 破棄したデータ数
+     * @else
+     * @brief Get the number of data discarded without a match
+     * @return The number of discarded data
+     * @endif
+     */
+    unsigned long discarded() const;
+
+  private:
+    struct Sample
+    {
+      Sample() : stamp(0), little(true) {}
+      long long stamp;
+      std::vector<unsigned char> data;
+      std::string marshaling;
+      bool little;
+    };
+
+    struct Port
+    {
+      InPortBase* port;
+      std::deque<Sample> queue;
+      Sample matched;
+    };
+
+    template <class DataType, class... Rest>
+    bool readFrom(size_t index, DataType& data, Rest&... rest)
+    {
+      bool ret(readAt(index, data));
+      return readFrom(index + 1, rest...) && ret;
+    }
+
+    bool readFrom(size_t /* index */)
+    {
+      return true;
+    }
+
+    void enqueue(Port& port, InPortConnector& connector,
+                 const unsigned char* buffer, unsigned long length);
+    void discard(Port& port);
+    bool match();
+
+    std::vector<Port> m_ports;
+    Policy m_policy;
+    long long m_tolerance;
+    size_t m_queueLength;
+    Callback m_callback;
+    unsigned long m_discarded;
+    // storage of discarded samples reused by enqueue()
+    std::vector<std::vector<unsigned char> > m_spare;
+    mutable std::mutex m_mutex;
+    mutable Logger rtclog;
+  };
+} // namespace RTC
+
+#endif  // RTC_INPORTSYNCHRONIZER_H
@@ -0,0 +1,409 @@
+﻿// -*- C++ -*-
+/*!
+ * @file LZCodec.cpp
+ * @brief LZ compression codec for data port connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <coil/stringutil.h>
+#include <rtm/LZCodec.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+  /*
+   * Frame format
+   *
+   * raw:        'R' | data...
+   * compressed: 'Z' | original length (32 bit little endian) | block...
+   *
+   * A block is a series of sequences in the LZ4 block format:
+   *   token | [literal length ext] | literals | offset (16 bit LE) |
+   *   [match length ext]
+   * The last sequence has literals only.
+   */
+  const unsigned char RAWFRAME('R');
+  const unsigned char LZFRAME('Z');
+  const size_t HEADER_SIZE(5);
+
+  const unsigned int HASH_LOG(12);
+  const size_t MIN_MATCH(4);
+  const size_t LAST_LITERALS(5);
+  const size_t MF_LIMIT(12);
+  const size_t MAX_OFFSET(65535);
+
+  inline uint32_t read32(const unsigned char* p)
+  {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+  }
+
+  inline uint32_t hash(uint32_t v)
+  {
+    return (v * 2654435761U) >> (32 - HASH_LOG);
+  }
+
+  inline unsigned char* putLength(unsigned char* op, size_t len)
+  {
+    while (len >= 255)
+      {
+        *op++ = 255;
+        len -= 255;
+      }
+    *op++ = static_cast<unsigned char>(len);
+    return op;
+  }
+
+  // worst case size of a block
+  inline size_t bound(size_t len)
+  {
+    return len + len / 255 + 16;
+  }
+
+  using Clock = std::chrono::steady_clock;
+
+  inline unsigned long long elapsed(Clock::time_point start)
+  {
+    return static_cast<unsigned long long>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - start).count());
+  }
+} // namespace
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  LZCodec::LZCodec()
+    : rtclog("LZCodec"), m_threshold(1024),
+      m_table(static_cast<size_t>(1) << HASH_LOG),
+      m_rawBytes(0), m_encodedBytes(0), m_skippedCount(0),
+      m_encodeCount(0), m_encodeTime(0),
+      m_decodeCount(0), m_decodeTime(0)
+  {
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  LZCodec::~LZCodec() = default;
+
+  /*!
+   * @if jp
+   * @brief 設定初期化
+   * @else
+   * @brief Initializing configuration
+   * @endif
+   */
+  void LZCodec::init(const coil::Properties& prop)
+  {
+    RTC_TRACE(("init()"));
+    RTC_DEBUG_STR((prop));
+
+    if (!coil::stringTo(m_threshold,
+                        prop.getProperty("threshold", "1024").c_str()))
+      {
+        RTC_ERROR(("invalid threshold: %s", prop["threshold"].c_str()));
+        m_threshold = 1024;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信データを符号化する
+   * @else
+   * @brief Encode data to send
+   * @endif
+   */
+  bool LZCodec::encode(const ByteData& in, ByteData& out)
+  {
+    const unsigned char* src(in.getBuffer());
+    size_t len(in.getDataLength());
+    m_rawBytes += len;
+
+    if (len >= m_threshold && len >= MF_LIMIT)
+      {
+        Clock::time_point start(Clock::now());
+        m_buf.resize(HEADER_SIZE + bound(len));
+        size_t size(compress(src, len, m_buf.data() + HEADER_SIZE));
+        m_encodeTime += elapsed(start);
+        ++m_encodeCount;
+
+        if (size < len)
+          {
+            m_buf[0] = LZFRAME;
+            m_buf[1] = static_cast<unsigned char>(len);
+            m_buf[2] = static_cast<unsigned char>(len >> 8);
+            m_buf[3] = static_cast<unsigned char>(len >> 16);
+            m_buf[4] = static_cast<unsigned char>(len >> 24);
+            out.writeData(m_buf.data(),
+                          static_cast<unsigned long>(HEADER_SIZE + size));
+            m_encodedBytes += HEADER_SIZE + size;
+            return true;
+          }
+      }
+
+    // small or incompressible data
+    ++m_skippedCount;
+    m_buf.resize(1 + len);
+    m_buf[0] = RAWFRAME;
+    if (len != 0) { memcpy(m_buf.data() + 1, src, len); }
+    out.writeData(m_buf.data(), static_cast<unsigned long>(m_buf.size()));
+    m_encodedBytes += m_buf.size();
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 受信データを復号する
+   * @else
+   * @brief Decode received data
+   * @endif
+   */
+  bool LZCodec::decode(const ByteData& in, ByteData& out)
+  {
+    const unsigned char* src(in.getBuffer());
+    size_t len(in.getDataLength());
+    if (len < 1)
+      {
+        RTC_WARN(("invalid lz frame: empty"));
+        return false;
+      }
+
+    if (src[0] == RAWFRAME)
+      {
+        out.writeData(src + 1, static_cast<unsigned long>(len - 1));
+        return true;
+      }
+    if (src[0] != LZFRAME || len < HEADER_SIZE)
+      {
+        RTC_WARN(("invalid lz frame: unknown type"));
+        return false;
+      }
+
+    size_t size(static_cast<size_t>(src[1]) |
+                (static_cast<size_t>(src[2]) << 8) |
+                (static_cast<size_t>(src[3]) << 16) |
+                (static_cast<size_t>(src[4]) << 24));
+    // a sequence expands to at most 255 times its size
+    if (size > (len - HEADER_SIZE) * 255)
+      {
+        RTC_WARN(("invalid lz frame: bad length"));
+        return false;
+      }
+    Clock::time_point start(Clock::now());
+    m_buf.resize(size);
+    if (!decompress(src + HEADER_SIZE, len - HEADER_SIZE, m_buf.data(), size))
+      {
+        RTC_WARN(("invalid lz frame: corrupted block"));
+        return false;
+      }
+    m_decodeTime += elapsed(start);
+    ++m_decodeCount;
+    out.writeData(m_buf.data(), static_cast<unsigned long>(size));
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get statistics
+   * @endif
+   */
+  void LZCodec::getStatistics(coil::Properties& stat) const
+  {
+    unsigned long long raw(m_rawBytes.load());
+    unsigned long long encoded(m_encodedBytes.load());
+    unsigned long ecount(m_encodeCount.load());
+    unsigned long dcount(m_decodeCount.load());
+
+    stat.setProperty("codec.lz.raw_bytes", coil::otos(raw));
+    stat.setProperty("codec.lz.encoded_bytes", coil::otos(encoded));
+    stat.setProperty("codec.lz.ratio",
+                     coil::otos(encoded != 0 ?
+                                static_cast<double>(raw) / encoded : 1.0));
+    stat.setProperty("codec.lz.skipped_count",
+                     coil::otos(m_skippedCount.load()));
+    stat.setProperty("codec.lz.encode_time",
+                     coil::otos(ecount != 0 ?
+                                m_encodeTime.load() / 1e9 / ecount : 0.0));
+    stat.setProperty("codec.lz.decode_time",
+                     coil::otos(dcount != 0 ?
+                                m_decodeTime.load() / 1e9 / dcount : 0.0));
+  }
+
+  /*!
+   * @if jp
+   * @brief ブロックを圧縮する
+   * @else
+   * @brief Compress a block
+   * @endif
+   */
+  size_t LZCodec::compress(const unsigned char* src, size_t len,
+                           unsigned char* dst)
+  {
+    std::fill(m_table.begin(), m_table.end(), 0);
+    unsigned char* op(dst);
+    size_t anchor(0);
+    size_t ip(0);
+    const size_t limit(len - MF_LIMIT);
+    const size_t match_limit(len - LAST_LITERALS);
+
+    while (ip < limit)
+      {
+        uint32_t seq(read32(src + ip));
+        uint32_t& entry(m_table[hash(seq)]);
+        size_t ref(entry);
+        entry = static_cast<uint32_t>(ip);
+
+        if (ref >= ip || ip - ref > MAX_OFFSET || read32(src + ref) != seq)
+          {
+            // skip faster through incompressible data
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+          }
+
+        size_t match(MIN_MATCH);
+        while (ip + match < match_limit && src[ref + match] == src[ip + match])
+          {
+            ++match;
+          }
+
+        size_t literals(ip - anchor);
+        size_t mlen(match - MIN_MATCH);
+        unsigned char* token(op++);
+        *token = static_cast<unsigned char>(
+          ((literals < 15 ? literals : 15) << 4) | (mlen < 15 ? mlen : 15));
+        if (literals >= 15) { op = putLength(op, literals - 15); }
+        memcpy(op, src + anchor, literals);
+        op += literals;
+        size_t offset(ip - ref);
+        *op++ = static_cast<unsigned char>(offset);
+        *op++ = static_cast<unsigned char>(offset >> 8);
+        if (mlen >= 15) { op = putLength(op, mlen - 15); }
+
+        ip += match;
+        anchor = ip;
+      }
+
+    // last literals
+    size_t literals(len - anchor);
+    *op++ = static_cast<unsigned char>((literals < 15 ? literals : 15) << 4);
+    if (literals >= 15) { op = putLength(op, literals - 15); }
+    memcpy(op, src + anchor, literals);
+    op += literals;
+    return static_cast<size_t>(op - dst);
+  }
+
+  /*!
+   * @if jp
+   * @brief ブロックを伸長する
+   * @else
+   * @brief Decompress a block
+   * @endif
+   */
+  bool LZCodec::decompress(const unsigned char* src, size_t len,
+                           unsigned char* dst, size_t dstlen)
+  {
+    size_t ip(0);
+    size_t op(0);
+    while (ip < len)
+      {
+        unsigned char token(src[ip++]);
+
+        size_t literals(token >> 4);
+        if (literals == 15)
+          {
+            unsigned char b;
+            do
+              {
+                if (ip >= len) { return false; }
+                b = src[ip++];
+                literals += b;
+              } while (b == 255);
+          }
+        if (literals > len - ip || literals > dstlen - op) { return false; }
+        memcpy(dst + op, src + ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == len) { break; }  // last sequence
+
+        if (len - ip < 2) { return false; }
+        size_t offset(static_cast<size_t>(src[ip]) |
+                      (static_cast<size_t>(src[ip + 1]) << 8));
+        ip += 2;
+        if (offset == 0 || offset > op) { return false; }
+
+        size_t match(token & 0x0f);
+        if (match == 15)
+          {
+            unsigned char b;
+            do
+              {
+                if (ip >= len) { return false; }
+                b = src[ip++];
+                match += b;
+              } while (b == 255);
+          }
+        match += MIN_MATCH;
+        if (match > dstlen - op) { return false; }
+
+        // the match may overlap the output
+        const unsigned char* ref(dst + op - offset);
+        unsigned char* out(dst + op);
+        if (offset >= match)
+          {
+            memcpy(out, ref, match);
+          }
+        else
+          {
+            for (size_t i(0); i < match; ++i) { out[i] = ref[i]; }
+          }
+        op += match;
+      }
+    return op == dstlen;
+  }
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   * @else
+   * @brief Module initialization
+   * @endif
+   */
+  void LZCodecInit(void)
+  {
+    RTC::ConnectorCodecFactory& factory(RTC::ConnectorCodecFactory::instance());
+    factory.addFactory("lz",
+                       ::coil::Creator< ::RTC::ConnectorCodec,
+                                        ::RTC::LZCodec>,
+                       ::coil::Destructor< ::RTC::ConnectorCodec,
+                                           ::RTC::LZCodec>);
+  }
+}
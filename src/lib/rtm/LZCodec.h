@@ -0,0 +1,163 @@
+﻿// -*- C++ -*-
+/*!
+ * @file LZCodec.h
+ * @brief LZ compression codec for data port connectors
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_LZCODEC_H
+#define RTC_LZCODEC_H
+
+#include <rtm/ConnectorCodec.h>
+#include <rtm/SystemLogger.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class LZCodec
+   * @brief LZ 圧縮コーデック
+   *
+   * 外部ライブラリに依存しない LZ77 系の高速圧縮コーデック。深度画像や
+   * 点群など、冗長性の高い大きなデータの転送量を削減する。圧縮形式は
+   * LZ4 のブロック形式と同様で、一致長 4 バイト以上、オフセット 64KB
+   * 以内の一致を検出する。
+   *
+   * threshold より小さいデータおよび圧縮しても小さくならないデータは
+   * 圧縮せずに送信する。
+   *
+   * コネクタプロファイルの codec.lz ノードの以下のプロパティで設定する。
+   *
+   * - threshold: 圧縮するデータの最小サイズ [バイト] (デフォルト: 1024)
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class LZCodec
+   * @brief LZ compression codec
+   *
+   * A fast LZ77 family compression codec without external dependencies.
+   * It reduces the transferred size of large redundant data such as
+   * depth images and point clouds. The compressed format is the same as
+   * the LZ4 block format, and matches of 4 bytes or longer within 64KB
+   * are detected.
+   *
+   * Data smaller than threshold and data which does not shrink are sent
+   * uncompressed.
+   *
+   * It is configured by the following properties under the codec.lz
+   * node of the connector properties.
+   *
+   * - threshold: Minimum size of data to compress [bytes] (default: 1024)
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class LZCodec
+    : public ConnectorCodec
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    LZCodec();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~LZCodec() override;
+
+    void init(const coil::Properties& prop) override;
+    bool encode(const ByteData& in, ByteData& out) override;
+    bool decode(const ByteData& in, ByteData& out) override;
+
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     *
+     * 以下の値を設定する。
+     *
+     * - codec.lz.raw_bytes: 符号化前の合計サイズ [バイト]
+     * - codec.lz.encoded_bytes: 符号化後の合計サイズ [バイト]
+     * - codec.lz.ratio: 圧縮率 (raw_bytes / encoded_bytes)
+     * - codec.lz.skipped_count: 圧縮しなかったデータ数
+     * - codec.lz.encode_time: 1 データ当たりの平均圧縮時間 [秒]
+     * - codec.lz.decode_time: 1 データ当たりの平均伸長時間 [秒]
+     *
+     * @else
+     * @brief Get statistics
+     *
+     * This operation sets the following values.
+     *
+     * - codec.lz.raw_bytes: Total size before encoding [bytes]
+     * - codec.lz.encoded_bytes: Total size after encoding [bytes]
+     * - codec.lz.ratio: Compression ratio (raw_bytes / encoded_bytes)
+     * - codec.lz.skipped_count: Number of data sent uncompressed
+     * - codec.lz.encode_time: Mean compression time per data [sec]
+     * - codec.lz.decode_time: Mean decompression time per data [sec]
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) const override;
+
+  private:
+    size_t compress(const unsigned char* src, size_t len, unsigned char* dst);
+    static bool decompress(const unsigned char* src, size_t len,
+                           unsigned char* dst, size_t dstlen);
+
+    mutable Logger rtclog;
+    size_t m_threshold;
+    std::vector<uint32_t> m_table;
+    std::vector<unsigned char> m_buf;
+
+    std::atomic<unsigned long long> m_rawBytes;
+    std::atomic<unsigned long long> m_encodedBytes;
+    std::atomic<unsigned long> m_skippedCount;
+    std::atomic<unsigned long> m_encodeCount;
+    std::atomic<unsigned long long> m_encodeTime;
+    std::atomic<unsigned long> m_decodeCount;
+    std::atomic<unsigned long long> m_decodeTime;
+  };
+} // namespace RTC
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief モジュール初期化関数
+   *
+   * LZCodec のファクトリを登録する初期化関数。
+   *
+   * @else
+   * @brief Module initialization
+   *
+   * This initialization function registers LZCodec's factory.
+   *
+   * @endif
+   */
+  void LZCodecInit(void);
+}
+
+#endif  // RTC_LZCODEC_H
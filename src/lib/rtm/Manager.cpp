@@ -29,6 +29,8 @@
 #include <rtm/OpenHRPExecutionContext.h>
 #include <rtm/PeriodicECSharedComposite.h>
 #include <rtm/MultilayerCompositeEC.h>
+#include <rtm/DataTriggeredExecutionContext.h>
+#include <rtm/ParallelExecutionContext.h>
 #include <rtm/RTCUtil.h>
 #include <rtm/ManagerServant.h>
 #include <coil/Properties.h>
@@ -1920,6 +1922,8 @@ std::vector<coil::Properties> Manager::getLoadableModules()
     OpenHRPExecutionContextInit(this);
     SimulatorExecutionContextInit(this);
     MultilayerCompositeECInit(this);
+    DataTriggeredExecutionContextInit(this);
+    ParallelExecutionContextInit(this);
 #ifdef RTM_OS_VXWORKS
     VxWorksRTExecutionContextInit(this);
 #ifndef __RTP__
@@ -20,6 +20,7 @@
 #include <rtm/MultilayerCompositeEC.h>
 #include <rtm/RTObjectStateMachine.h>
 #include <rtm/PeriodicTaskFactory.h>
+#include <coil/Affinity.h>
 
 #include <cstring>
 #include <algorithm>
@@ -53,12 +54,39 @@ namespace RTC_exp
   MultilayerCompositeEC::~MultilayerCompositeEC()
   {
     RTC_TRACE(("~MultilayerCompositeEC()"));
+    // the thread must stop before the child tasks are deleted
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      m_svc = false;
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_workerthread.mutex_);
+      m_workerthread.running_ = true;
+      m_workerthread.cond_.notify_one();
+    }
+    wait();
+    m_barrier.cancel();
+    for (auto & task : m_tasklist)
+      {
+        task->finalize();
+        delete task;
+      }
+    m_tasklist.clear();
   }
 
   void MultilayerCompositeEC::init(coil::Properties& props)
   {
     PeriodicExecutionContext::init(props);
 
+    double spin(0.00001);
+    getProperty(props, "barrier.spin_time", spin);
+    bool yield(coil::toBool(props["barrier.yield"], "YES", "NO", false));
+    m_barrier.setWaitStrategy(std::chrono::duration_cast<
+                              std::chrono::nanoseconds>(
+                                std::chrono::duration<double>(spin)),
+                              yield);
+    RTC_DEBUG(("barrier.spin_time: %f [s]", spin));
+    RTC_DEBUG(("barrier.yield:     %s", yield ? "YES" : "NO"));
   }
 
 
@@ -80,7 +108,14 @@ namespace RTC_exp
 
     const RTC::RTObject_ptr owner = getOwner();
     m_ownersm = m_worker.findComponent(owner);
+    for (auto & task : m_tasklist)
+      {
+        task->start();
+      }
 
+    // start of the previous cycle, valid if it slept until this one
+    bool periodic(false);
+    std::chrono::steady_clock::time_point prev;
     do
       {
           
@@ -93,28 +128,31 @@ namespace RTC_exp
           while (!m_workerthread.running_)
             {
               m_workerthread.cond_.wait(guard);
+              periodic = false;
             }
         }
-        auto t0 = std::chrono::high_resolution_clock::now();
+        auto t0 = std::chrono::steady_clock::now();
+        auto period = getPeriod();
+        if (m_statistics && periodic)
+          {
+            auto diff = (t0 - prev) - period;
+            m_jitter.record(diff < diff.zero() ? -diff : diff);
+          }
+        prev = t0;
         m_ownersm->workerDo();
         m_ownersm->workerPostDo();
         
         
-        for (auto & task : m_tasklist)
-        {
-            task->signal();
-        }
+        // release the child tasks and wait for them to finish
+        m_barrier.wait();
+        m_barrier.wait();
         
-        for (auto & task : m_tasklist)
-        {
-            task->join();
-        }
         
-        
-        auto t1 = std::chrono::high_resolution_clock::now();
+        auto t1 = std::chrono::steady_clock::now();
 
-        auto period = getPeriod();
         auto rest = period - (t1 - t0);
+        periodic = !m_nowait && (rest > std::chrono::seconds::zero());
+        if (!m_nowait && !periodic) { ++m_missedDeadlines; }
         if (count > 1000)
           {
             RTC_PARANOID(("Period:    %f [s]", std::chrono::duration<double>(period).count()));
@@ -128,18 +166,24 @@ namespace RTC_exp
                 RTC_PARANOID(("MIN(%d):  %f [s]", task_num, st.min_interval));
                 RTC_PARANOID(("MEAN(%d): %f [s]", task_num, st.mean_interval));
                 RTC_PARANOID(("SD(%d):   %f [s]", task_num, st.std_deviation));
+                RTC_PARANOID(("P99(%d):  %f [s]", task_num, st.p99));
                 task_num += 1;
             }
           }
-        auto t2 = std::chrono::high_resolution_clock::now();
-        if (!m_nowait && (rest > std::chrono::seconds::zero()))
+        auto t2 = std::chrono::steady_clock::now();
+        if (periodic)
           {
             if (count > 1000) { RTC_PARANOID(("sleeping...")); }
-            std::this_thread::sleep_until(t0 + period);
+            m_timer.sleepUntil(t0 + period);
+            if (m_statistics)
+              {
+                m_wakeupLatency.record(
+                  std::chrono::steady_clock::now() - (t0 + period));
+              }
           }
         if (count > 1000)
           {
-            auto t3 = std::chrono::high_resolution_clock::now();
+            auto t3 = std::chrono::steady_clock::now();
             RTC_PARANOID(("Slept:     %f [s]", std::chrono::duration<double>(t3 - t2).count()));
             count = 0;
           }
@@ -216,7 +260,7 @@ namespace RTC_exp
           return;
       }
 
-      ChildTask *ct = new ChildTask(task, this);
+      ChildTask *ct = new ChildTask(task, this, prop["cpu_affinity"]);
 
       task->setTask([ct]{ ct->svc(); });
       task->setPeriod(std::chrono::seconds(0));
@@ -245,6 +289,7 @@ namespace RTC_exp
       }
 
       m_tasklist.push_back(ct);
+      m_barrier.setCount(m_tasklist.size() + 1);
 
       // Start task in suspended mode
       task->suspend();
@@ -274,8 +319,9 @@ namespace RTC_exp
 
   }
 
-  MultilayerCompositeEC::ChildTask::ChildTask(coil::PeriodicTaskBase* task, MultilayerCompositeEC* ec) :
-      m_task(task), m_ec(ec)
+  MultilayerCompositeEC::ChildTask::ChildTask(coil::PeriodicTaskBase* task, MultilayerCompositeEC* ec,
+                                              std::string cpu) :
+      m_task(task), m_ec(ec), m_cpu(std::move(cpu)), m_pinned(false)
   {
 
   }
@@ -310,25 +356,22 @@ namespace RTC_exp
 
   int MultilayerCompositeEC::ChildTask::svc()
   {
+      if (!m_pinned)
       {
-          std::lock_guard<std::mutex> guard(m_worker.mutex_);
-          m_worker.running_ = true;
+          m_pinned = true;
+          if (!m_cpu.empty() && !coil::setThreadCpuAffinity(m_cpu))
+          {
+              RTC::Logger& rtclog(m_ec->rtclog);
+              RTC_ERROR(("CPU affinity setting failed: %s", m_cpu.c_str()));
+          }
       }
 
+      // wait for the owner to finish
+      if (!m_ec->m_barrier.wait())
       {
-          std::unique_lock<std::mutex> guard(m_signal_worker.mutex_);
-
-          while (!m_signal_worker.running_)
-          {
-              m_signal_worker.cond_.wait(guard);
-          }
-          m_signal_worker.running_ = false;
-          
+          return 0;
       }
-      
 
-      
-      
       updateCompList();
       for (auto & comp : m_comps)
       {
@@ -336,66 +379,14 @@ namespace RTC_exp
           comp->workerDo();
           comp->workerPostDo();
       }
-      
-      {
-          std::lock_guard<std::mutex> guard(m_worker.mutex_);
-          m_worker.running_ = false;
-          
-          m_worker.cond_.notify_one();
-          
-
-      }
-
-      {
-          std::unique_lock<std::mutex> guard(m_signal_worker.mutex_);
-          while (!m_signal_worker.running_){
-             m_signal_worker.cond_.wait(guard);
-          }
-          m_signal_worker.running_ = false;
-      }
-      
-      
 
+      m_ec->m_barrier.wait();
       return 0;
   }
 
-  void MultilayerCompositeEC::ChildTask::signal()
-  {
-      
-      bool ret = false;
-      while (!ret)
-      {
-          m_task->signal();
-         
-          {
-              std::lock_guard<std::mutex> guard(m_worker.mutex_);
-              ret = m_worker.running_;
-          }
-      }
-      {
-          std::lock_guard<std::mutex> guard(m_signal_worker.mutex_);
-          m_signal_worker.running_ = true;
-          m_signal_worker.cond_.notify_one();
-      }
-      
-
-  }
-
-  void MultilayerCompositeEC::ChildTask::join()
+  void MultilayerCompositeEC::ChildTask::start()
   {
-      {
-          std::unique_lock<std::mutex> guard(m_worker.mutex_);
-          while (m_worker.running_)
-          {
-              m_worker.cond_.wait(guard);
-          }
-      }
-
-      {
-          std::lock_guard<std::mutex> guard(m_signal_worker.mutex_);
-          m_signal_worker.running_ = true;
-          m_signal_worker.cond_.notify_one();
-      }
+      m_task->resume();
   }
 
   coil::TimeMeasure::Statistics MultilayerCompositeEC::ChildTask::getPeriodStat()
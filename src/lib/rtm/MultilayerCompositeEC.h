@@ -20,8 +20,11 @@
 
 
 #include <rtm/PeriodicExecutionContext.h>
+#include <rtm/Barrier.h>
 #include <coil/PeriodicTask.h>
 
+#include <string>
+
 
 
 namespace RTC_exp
@@ -33,6 +36,18 @@ namespace RTC_exp
    *
    * Periodic Sampled Data Processing(周期実行用)ExecutionContextクラス。
    *
+   * オーナーの後に各層の子タスクを並列に実行する。EC のスレッドと子
+   * タスクのスレッドは周期ごとに Barrier で同期する。以下のプロパティ
+   * を exec_cxt.periodic 以下に指定する。
+   *
+   * - barrier.spin_time: 同期を待つスレッドがブロックする前にスピンす
+   *                      る時間 [s]。デフォルトは 0.00001。
+   * - barrier.yield: YES の場合、スピン中にスレッドを譲る。コア数より
+   *                  多くのスレッドが動作する場合に使用する。デフォル
+   *                  トは NO。
+   * - ec<N>.cpu_affinity: N 番目の子タスクのスレッドを割り当てる CPU
+   *                       のカンマ区切りリスト。
+   *
    * @since 0.4.0
    *
    * @else
@@ -42,6 +57,20 @@ namespace RTC_exp
    * Periodic Sampled Data Processing (for the execution cycles)
    * ExecutionContext class
    *
+   * The child tasks of the layers are executed in parallel after the
+   * owner. The thread of the EC and the threads of the child tasks
+   * synchronize through a Barrier every cycle. The following
+   * properties are given under exec_cxt.periodic.
+   *
+   * - barrier.spin_time: The time [s] a thread waiting for the
+   *                      synchronization spins before blocking. The
+   *                      default is 0.00001.
+   * - barrier.yield: If YES, the thread yields while spinning. It is
+   *                  used when more threads than cores are running.
+   *                  The default is NO.
+   * - ec<N>.cpu_affinity: Comma separated list of the CPUs the thread of
+   *                       the N-th child task runs on.
+   *
    * @since 0.4.0
    *
    * @endif
@@ -148,13 +177,13 @@ namespace RTC_exp
       class ChildTask
       {
       public:
-          ChildTask(coil::PeriodicTaskBase* task, MultilayerCompositeEC* ec);
+          ChildTask(coil::PeriodicTaskBase* task, MultilayerCompositeEC* ec,
+                    std::string cpu);
           virtual ~ChildTask();
           void addComponent(RTC::LightweightRTObject_ptr rtc);
           void updateCompList();
           virtual int svc();
-          void signal();
-          void join();
+          void start();
           coil::TimeMeasure::Statistics getPeriodStat();
           coil::TimeMeasure::Statistics getExecStat();
           void finalize();
@@ -163,8 +192,9 @@ namespace RTC_exp
           coil::PeriodicTaskBase* m_task;
           MultilayerCompositeEC* m_ec;
           std::vector<RTC_impl::RTObjectStateMachine*> m_comps;
-          WorkerThreadCtrl m_worker;
-          WorkerThreadCtrl m_signal_worker;
+          // CPU affinity set by the thread itself at the first cycle
+          std::string m_cpu;
+          bool m_pinned;
 
       };
 
@@ -172,6 +202,8 @@ namespace RTC_exp
 
       std::vector<ChildTask*> m_tasklist;
       RTC_impl::RTObjectStateMachine* m_ownersm;
+      // the EC thread and the child tasks meet twice a cycle
+      RTC::Barrier m_barrier;
 
 
   };  // class MultilayerCompositeEC
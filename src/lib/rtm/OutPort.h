@@ -31,9 +31,11 @@
 #include <rtm/OutPortConnector.h>
 #include <rtm/Timestamp.h>
 #include <rtm/DirectOutPortBase.h>
+#include <rtm/FastCdrSerializer.h>
 
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace RTC
@@ -115,6 +117,7 @@ namespace RTC
 	  m_directport = this;
 
       CdrMemoryStreamInit<DataType>();
+      FastCdrSerializerInit<DataType>();
       
           
       std::string serializer_types = coil::flatten(coil::GlobalFactory < ByteDataStream<DataType> >::instance().getIdentifiers());
@@ -189,79 +192,41 @@ namespace RTC
     virtual bool write(DataType& value)
     {
       RTC_TRACE(("DataType write()"));
+      return writeValue(value, false);
+    }
 
-      if (m_onWrite != nullptr)
-        {
-          (*m_onWrite)(value);
-          RTC_TRACE(("OnWrite called"));
-        }
-
-
-      bool result(true);
-      std::vector<const char *> disconnect_ids;
-      {
-        std::lock_guard<std::mutex> con_guard(m_connectorsMutex);
-        // check number of connectors
-        size_t conn_size(m_connectors.size());
-        if (!(conn_size > 0)) { return false; }
-
-        m_status.resize(conn_size);
-
-        for (size_t i(0), len(conn_size); i < len; ++i)
-          {
-
-            DataPortStatus ret;
-            if (!m_connectors[i]->pullDirectMode())
-              {
-                if (m_onWriteConvert != nullptr)
-                  {
-                    RTC_DEBUG(("m_connectors.OnWriteConvert called"));
-                    DataType tmp = (*m_onWriteConvert)(value);
-                    ret = m_connectors[i]->write(tmp);
-                  }
-                else
-                  {
-                    RTC_DEBUG(("m_connectors.write called"));
-                    ret = m_connectors[i]->write(value);
-                  }
-              }
-            else
-              {
-                std::lock_guard<std::mutex> value_guard(m_valueMutex);
-                if (m_onWriteConvert != nullptr)
-                  {
-                    RTC_DEBUG(("m_connectors.OnWriteConvert called"));
-                    m_directValue = ((*m_onWriteConvert)(value));
-                  }
-                else
-                  {
-                    m_directValue = value;
-                  }
-                m_directNewData = true;
-                ret = DataPortStatus::PORT_OK;
-              }
-            m_status[i] = ret;
-
-            if (ret == DataPortStatus::PORT_OK) { continue; }
-
-            result = false;
-
-            if (ret == DataPortStatus::CONNECTION_LOST)
-              {
-                const char* id(m_connectors[i]->profile().id.c_str());
-                RTC_WARN(("connection_lost id: %s", id));
-                if (m_onConnectionLost != nullptr)
-                  {
-                    RTC::ConnectorProfile prof(findConnProfile(id));
-                    (*m_onConnectionLost)(prof);
-                  }
-                disconnect_ids.push_back(id);
-              }
-          }
-      }
-      std::for_each(disconnect_ids.begin(), disconnect_ids.end(),
-                    std::bind1st(std::mem_fun(&PortBase::disconnect), this));
-      return result;
+    /*!
+     * @if jp
+     *
+     * @brief データ書き込み(右辺値版)
+     *
+     * write(DataType&) と同様にポートへデータを書き込む。pull 型のダ
+     * イレクト接続へはデータをコピーせずにムーブする。呼び出し後の
+     * value の内容は不定である。
+     *
+     * @param value 書き込み対象データ
+     *
+     * @return 書き込み処理結果(書き込み成功:true、書き込み失敗:false)
+     *
+     * @else
+     *
+     * @brief Write data (rvalue version)
+     *
+     * This writes data in the port in the same way as
+     * write(DataType&). The data is moved instead of copied to the
+     * pull type direct connection. The contents of value are
+     * unspecified after the call.
+     *
+     * @param value The target data for writing
+     *
+     * @return Writing result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool write(DataType&& value)
+    {
+      RTC_TRACE(("DataType write(DataType&&)"));
+      return writeValue(value, true);
     }
 
     /*!
@@ -320,6 +285,34 @@ namespace RTC
       return write(value);
     }
 
+    /*!
+     * @if jp
+     *
+     * @brief データ書き込み(右辺値版)
+     *
+     * write(DataType&&) を呼び出す。
+     *
+     * @param value 書き込み対象データ
+     *
+     * @return 書き込み処理結果(書き込み成功:true、書き込み失敗:false)
+     *
+     * @else
+     *
+     * @brief Write data (rvalue version)
+     *
+     * This calls write(DataType&&).
+     *
+     * @param value The target data for writing
+     *
+     * @return Writing result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool operator<<(DataType&& value)
+    {
+      return write(std::move(value));
+    }
+
     /*!
      * @if jp
      *
@@ -497,6 +490,119 @@ namespace RTC
 	}
     
   private:
+    /*!
+     * @if jp
+     *
+     * @brief データを各コネクタへ書き込む
+     *
+     * OnWriteConvert は接続数によらず一度だけ呼び出し、その結果を全て
+     * のコネクタへ書き込む。コネクタが切断されない限りヒープを確保しな
+     * い。
+     *
+     * @param value 書き込み対象データ
+     * @param movable true の場合 value をダイレクト接続へムーブしてよい
+     *
+     * @return 書き込み処理結果(書き込み成功:true、書き込み失敗:false)
+     *
+     * @else
+     *
+     * @brief Write data to each connector
+     *
+     * OnWriteConvert is called once regardless of the number of
+     * connections, and the result is written to all connectors. No
+     * heap memory is allocated unless a connector is disconnected.
+     *
+     * @param value The target data for writing
+     * @param movable If true, value may be moved to the direct connection
+     *
+     * @return Writing result (Successful:true, Failed:false)
+     *
+     * @endif
+     */
+    bool writeValue(DataType& value, bool movable)
+    {
+      if (m_onWrite != nullptr)
+        {
+          (*m_onWrite)(value);
+          RTC_TRACE(("OnWrite called"));
+        }
+
+      bool result(true);
+      // stays empty (no allocation) unless a connection is lost
+      std::vector<std::string> disconnect_ids;
+      {
+        std::lock_guard<std::mutex> con_guard(m_connectorsMutex);
+        // check number of connectors
+        size_t conn_size(m_connectors.size());
+        if (!(conn_size > 0)) { return false; }
+
+        DataType* data(&value);
+        if (m_onWriteConvert != nullptr)
+          {
+            RTC_DEBUG(("OnWriteConvert called"));
+            m_convertedValue = (*m_onWriteConvert)(value);
+            data = &m_convertedValue;
+            movable = false;
+          }
+
+        m_status.resize(conn_size);
+
+        bool direct(false);
+        for (size_t i(0), len(conn_size); i < len; ++i)
+          {
+
+            DataPortStatus ret;
+            if (!m_connectors[i]->pullDirectMode())
+              {
+                RTC_DEBUG(("m_connectors.write called"));
+                ret = m_connectors[i]->write(*data);
+              }
+            else
+              {
+                direct = true;
+                ret = DataPortStatus::PORT_OK;
+              }
+            m_status[i] = ret;
+
+            if (ret == DataPortStatus::PORT_OK) { continue; }
+
+            result = false;
+
+            if (ret == DataPortStatus::CONNECTION_LOST)
+              {
+                const char* id(m_connectors[i]->profile().id.c_str());
+                RTC_WARN(("connection_lost id: %s", id));
+                if (m_onConnectionLost != nullptr)
+                  {
+                    RTC::ConnectorProfile prof(findConnProfile(id));
+                    (*m_onConnectionLost)(prof);
+                  }
+                disconnect_ids.emplace_back(id);
+              }
+          }
+
+        // pull type direct connections share one value
+        if (direct)
+          {
+            std::lock_guard<std::mutex> value_guard(m_valueMutex);
+            if (movable)
+              {
+                m_directValue = std::move(*data);
+              }
+            else
+              {
+                m_directValue = *data;
+              }
+            m_directNewData = true;
+          }
+      }
+      for (auto& id : disconnect_ids)
+        {
+          disconnect(id.c_str());
+        }
+      return result;
+    }
+
     std::string m_typename;
     /*!
      * @if jp
@@ -534,6 +640,15 @@ namespace RTC
     std::mutex m_valueMutex;
     bool m_directNewData;
     DataType m_directValue;
+
+    /*!
+     * @if jp
+     * @brief OnWriteConvert で変換したデータ
+     * @else
+     * @brief The data converted by OnWriteConvert
+     * @endif
+     */
+    DataType m_convertedValue;
   };
 } // namespace RTC
 
@@ -527,6 +527,12 @@ namespace RTC
         return returnvalue;
       }
 
+    // codecs available on this side
+    CORBA_SeqUtil::
+      push_back(cprof.properties,
+                NVUtil::newNV("dataport.codec.outport_supported",
+                              ConnectorCodecChain::supported().c_str()));
+
     // prop: [port.outport].
     coil::Properties prop(m_properties);
     {
@@ -544,6 +550,8 @@ namespace RTC
     RTC_DEBUG(("ConnectorProfile::properties are as follows."));
     RTC_PARANOID_STR((prop));
 
+    selectCodecs(cprof, prop);
+
     /*
      * ここで, ConnectorProfile からの properties がマージされたため、
      * prop["dataflow_type"]: データフロータイプ
@@ -621,7 +629,14 @@ namespace RTC
         RTC_ERROR(("unsupported endian"));
         return RTC::UNSUPPORTED;
       }
-    RTC_TRACE(("endian: %s", m_littleEndian ? "little":"big"));
+    RTC_TRACE(("endian: %s", littleEndian ? "little":"big"));
+
+    // the codecs recorded by selectCodecs(), or none if the peer does
+    // not support codecs
+    prop["codec_type"] =
+      ConnectorCodecChain::negotiate(prop["codec_type"],
+                                     prop["codec.inport_supported"]);
+    RTC_DEBUG(("codec_type: %s", prop["codec_type"].c_str()));
 
     /*
      * ここで, ConnectorProfile からの properties がマージされたため、
@@ -649,6 +664,7 @@ namespace RTC
           {
             return RTC::RTC_ERROR;
           }
+        connector->setEndian(littleEndian);
 
         RTC_DEBUG(("subscribeInterfaces() successfully finished."));
         return RTC::RTC_OK;
@@ -666,6 +682,7 @@ namespace RTC
             return RTC::RTC_ERROR;
           }
         conn->setEndian(littleEndian);
+        conn->setCodecs(prop);
         RTC_DEBUG(("subscribeInterfaces() successfully finished."));
         return RTC::RTC_OK;
       }
@@ -851,6 +868,43 @@ namespace RTC
     return false;
   }
 
+  /*!
+   * @if jp
+   * @brief 接続で使用するコーデックを決定する
+   * @else
+   * @brief Select the codecs used by the connection
+   * @endif
+   */
+  void OutPortBase::selectCodecs(ConnectorProfile& cprof,
+                                 coil::Properties& prop)
+  {
+    std::string codec_type(prop["codec_type"]);
+    bool agreed(prop.findNode("codec.inport_supported") != nullptr);
+    if (agreed)
+      {
+        codec_type = ConnectorCodecChain::
+          negotiate(codec_type, prop["codec.inport_supported"]);
+      }
+    CORBA::Long index(NVUtil::find_index(cprof.properties,
+                                         "dataport.codec_type"));
+    if (index < 0)
+      {
+        CORBA_SeqUtil::push_back(cprof.properties,
+          NVUtil::newNV("dataport.codec_type", codec_type.c_str()));
+      }
+    else
+      {
+        cprof.properties[index].value <<= codec_type.c_str();
+      }
+    RTC_DEBUG(("codec_type: %s (%s)", codec_type.c_str(),
+               agreed ? "agreed" : "requested"));
+
+    // set again in subscribeInterfaces() once the peer has published
+    prop["codec_type"] = agreed ? codec_type :
+      ConnectorCodecChain::negotiate(codec_type,
+                                     ConnectorCodecChain::supported());
+  }
+
   /*!
    * @if jp
    * @brief OutPort provider の生成
@@ -961,6 +1015,13 @@ namespace RTC
                                coil::Properties& prop,
                                InPortConsumer* consumer)
   {
+    // port level rate limit is shared by the connectors of this port
+    if (prop.findNode("publisher.rate_limit.port") != nullptr &&
+        prop["publisher.rate_limit.port.budget"].empty())
+      {
+        prop["publisher.rate_limit.port.budget"] = getName();
+      }
+
 #ifndef ORB_IS_RTORB
     ConnectorInfo profile(cprof.name,
                           cprof.connector_id,
@@ -987,6 +987,45 @@ namespace RTC
      */
     bool checkEndian(const coil::Properties& prop, bool& littleEndian);
 
+    /*!
+     * @if jp
+     * @brief 接続で使用するコーデックを決定する
+     *
+     * 最初に publishInterfaces() を行う Port は、要求するコーデック
+     * (codec_type) を ConnectorProfile の dataport.codec_type に記録す
+     * る。2 番目の Port は双方が対応するコーデックの一覧を知っているた
+     * め、合意したコーデックを dataport.codec_type に記録する。
+     * subscribeInterfaces() では両端ともこの記録された値を使用する。
+     *
+     * 接続相手がまだ公開していない場合、この時点で生成するコネクタには
+     * 要求のうちこのプロセスが対応するコーデックを設定し、
+     * subscribeInterfaces() で合意した値に設定し直す。
+     *
+     * @param cprof ConnectorProfile
+     * @param prop 接続プロパティ。codec_type を生成するコネクタに設定す
+     *             る値に書き換える。
+     *
+     * @else
+     * @brief Select the codecs used by the connection
+     *
+     * The port calling publishInterfaces() first records its requested
+     * codecs (codec_type) in dataport.codec_type of the
+     * ConnectorProfile. The second port knows the codecs supported by
+     * both ends, and records the agreed codecs in dataport.codec_type.
+     * Both ends use this recorded value in subscribeInterfaces().
+     *
+     * If the peer has not published yet, a connector created now gets
+     * the requested codecs this process supports, and is set to the
+     * agreed ones in subscribeInterfaces().
+     *
+     * @param cprof ConnectorProfile
+     * @param prop Connection properties. codec_type is replaced with the
+     *             value for the connector created now.
+     *
+     * @endif
+     */
+    void selectCodecs(ConnectorProfile& cprof, coil::Properties& prop);
+
     /*!
      * @if jp
      * @brief OutPort provider の生成
@@ -32,8 +32,11 @@ namespace RTC
   OutPortConnector::OutPortConnector(ConnectorInfo& info,
                                      ConnectorListeners& listeners)
     : rtclog("OutPortConnector"), m_profile(info), m_littleEndian(true),
-	m_directInPort(nullptr), m_listeners(listeners), m_directMode(false), m_marshaling_type("corba")
+	m_directInPort(nullptr), m_listeners(listeners), m_directMode(false), m_marshaling_type("corba"),
+    m_serializer(nullptr), m_deleteSerializer(nullptr)
   {
+    m_filter.init(info.properties.getNode("filter"));
+    m_codecs.init(info.properties);
   }
 
   /*!
@@ -45,6 +48,10 @@ namespace RTC
    */
   OutPortConnector::~OutPortConnector()
   {
+    if (m_serializer != nullptr)
+      {
+        m_deleteSerializer(m_serializer);
+      }
   }
   /*!
    * @if jp
@@ -120,6 +127,22 @@ namespace RTC
   {
     RTC_TRACE(("setEndian() = %s", endian_type ? "little":"big"));
     m_littleEndian = endian_type;
+    // listeners decode data with this property
+    m_profile.properties["serializer.cdr.endian"] =
+      endian_type ? "little" : "big";
+  }
+
+  /*!
+   * @if jp
+   * @brief コーデック設定
+   * @else
+   * @brief Setting codecs
+   * @endif
+   */
+  void OutPortConnector::setCodecs(const coil::Properties& prop)
+  {
+    RTC_TRACE(("setCodecs(%s)", prop["codec_type"].c_str()));
+    m_codecs.init(prop);
   }
 
   /*!
@@ -187,4 +210,10 @@ namespace RTC
   {
 
   }
+
+  void OutPortConnector::getStatistics(coil::Properties& stat)
+  {
+    m_filter.getStatistics(stat);
+    m_codecs.getStatistics(stat);
+  }
 } // namespace RTC
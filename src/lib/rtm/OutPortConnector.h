@@ -27,6 +27,8 @@
 #include <rtm/PortBase.h>
 #include <rtm/CORBA_CdrMemoryStream.h>
 #include <rtm/ByteData.h>
+#include <rtm/ConnectorDataFilter.h>
+#include <rtm/ConnectorCodec.h>
 
 
 
@@ -180,6 +182,27 @@ namespace RTC
      */
     virtual void setEndian(bool endian_type);
 
+    /*!
+     * @if jp
+     * @brief コーデック設定
+     *
+     * 接続相手とのネゴシエーションで決定した codec_type に従ってコーデッ
+     * クを設定する。
+     *
+     * @param prop コネクタプロファイルのプロパティ
+     *
+     * @else
+     * @brief Setting codecs
+     *
+     * This operation sets the codecs according to codec_type decided by
+     * negotiation with the peer.
+     *
+     * @param prop Connector properties
+     *
+     * @endif
+     */
+    void setCodecs(const coil::Properties& prop);
+
     /*!
      * @if jp
      * @brief endian 設定を返す
@@ -203,18 +226,29 @@ namespace RTC
      * @if jp
      * @brief データ型の変換テンプレート
      *
-     * Timed* から CdrMemoryStream に変換する。
+     * Timed* から CdrMemoryStream に変換する。シリアライザは最初の書き
+     * 込みで生成し、以後はコネクタが破棄されるまで再利用する。1つのコ
+     * ネクタには同じデータ型のみを書き込むこと。
      *
      * @else
      * @brief The conversion template of the data type
      *
-     * This is convert it from Timed* into CdrStream.
+     * This is convert it from Timed* into CdrStream. The serializer is
+     * created on the first write and reused until the connector is
+     * destroyed, so a connector must always be written the same data
+     * type.
      *
      * @endif
      */
     template <class DataType>
     DataPortStatus write(DataType& data)
     {
+      // sender side decimation (filter.* properties)
+      if (!m_filter.pass(data))
+        {
+          RTC_PARANOID(("data discarded by the connector filter."));
+          return DataPortStatus::PORT_OK;
+        }
 
       if (m_directInPort != nullptr)
         {
@@ -243,6 +277,7 @@ namespace RTC
                 connectorData_[ON_BUFFER_WRITE].notifyOut(m_profile, data);
               RTC_PARANOID(("ON_BUFFER_WRITE(InPort,OutPort), "
                                 "callback called in direct mode."));
+              m_filter.commit();
               inport->write(data);  // write to InPort variable!!
               // ON_RECEIVED(In,Out) callback
               m_listeners.
@@ -256,19 +291,37 @@ namespace RTC
             }
         }
       // normal case
-      ::RTC::ByteDataStream<DataType> *cdr = coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().createObject(m_marshaling_type);
-      if (!cdr)
-      {
-          RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
-          return DataPortStatus::PORT_ERROR;
-      }
+      // createObject() allocates the factory's bookkeeping, so it is
+      // called only once per connector
+      if (m_serializer == nullptr)
+        {
+          ::RTC::ByteDataStream<DataType> *obj = coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().createObject(m_marshaling_type);
+          if (!obj)
+          {
+              RTC_ERROR(("Can not find Marshalizer: %s", m_marshaling_type.c_str()));
+              return DataPortStatus::PORT_ERROR;
+          }
+          m_serializer = obj;
+          m_deleteSerializer = [](ByteDataStreamBase* base)
+            {
+              ::RTC::ByteDataStream<DataType> *cdr = static_cast< ::RTC::ByteDataStream<DataType>* >(base);
+              coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().deleteObject(cdr);
+            };
+        }
+      ::RTC::ByteDataStream<DataType> *cdr = static_cast< ::RTC::ByteDataStream<DataType>* >(m_serializer);
       cdr->isLittleEndian(isLittleEndian());
       cdr->serialize(data);
       RTC_TRACE(("connector endian: %s", isLittleEndian() ? "little":"big"));
-      
-      DataPortStatus ret = write((ByteDataStreamBase*)cdr);
-      coil::GlobalFactory < ::RTC::ByteDataStream<DataType> >::instance().deleteObject(cdr);
-      return ret;
+
+      if (!m_filter.passBytes(*cdr))
+        {
+          RTC_PARANOID(("unchanged data discarded by the connector filter."));
+          return DataPortStatus::PORT_OK;
+        }
+      m_filter.commit();
+
+      // the codecs are applied by the concrete connector
+      return write((ByteDataStreamBase*)cdr);
     }
 
     virtual BufferStatus read(ByteData &data);
@@ -313,6 +366,26 @@ namespace RTC
      * @endif
      */
     virtual void unsubscribeInterface(const coil::Properties& prop);
+    /*!
+     * @if jp
+     * @brief コネクタの統計情報を取得する
+     *
+     * フロー制御、レート制限などコネクタ内部の統計情報を引数のプロパティ
+     * に書き込む。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics of the connector
+     *
+     * This operation writes statistics inside the connector, such as
+     * flow control and rate limiting, into the given properties.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    virtual void getStatistics(coil::Properties& stat);
   protected:
     /*!
      * @if jp
@@ -387,6 +460,42 @@ namespace RTC
      */
     std::string m_marshaling_type;
 
+    /*!
+     * @if jp
+     * @brief write() で再利用するシリアライザ
+     * @else
+     * @brief Serializer reused by write()
+     * @endif
+     */
+    ByteDataStreamBase* m_serializer;
+
+    /*!
+     * @if jp
+     * @brief m_serializer を生成したファクトリで破棄する関数
+     * @else
+     * @brief Function to delete m_serializer with its factory
+     * @endif
+     */
+    void (*m_deleteSerializer)(ByteDataStreamBase*);
+
+    /*!
+     * @if jp
+     * @brief 送信側データフィルタ
+     * @else
+     * @brief Sender side data filter
+     * @endif
+     */
+    ConnectorDataFilter m_filter;
+
+    /*!
+     * @if jp
+     * @brief 送信側コーデック
+     * @else
+     * @brief Sender side codecs
+     * @endif
+     */
+    ConnectorCodecChain m_codecs;
+
   };
 } // namespace RTC
 
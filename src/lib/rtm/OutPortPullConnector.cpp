@@ -95,6 +95,18 @@ namespace RTC
         return DataPortStatus::PRECONDITION_NOT_MET;
     }
 
+    // only stateless codecs are used on pull connectors
+    bool encode(!m_codecs.empty());
+    if (encode)
+    {
+        m_encoded = *data;
+        if (!m_codecs.encode(m_encoded))
+        {
+            RTC_ERROR(("encoding failed."));
+            return DataPortStatus::PORT_ERROR;
+        }
+    }
+
     if (m_sync_readwrite)
     {
         {
@@ -106,7 +118,14 @@ namespace RTC
         }
     }
 
-    m_buffer->write(*data);
+    if (encode)
+    {
+        m_buffer->write(m_encoded);
+    }
+    else
+    {
+        m_buffer->write(*data);
+    }
 
     if (m_sync_readwrite)
     {
@@ -183,6 +202,22 @@ namespace RTC
       return ret;
   }
 
+  /*!
+   * @if jp
+   * @brief endianタイプ設定
+   * @else
+   * @brief Setting an endian type
+   * @endif
+   */
+  void OutPortPullConnector::setEndian(bool endian_type)
+  {
+    OutPortConnector::setEndian(endian_type);
+    if (m_provider != nullptr)
+      {
+        m_provider->setListener(m_profile, &m_listeners);
+      }
+  }
+
   /*!
    * @if jp
    * @brief 接続解除関数
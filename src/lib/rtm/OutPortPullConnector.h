@@ -182,6 +182,22 @@ namespace RTC
      */
     DataPortStatus disconnect() override;
 
+    /*!
+     * @if jp
+     * @brief endianタイプ設定
+     *
+     * endianタイプを設定し、プロバイダが保持するコネクタ情報にも反映する
+     *
+     * @else
+     * @brief Setting an endian type
+     *
+     * This operation sets this connector's endian type and reflects it
+     * to the connector information held by the provider.
+     *
+     * @endif
+     */
+    void setEndian(bool endian_type) override;
+
     /*!
      * @if jp
      * @brief Buffer を取得する
@@ -285,6 +301,7 @@ namespace RTC
     CdrBufferBase* m_buffer;
   private:
       bool m_sync_readwrite;
+      ByteData m_encoded;
 
       struct WorkerThreadCtrl
       {
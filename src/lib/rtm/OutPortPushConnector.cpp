@@ -26,6 +26,95 @@
 
 namespace RTC
 {
+  /*!
+   * @if jp
+   * @class OutPortPushConnector::CodecConsumer
+   * @brief 送信時にコーデックを適用する InPortConsumer
+   *
+   * Publisher は間引きやバッファの上書きによりデータを送信しないこと
+   * がある。差分符号化のように直前に送信したフレームを参照するコーデッ
+   * クのため、符号化は Publisher がデータを送信する時点で行う。送信に
+   * 失敗した場合は受信側との同期が失われた可能性があるため、コーデック
+   * の状態をリセットする。
+   *
+   * @else
+   * @class OutPortPushConnector::CodecConsumer
+   * @brief InPortConsumer applying the codecs when data is sent
+   *
+   * A publisher may not send some data because of skipping or buffer
+   * overwrites. For codecs referring to the previously sent frame such
+   * as delta encoding, data is encoded when the publisher sends it. A
+   * failed send resets the codec state since synchronization with the
+   * receiver may have been lost.
+   *
+   * @endif
+   */
+  class OutPortPushConnector::CodecConsumer
+    : public InPortConsumer
+  {
+  public:
+    CodecConsumer(InPortConsumer& consumer, ConnectorCodecChain& codecs)
+      : m_consumer(consumer), m_codecs(codecs)
+    {
+    }
+
+    ~CodecConsumer() override = default;
+
+    void init(coil::Properties& prop) override
+    {
+      m_consumer.init(prop);
+    }
+
+    DataPortStatus put(ByteData& data) override
+    {
+      if (m_codecs.empty()) { return m_consumer.put(data); }
+
+      // the publisher may send the same data again on failure
+      m_encoded = data;
+      if (!m_codecs.encode(m_encoded))
+        {
+          return DataPortStatus::PORT_ERROR;
+        }
+      DataPortStatus ret(m_consumer.put(m_encoded));
+      if (ret != DataPortStatus::PORT_OK)
+        {
+          // the receiver may have missed this frame
+          m_codecs.reset();
+        }
+      return ret;
+    }
+
+    long int getCredit() override
+    {
+      return m_consumer.getCredit();
+    }
+
+    long int refreshCredit() override
+    {
+      return m_consumer.refreshCredit();
+    }
+
+    void publishInterfaceProfile(SDOPackage::NVList& properties) override
+    {
+      m_consumer.publishInterfaceProfile(properties);
+    }
+
+    bool subscribeInterface(const SDOPackage::NVList& properties) override
+    {
+      return m_consumer.subscribeInterface(properties);
+    }
+
+    void unsubscribeInterface(const SDOPackage::NVList& properties) override
+    {
+      m_consumer.unsubscribeInterface(properties);
+    }
+
+  private:
+    InPortConsumer& m_consumer;
+    ConnectorCodecChain& m_codecs;
+    ByteData m_encoded;
+  };
+
   /*!
    * @if jp
    * @brief コンストラクタ
@@ -56,7 +145,8 @@ namespace RTC
     m_buffer->init(info.properties.getNode("buffer"));
     m_consumer->init(info.properties);
 
-    m_publisher->setConsumer(m_consumer);
+    m_codecConsumer.reset(new CodecConsumer(*m_consumer, m_codecs));
+    m_publisher->setConsumer(m_codecConsumer.get());
     m_publisher->setBuffer(m_buffer);
     m_publisher->setListener(m_profile, &m_listeners);
 
@@ -114,6 +204,7 @@ namespace RTC
         pfactory.deleteObject(m_publisher);
       }
     m_publisher = nullptr;
+    m_codecConsumer.reset();
 
     // delete consumer
     if (m_consumer != nullptr)
@@ -252,5 +343,21 @@ namespace RTC
           m_consumer->unsubscribeInterface(nv);
       }
   }
+
+  /*!
+   * @if jp
+   * @brief コネクタの統計情報を取得する
+   * @else
+   * @brief Get statistics of the connector
+   * @endif
+   */
+  void OutPortPushConnector::getStatistics(coil::Properties& stat)
+  {
+    OutPortConnector::getStatistics(stat);
+    if (m_publisher != nullptr)
+      {
+        m_publisher->getStatistics(stat);
+      }
+  }
 } // namespace RTC
 
@@ -24,6 +24,8 @@
 #include <rtm/InPortConsumer.h>
 #include <rtm/PublisherBase.h>
 
+#include <memory>
+
 namespace RTC
 {
   class ConnectorListeners;
@@ -269,6 +271,26 @@ namespace RTC
      */
     void unsubscribeInterface(const coil::Properties& prop) override;
 
+    /*!
+     * @if jp
+     * @brief コネクタの統計情報を取得する
+     *
+     * Publisher の統計情報を引数のプロパティに書き込む。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics of the connector
+     *
+     * This operation writes the publisher's statistics into the given
+     * properties.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) override;
+
   protected:
     /*!
      * @if jp
@@ -331,6 +353,8 @@ namespace RTC
     void onDisconnect();
 
   private:
+    class CodecConsumer;
+
     /*!
      * @if jp
      * @brief InPortConsumer へのポインタ
@@ -340,6 +364,23 @@ namespace RTC
      */
     InPortConsumer* m_consumer;
 
+    /*!
+     * @if jp
+     * @brief 送信時に符号化する InPortConsumer
+     *
+     * Publisher が実際に送信するデータのみを符号化するため、Publisher
+     * には m_consumer の代わりにこれを渡す。
+     *
+     * @else
+     * @brief InPortConsumer encoding data when it is sent
+     *
+     * This is passed to the publisher instead of m_consumer, so that
+     * only the data the publisher actually sends is encoded.
+     *
+     * @endif
+     */
+    std::unique_ptr<CodecConsumer> m_codecConsumer;
+
     /*!
      * @if jp
      * @brief Publisher へのポインタ
@@ -0,0 +1,247 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ParallelExecutionContext.cpp
+ * @brief ExecutionContext executing independent components in parallel
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/ParallelExecutionContext.h>
+#include <rtm/RTObjectStateMachine.h>
+#include <rtm/PortBase.h>
+#include <rtm/NVUtil.h>
+#include <coil/stringutil.h>
+
+#include <thread>
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @brief デフォルトコンストラクタ
+   * @else
+   * @brief Default constructor
+   * @endif
+   */
+  ParallelExecutionContext::ParallelExecutionContext()
+    : PeriodicExecutionContext(), m_revision(0), m_phase(PRE_DO),
+      m_cycleCriticalPath(0), m_criticalPath(0)
+  {
+    RTC_TRACE(("ParallelExecutionContext()"));
+    m_task = [this](size_t node) { executeNode(node); };
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  ParallelExecutionContext::~ParallelExecutionContext()
+  {
+    RTC_TRACE(("~ParallelExecutionContext()"));
+    // the thread must stop before the executor is destroyed
+    {
+      std::lock_guard<std::mutex> guard(m_svcmutex);
+      m_svc = false;
+    }
+    {
+      std::lock_guard<std::mutex> guard(m_workerthread.mutex_);
+      m_workerthread.running_ = true;
+      m_workerthread.cond_.notify_one();
+    }
+    wait();
+  }
+
+  void ParallelExecutionContext::init(coil::Properties& props)
+  {
+    RTC_TRACE(("init()"));
+    PeriodicExecutionContext::init(props);
+
+    unsigned int threads(0);
+    getProperty(props, "threads", threads);
+    if (threads == 0) { threads = std::thread::hardware_concurrency(); }
+    if (threads == 0) { threads = 1; }
+    m_executor.reset(new RTC::TaskGraphExecutor(threads));
+
+    // rebuilt by the next cycle
+    m_nodes.clear();
+
+    RTC_DEBUG(("threads: %u", threads));
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行タイミングの統計を消去する
+   * @else
+   * @brief Clear the timing statistics
+   * @endif
+   */
+  void ParallelExecutionContext::resetStatistics()
+  {
+    PeriodicExecutionContext::resetStatistics();
+    m_criticalPathHistogram.reset();
+  }
+
+  /*!
+   * @if jp
+   * @brief 直前の周期のクリティカルパスの長さを取得する
+   * @else
+   * @brief Get the length of the critical path of the last cycle
+   * @endif
+   */
+  std::chrono::nanoseconds ParallelExecutionContext::getCriticalPath() const
+  {
+    return std::chrono::nanoseconds(m_criticalPath.load());
+  }
+
+  void ParallelExecutionContext::runWorkerPreDo()
+  {
+    m_cycleCriticalPath = std::chrono::nanoseconds::zero();
+    runPhase(PRE_DO);
+  }
+
+  void ParallelExecutionContext::runWorkerDo()
+  {
+    runPhase(DO);
+  }
+
+  void ParallelExecutionContext::runWorkerPostDo()
+  {
+    runPhase(POST_DO);
+    m_criticalPath = m_cycleCriticalPath.count();
+    if (m_statistics) { m_criticalPathHistogram.record(m_cycleCriticalPath); }
+    // m_nodes might be changed here
+    m_worker.invokeWorkerUpdate();
+  }
+
+  /*!
+   * @brief onGetProfile() template function
+   */
+  RTC::ExecutionContextProfile* ParallelExecutionContext::
+  onGetProfile(RTC::ExecutionContextProfile*& profile)
+  {
+    if (m_statistics)
+      {
+        coil::Properties stat;
+        m_criticalPathHistogram.toProperties(stat,
+                                             "statistics.critical_path");
+        SDOPackage::NVList nv;
+        NVUtil::copyFromProperties(nv, stat);
+        NVUtil::append(profile->properties, nv);
+      }
+    return PeriodicExecutionContext::onGetProfile(profile);
+  }
+
+  /*!
+   * @if jp
+   * @brief すべてのコンポーネントの一つの段階を実行する
+   * @else
+   * @brief Execute a phase of all components
+   * @endif
+   */
+  void ParallelExecutionContext::runPhase(Phase phase)
+  {
+    if (!m_executor)
+      {
+        // not initialized yet
+        switch (phase)
+          {
+          case PRE_DO:  ExecutionContextBase::invokeWorkerPreDo();  break;
+          case DO:      ExecutionContextBase::invokeWorkerDo();     break;
+          case POST_DO: ExecutionContextBase::invokeWorkerPostDo(); break;
+          }
+        return;
+      }
+    // the list may be changed by adding or removing while stopped
+    updateGraph();
+    m_phase = phase;
+    m_executor->run(m_graph, m_task);
+    m_cycleCriticalPath += m_graph.getCriticalPath(m_cost);
+  }
+
+  /*!
+   * @if jp
+   * @brief 一つのコンポーネントの現在の段階を実行する
+   * @else
+   * @brief Execute the current phase of a component
+   * @endif
+   */
+  void ParallelExecutionContext::executeNode(size_t node)
+  {
+    RTC_impl::RTObjectStateMachine* comp(m_nodes[node]);
+    // components of a rate group only change state outside their cycles
+    if (m_phase != PRE_DO && !m_worker.isScheduled(node))
+      {
+        m_cost[node] = std::chrono::nanoseconds::zero();
+        return;
+      }
+    auto start = std::chrono::steady_clock::now();
+    switch (m_phase)
+      {
+      case PRE_DO:  comp->workerPreDo();  break;
+      case DO:      comp->workerDo();     break;
+      case POST_DO: comp->workerPostDo(); break;
+      }
+    m_cost[node] = std::chrono::steady_clock::now() - start;
+    if (m_phase != PRE_DO) { m_worker.addExecTime(node, m_cost[node]); }
+  }
+
+  /*!
+   * @if jp
+   * @brief 参加コンポーネントか接続が変わっていればグラフを作り直す
+   * @else
+   * @brief Rebuild the graph if the participants or connections changed
+   * @endif
+   */
+  void ParallelExecutionContext::updateGraph()
+  {
+    const std::vector<RTC_impl::RTObjectStateMachine*>&
+      comps(m_worker.getComponentList());
+    // read first not to miss connections made while building
+    unsigned long revision(RTC::PortBase::getConnectionRevision());
+    if (comps == m_nodes && revision == m_revision) { return; }
+
+    RTC_TRACE(("updateGraph()"));
+    m_nodes = comps;
+    m_revision = revision;
+    m_cost.assign(m_nodes.size(), std::chrono::nanoseconds::zero());
+    size_t dropped(m_worker.buildDependencyGraph(m_graph));
+    if (dropped != 0)
+      {
+        RTC_WARN(("%lu dependencies were ignored because of cycles.",
+                  static_cast<unsigned long>(dropped)));
+      }
+    RTC_DEBUG(("Dependency graph of %lu components updated.",
+               static_cast<unsigned long>(m_nodes.size())));
+  }
+} // namespace RTC_exp
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void ParallelExecutionContextInit(RTC::Manager*  /*manager*/)
+  {
+    RTC::ExecutionContextFactory::
+      instance().addFactory("ParallelExecutionContext",
+                            ::coil::Creator< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::ParallelExecutionContext>,
+                            ::coil::Destructor< ::RTC::ExecutionContextBase,
+                            ::RTC_exp::ParallelExecutionContext>);
+  }
+}
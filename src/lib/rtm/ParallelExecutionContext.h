@@ -0,0 +1,224 @@
+﻿// -*- C++ -*-
+/*!
+ * @file ParallelExecutionContext.h
+ * @brief ExecutionContext executing independent components in parallel
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_PARALLELEXECUTIONCONTEXT_H
+#define RTC_PARALLELEXECUTIONCONTEXT_H
+
+#include <rtm/PeriodicExecutionContext.h>
+#include <rtm/TaskGraph.h>
+#include <rtm/TimingHistogram.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace RTC_exp
+{
+  /*!
+   * @if jp
+   * @class ParallelExecutionContext
+   * @brief 依存関係のないコンポーネントを並列に実行する ExecutionContext
+   *
+   * 参加コンポーネント間のデータポートの接続から依存関係グラフを作成し、
+   * 依存関係のないコンポーネントを複数のスレッドで同時に実行する周期実
+   * 行 ExecutionContext。データを出力するコンポーネントは受け取るコン
+   * ポーネントより先に実行される。PreDo, Do, PostDo の各段階はすべての
+   * コンポーネントが終わってから次の段階に進む。
+   *
+   * 以下のプロパティを exec_cxt.periodic 以下に指定する。
+   *
+   * - threads: コンポーネントを実行するスレッド数。ExecutionContext の
+   *            スレッドを含む。0 の場合は CPU のコア数。デフォルトは 0。
+   * - order: "A>B>C" 形式のインスタンス名の列のカンマ区切りリスト。列
+   *          の順に実行する制約を接続による依存関係より優先して与える。
+   *
+   * 依存関係グラフは参加コンポーネントまたはプロセス内の接続が変わると
+   * 作り直される。閉路を作る依存関係は無視され警告が出力される。
+   *
+   * 各周期のクリティカルパスの長さ (依存関係をたどる実行時間の和の最大
+   * 値を段階ごとに合計したもの) は statistics.critical_path 以下にプロ
+   * ファイルの properties として出力される。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class ParallelExecutionContext
+   * @brief ExecutionContext executing independent components in parallel
+   *
+   * This periodic ExecutionContext builds a dependency graph from the
+   * data port connections between the participating components and
+   * executes components without a dependency between them on multiple
+   * threads at the same time. A component writing data is executed
+   * before the components receiving it. Each of the PreDo, Do and
+   * PostDo phases finishes for all components before the next phase
+   * starts.
+   *
+   * The following properties are given under exec_cxt.periodic.
+   *
+   * - threads: The number of threads executing the components including
+   *            the thread of the ExecutionContext. The number of CPU
+   *            cores if 0. The default is 0.
+   * - order: Comma separated list of sequences of instance names in the
+   *          form "A>B>C". They constrain the components to be executed
+   *          in the order of the sequence, taking priority over the
+   *          dependencies by connections.
+   *
+   * The dependency graph is rebuilt when the participating components
+   * or the connections in the process change. Dependencies which make a
+   * cycle are ignored and reported as warnings.
+   *
+   * The length of the critical path of each cycle, which is the
+   * maximum sum of the execution times along the dependencies summed
+   * over the phases, is output under statistics.critical_path in the
+   * properties of the profile.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class ParallelExecutionContext
+    : public virtual RTC_exp::PeriodicExecutionContext
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief デフォルトコンストラクタ
+     * @else
+     * @brief Default Constructor
+     * @endif
+     */
+    ParallelExecutionContext();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~ParallelExecutionContext() override;
+
+    /*!
+     * @if jp
+     * @brief ExecutionContextの初期化を行う
+     * @else
+     * @brief Initialize the ExecutionContext
+     * @endif
+     */
+    void init(coil::Properties& props) override;
+
+    /*!
+     * @if jp
+     * @brief 実行タイミングの統計を消去する
+     * @else
+     * @brief Clear the timing statistics
+     * @endif
+     */
+    void resetStatistics() override;
+
+    /*!
+     * @if jp
+     * @brief 直前の周期のクリティカルパスの長さを取得する
+     * @return クリティカルパスの長さ
+     * @else
+     * @brief Get the length of the critical path of the last cycle
+     * @return The length of the critical path
+     * @endif
+     */
+    std::chrono::nanoseconds getCriticalPath() const;
+
+  protected:
+    void runWorkerPreDo() override;
+    void runWorkerDo() override;
+    void runWorkerPostDo() override;
+    RTC::ExecutionContextProfile*
+    onGetProfile(RTC::ExecutionContextProfile*& profile) override;
+
+    /*!
+     * @if jp
+     * @brief 実行の段階
+     * @else
+     * @brief Phase of execution
+     * @endif
+     */
+    enum Phase
+      {
+        PRE_DO,
+        DO,
+        POST_DO
+      };
+
+    /*!
+     * @if jp
+     * @brief すべてのコンポーネントの一つの段階を実行する
+     * @param phase 実行する段階
+     * @else
+     * @brief Execute a phase of all components
+     * @param phase The phase to execute
+     * @endif
+     */
+    void runPhase(Phase phase);
+
+    /*!
+     * @if jp
+     * @brief 一つのコンポーネントの現在の段階を実行する
+     * @param node コンポーネントのノード番号
+     * @else
+     * @brief Execute the current phase of a component
+     * @param node The node number of the component
+     * @endif
+     */
+    void executeNode(size_t node);
+
+    /*!
+     * @if jp
+     * @brief 参加コンポーネントか接続が変わっていればグラフを作り直す
+     * @else
+     * @brief Rebuild the graph if the participants or connections changed
+     * @endif
+     */
+    void updateGraph();
+
+    std::unique_ptr<RTC::TaskGraphExecutor> m_executor;
+    RTC::TaskGraph m_graph;
+    // the participants and the connection revision of m_graph
+    std::vector<RTC_impl::RTObjectStateMachine*> m_nodes;
+    unsigned long m_revision;
+    Phase m_phase;
+    std::function<void(size_t)> m_task;
+    std::vector<std::chrono::nanoseconds> m_cost;
+    std::chrono::nanoseconds m_cycleCriticalPath;
+    std::atomic<long long> m_criticalPath;
+    RTC::TimingHistogram m_criticalPathHistogram;
+  };  // class ParallelExecutionContext
+} // namespace RTC_exp
+
+
+extern "C"
+{
+  /*!
+   * @if jp
+   * @brief ECFactoryへの登録のための初期化関数
+   * @else
+   * @brief Initialization function to register to ECFactory
+   * @endif
+   */
+  void ParallelExecutionContextInit(RTC::Manager* manager);
+}
+
+#endif  // RTC_PARALLELEXECUTIONCONTEXT_H
@@ -18,13 +18,20 @@
 
 #include <rtm/PeriodicExecutionContext.h>
 #include <rtm/RTObjectStateMachine.h>
+#include <rtm/NVUtil.h>
 
 #include <cstring>
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <thread>
 
 #define DEEFAULT_PERIOD 0.000001
+namespace
+{
+  using SteadyClock = RTC::DeadlineTimer::Clock;
+} // namespace
+
 namespace RTC_exp
 {
   /*!
@@ -38,7 +45,8 @@ namespace RTC_exp
   PeriodicExecutionContext()
     : ExecutionContextBase("periodic_ec"),
       rtclog("periodic_ec"),
-      m_svc(false), m_nowait(false)
+      m_svc(false), m_nowait(false),
+      m_overrunPolicy(SKIP)
   {
     RTC_TRACE(("PeriodicExecutionContext()"));
 
@@ -80,10 +88,31 @@ namespace RTC_exp
     ExecutionContextBase::init(props);
 
     setCpuAffinity(props);
+    setTiming(props);
+
+    std::string policy(props.getProperty("overrun_policy", "skip"));
+    coil::normalize(policy);
+    if (policy == "catch_up")     { m_overrunPolicy = CATCH_UP; }
+    else if (policy == "rephase") { m_overrunPolicy = REPHASE; }
+    else                          { m_overrunPolicy = SKIP; }
+    RTC_DEBUG(("overrun_policy: %s", policy.c_str()));
 
     RTC_DEBUG(("init() done"));
   }
 
+  /*!
+   * @if jp
+   * @brief 実行タイミングの統計を消去する
+   * @else
+   * @brief Clear the timing statistics
+   * @endif
+   */
+  void PeriodicExecutionContext::resetStatistics()
+  {
+    ExecutionContextBase::resetStatistics();
+    m_timer.resetStatistics();
+  }
+
   /*------------------------------------------------------------
    * Start activity
    * ACE_Task class method over ride.
@@ -150,10 +179,18 @@ namespace RTC_exp
     {
         RTC_DEBUG(("cpu affinity is not set"));
     }
+    if (m_timer.getMode() == RTC::DeadlineTimer::HYBRID && m_cpu.empty())
+      {
+        RTC_WARN(("hybrid timing spins without a dedicated CPU"));
+      }
 
+    // cycles start at m_next + n * period from the epoch set here
+    bool rephase(true);
+    std::chrono::nanoseconds period(getPeriod());
+    SteadyClock::time_point next;
     do
       {
-        ExecutionContextBase::invokeWorkerPreDo();
+        runWorkerPreDo();
         // Thread will stopped when all RTCs are INACTIVE.
         // Therefore WorkerPreDo(updating state) have to be invoked
         // before stopping thread.
@@ -162,36 +199,84 @@ namespace RTC_exp
           while (!m_workerthread.running_)
             {
               m_workerthread.cond_.wait(guard);
+              rephase = true;
             }
         }
-        auto t0 = std::chrono::high_resolution_clock::now();
-        ExecutionContextBase::invokeWorkerDo();
-        ExecutionContextBase::invokeWorkerPostDo();
-        auto t1 = std::chrono::high_resolution_clock::now();
+        if (getPeriod() != period)
+          {
+            period = getPeriod();
+            rephase = true;
+          }
+        bool rephased(rephase);
+        if (rephase)
+          {
+            next = SteadyClock::now();
+            rephase = false;
+          }
+        auto t0 = SteadyClock::now();
+        if (m_statistics && !rephased) { m_jitter.record(t0 - next); }
+        runWorkerDo();
+        runWorkerPostDo();
+        auto t1 = SteadyClock::now();
 
-        auto period = getPeriod();
-        auto rest = period - (t1 - t0);
+        auto deadline = next + period;
         if (count > 1000)
           {
             RTC_PARANOID(("Period:    %f [s]", std::chrono::duration<double>(period).count()));
             RTC_PARANOID(("Execution: %f [s]", std::chrono::duration<double>(t1 - t0).count()));
-            RTC_PARANOID(("Sleep:     %f [s]", std::chrono::duration<double>(rest).count()));
+            RTC_PARANOID(("Sleep:     %f [s]", std::chrono::duration<double>(deadline - t1).count()));
           }
-        auto t2 = std::chrono::high_resolution_clock::now();
-        if (!m_nowait && (rest > std::chrono::seconds::zero()))
+        if (m_nowait)
           {
+            rephase = true;
+          }
+        else if (t1 <= deadline)
+          {
+            next = deadline;
             if (count > 1000) { RTC_PARANOID(("sleeping...")); }
-            std::this_thread::sleep_until(t0 + period);
+            m_timer.sleepUntil(next);
+            if (m_statistics)
+              {
+                m_wakeupLatency.record(SteadyClock::now() - next);
+              }
+          }
+        else
+          {
+            ++m_missedDeadlines;
+            auto late = t1 - deadline;
+            RTC_PARANOID(("Deadline missed by %f [s]",
+                          std::chrono::duration<double>(late).count()));
+            switch (m_overrunPolicy)
+              {
+              case CATCH_UP:
+                // start the missed cycles at once
+                next = deadline;
+                break;
+              case REPHASE:
+                next = t1;
+                break;
+              case SKIP:
+              default:
+                // the first cycle of the original phase after now
+                next = deadline + period * (late / period + 1);
+                m_timer.sleepUntil(next);
+                if (m_statistics)
+                  {
+                    m_wakeupLatency.record(SteadyClock::now() - next);
+                  }
+                break;
+              }
           }
         if (count > 1000)
           {
-            auto t3 = std::chrono::high_resolution_clock::now();
-            RTC_PARANOID(("Slept:     %f [s]", std::chrono::duration<double>(t3 - t2).count()));
+            auto t3 = SteadyClock::now();
+            RTC_PARANOID(("Slept:     %f [s]", std::chrono::duration<double>(t3 - t1).count()));
+            RTC_PARANOID(("Missed:    %lu", m_missedDeadlines.load()));
             count = 0;
           }
         ++count;
       } while (threadRunning());
-      
+
     RTC_DEBUG(("Thread terminated."));
     return 0;
   }
@@ -211,6 +296,27 @@ namespace RTC_exp
     return 0;
   }
 
+  /*!
+   * @if jp
+   * @brief コンポーネントの処理を実行する
+   * @else
+   * @brief Invoke the workers of the components
+   * @endif
+   */
+  void PeriodicExecutionContext::runWorkerPreDo()
+  {
+    ExecutionContextBase::invokeWorkerPreDo();
+  }
+
+  void PeriodicExecutionContext::runWorkerDo()
+  {
+    ExecutionContextBase::invokeWorkerDo();
+  }
+
+  void PeriodicExecutionContext::runWorkerPostDo()
+  {
+    ExecutionContextBase::invokeWorkerPostDo();
+  }
 
   //============================================================
   // ExecutionContext CORBA operations
@@ -595,6 +701,23 @@ namespace RTC_exp
     return RTC::RTC_OK;
   }
 
+  /*!
+   * @brief onGetProfile() template function
+   */
+  RTC::ExecutionContextProfile* PeriodicExecutionContext::
+  onGetProfile(RTC::ExecutionContextProfile*& profile)
+  {
+    if (m_statistics)
+      {
+        coil::Properties stat;
+        m_timer.toProperties(stat, "statistics.timer");
+        SDOPackage::NVList nv;
+        NVUtil::copyFromProperties(nv, stat);
+        NVUtil::append(profile->properties, nv);
+      }
+    return ExecutionContextBase::onGetProfile(profile);
+  }
+
   void PeriodicExecutionContext::setCpuAffinity(coil::Properties& props)
   {
     RTC_TRACE(("setCpuAffinity()"));
@@ -616,6 +739,31 @@ namespace RTC_exp
       }
   }
 
+  void PeriodicExecutionContext::setTiming(coil::Properties& props)
+  {
+    RTC_TRACE(("setTiming()"));
+    std::string timing(props.getProperty("timing", "sleep"));
+    coil::normalize(timing);
+    double margin(0.0001);
+    double max_margin(0.001);
+    getProperty(props, "timing.spin_margin", margin);
+    getProperty(props, "timing.max_spin_margin", max_margin);
+    bool yield(coil::toBool(props["timing.yield"], "YES", "NO", false));
+
+    using Seconds = std::chrono::duration<double>;
+    m_timer.setMode(timing == "hybrid" ?
+                    RTC::DeadlineTimer::HYBRID : RTC::DeadlineTimer::SLEEP,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      Seconds(margin)),
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      Seconds(max_margin)),
+                    yield);
+    RTC_DEBUG(("timing: %s", timing.c_str()));
+    RTC_DEBUG(("timing.spin_margin: %f [s]", margin));
+    RTC_DEBUG(("timing.max_spin_margin: %f [s]", max_margin));
+    RTC_DEBUG(("timing.yield: %s", yield ? "YES" : "NO"));
+  }
+
 } // namespace RTC_exp
 
 extern "C"
@@ -24,7 +24,9 @@
 #include <coil/Affinity.h>
 
 #include <rtm/ExecutionContextBase.h>
+#include <rtm/DeadlineTimer.h>
 
+#include <chrono>
 #include <vector>
 #include <iostream>
 
@@ -110,6 +112,15 @@ namespace RTC_exp
      */
      void init(coil::Properties& props) override;
 
+    /*!
+     * @if jp
+     * @brief 実行タイミングの統計を消去する
+     * @else
+     * @brief Clear the timing statistics
+     * @endif
+     */
+    void resetStatistics() override;
+
     /*!
      * @if jp
      * @brief ExecutionContext用アクティビティスレッドを生成する
@@ -186,6 +197,42 @@ namespace RTC_exp
      */
     int close(unsigned long flags) override;
 
+    /*!
+     * @if jp
+     * @brief デッドラインを過ぎた場合の動作
+     *
+     * 実行がデッドラインを過ぎた場合の次の周期の開始時刻を決める。
+     * overrun_policy プロパティで指定する。
+     *
+     * - SKIP (skip): 過ぎた周期を飛ばし、元の位相の次の周期から実行す
+     *                る。デフォルト。
+     * - CATCH_UP (catch_up): 過ぎた周期を待たずに続けて実行し、元の位相
+     *                        に追いつく。
+     * - REPHASE (rephase): 現在時刻を新たな起点として周期を数え直す。
+     *
+     * @else
+     * @brief Behavior when a deadline is missed
+     *
+     * This decides the start of the next cycle when an execution
+     * finishes after its deadline. It is given by the overrun_policy
+     * property.
+     *
+     * - SKIP (skip): The missed cycles are skipped and the next cycle
+     *                of the original phase is executed. The default.
+     * - CATCH_UP (catch_up): The missed cycles are executed back to
+     *                        back until the original phase is reached.
+     * - REPHASE (rephase): The cycles are counted again from the
+     *                      current time.
+     *
+     * @endif
+     */
+    enum OverrunPolicy
+      {
+        SKIP,
+        CATCH_UP,
+        REPHASE
+      };
+
     //============================================================
     // ExecutionContext
     //============================================================
@@ -631,11 +678,60 @@ namespace RTC_exp
     RTC::ReturnCode_t
     onReset(RTC_impl::RTObjectStateMachine* comp, long int count) override;
 
+    /*!
+     * @brief onGetProfile() template function
+     */
+    RTC::ExecutionContextProfile*
+    onGetProfile(RTC::ExecutionContextProfile*& profile) override;
+
     /*!
      * @brief setting CPU affinity from given properties
      */
     virtual void setCpuAffinity(coil::Properties& props);
 
+    /*!
+     * @if jp
+     * @brief 周期の待機方法をプロパティから設定する
+     *
+     * timing が hybrid の場合、デッドラインの直前までスリープし、残りを
+     * スピンする。スピンマージンの初期値と上限は timing.spin_margin と
+     * timing.max_spin_margin [s] で指定する。timing.yield が YES の場
+     * 合、スピン中にスレッドを譲る。
+     *
+     * @else
+     * @brief Set how to wait for the period from given properties
+     *
+     * If timing is hybrid, the thread sleeps until shortly before the
+     * deadline and spins the rest. The initial value and the upper
+     * limit of the spin margin are given by timing.spin_margin and
+     * timing.max_spin_margin [s]. If timing.yield is YES, the thread
+     * yields while spinning.
+     *
+     * @endif
+     */
+    virtual void setTiming(coil::Properties& props);
+
+    /*!
+     * @if jp
+     * @brief コンポーネントの処理を実行する
+     *
+     * svc() から周期ごとに呼ばれ、参加コンポーネントの PreDo, Do,
+     * PostDo をそれぞれ実行する。派生クラスはコンポーネントの実行方法
+     * を変えるためにオーバーライドできる。
+     *
+     * @else
+     * @brief Invoke the workers of the components
+     *
+     * svc() calls these every cycle to run PreDo, Do and PostDo of the
+     * participating components. Derived classes can override them to
+     * change how the components are executed.
+     *
+     * @endif
+     */
+    virtual void runWorkerPreDo();
+    virtual void runWorkerDo();
+    virtual void runWorkerPostDo();
+
     bool threadRunning()
     {
       std::lock_guard<std::mutex> guard(m_svcmutex);
@@ -700,6 +796,24 @@ namespace RTC_exp
      */
     coil::CpuMask m_cpu;
 
+    /*!
+     * @if jp
+     * @brief デッドラインを過ぎた場合の動作
+     * @else
+     * @brief Behavior when a deadline is missed
+     * @endif
+     */
+    OverrunPolicy m_overrunPolicy;
+
+    /*!
+     * @if jp
+     * @brief 周期の待機に使用するタイマー
+     * @else
+     * @brief Timer to wait for the period
+     * @endif
+     */
+    RTC::DeadlineTimer m_timer;
+
   };  // class PeriodicExecutionContext
 } // namespace RTC_exp
 
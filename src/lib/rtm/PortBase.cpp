@@ -17,6 +17,8 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <coil/UUID.h>
@@ -24,6 +26,18 @@
 #include <rtm/PortCallback.h>
 #include <rtm/CORBA_RTCUtil.h>
 
+namespace
+{
+  bool isHostLittleEndian()
+  {
+    const unsigned short v(1);
+    return *reinterpret_cast<const unsigned char*>(&v) == 1;
+  }
+
+  // incremented on every connection and disconnection in the process
+  std::atomic<unsigned long> connectionRevision(0);
+} // namespace
+
 namespace RTC
 {
   //============================================================
@@ -263,6 +277,8 @@ namespace RTC
 
     onNotifyConnect(getName(), connector_profile);
 
+    publishNativeEndian(connector_profile);
+
     // publish owned interface information to the ConnectorProfile
     retval[0] = publishInterfaces(connector_profile);
     if (retval[0] != RTC::RTC_OK)
@@ -284,6 +300,9 @@ namespace RTC
       }
     onConnectNextport(getName(), connector_profile, retval[1]);
 
+    // all the ports have published their byte order here
+    selectEndian(connector_profile);
+
     // subscribe interface from the ConnectorProfile's information
 
     if (m_onSubscribeInterfaces != nullptr)
@@ -314,6 +333,7 @@ namespace RTC
         m_profile.connector_profiles[index] = connector_profile;
         RTC_PARANOID(("Existing connector_id. Updated."));
       }
+    ++connectionRevision;
 
     for (int i(0), len(sizeof(retval)/sizeof(ReturnCode_t)); i < len; ++i)
       {
@@ -471,6 +491,7 @@ namespace RTC
         m_profile.connector_profiles._length = len-1;
       }
 #endif  // ORB_IS_RTORB
+    ++connectionRevision;
     onDisconnected(getName(), prof, retval);
     return retval;
   }
@@ -583,6 +604,18 @@ namespace RTC
 #endif
   }
 
+  /*!
+   * @if jp
+   * @brief プロセス内の接続のリビジョンを取得する
+   * @else
+   * @brief Get the revision of the connections in the process
+   * @endif
+   */
+  unsigned long PortBase::getConnectionRevision()
+  {
+    return connectionRevision.load();
+  }
+
   /*!
    * @if jp
    * @brief Port の owner の RTObject を指定する
@@ -993,6 +1026,78 @@ namespace RTC
     return true;
   }
 
+  /*!
+   * @if jp
+   * @brief ホストのバイトオーダーを公開する
+   * @else
+   * @brief Publish the byte order of the host
+   * @endif
+   */
+  void PortBase::publishNativeEndian(ConnectorProfile& connector_profile)
+  {
+    // only data port connections have the endian property
+    if (NVUtil::find_index(connector_profile.properties,
+                           "dataport.serializer.cdr.endian") < 0)
+      {
+        return;
+      }
+    const char* native(isHostLittleEndian() ? "little" : "big");
+
+    CORBA::Long index(NVUtil::find_index(connector_profile.properties,
+                                   "dataport.serializer.cdr.native_endian"));
+    if (index < 0)
+      {
+        CORBA_SeqUtil::push_back(connector_profile.properties,
+          NVUtil::newNV("dataport.serializer.cdr.native_endian", native));
+        return;
+      }
+    // appendStringValue() cannot be used since it drops duplicates
+    std::string value(NVUtil::toString(connector_profile.properties,
+                                       "dataport.serializer.cdr.native_endian"));
+    value.append(",");
+    value.append(native);
+    connector_profile.properties[index].value <<= value.c_str();
+  }
+
+  /*!
+   * @if jp
+   * @brief 接続で使用するバイトオーダーを決定する
+   * @else
+   * @brief Select the byte order used by the connection
+   * @endif
+   */
+  void PortBase::selectEndian(ConnectorProfile& connector_profile)
+  {
+    CORBA::Long index(NVUtil::find_index(connector_profile.properties,
+                                         "dataport.serializer.cdr.endian"));
+    if (index < 0) { return; }
+
+    std::string endian_type(NVUtil::toString(connector_profile.properties,
+                                        "dataport.serializer.cdr.endian"));
+    coil::normalize(endian_type);
+    coil::vstring allowed(coil::split(endian_type, ","));
+    if (allowed.empty()) { return; }
+
+    std::string native_type(NVUtil::toString(connector_profile.properties,
+                                  "dataport.serializer.cdr.native_endian"));
+    coil::normalize(native_type);
+    coil::vstring natives(coil::split(native_type, ","));
+
+    std::string selected(allowed[0]);
+    if (!natives.empty() &&
+        natives.size() == connector_profile.ports.length() &&
+        std::count(natives.begin(), natives.end(), natives[0]) ==
+        static_cast<std::ptrdiff_t>(natives.size()) &&
+        std::find(allowed.begin(), allowed.end(), natives[0]) !=
+        allowed.end())
+      {
+        selected = natives[0];
+      }
+    RTC_DEBUG(("endian: %s (allowed: %s, native: %s)", selected.c_str(),
+               endian_type.c_str(), native_type.c_str()));
+    connector_profile.properties[index].value <<= selected.c_str();
+  }
+
 
 
 
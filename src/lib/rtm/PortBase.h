@@ -971,6 +971,32 @@ namespace RTC
      */
     void setOwner(RTObject_ptr owner);
 
+    /*!
+     * @if jp
+     *
+     * @brief プロセス内の接続のリビジョンを取得する
+     *
+     * このプロセス内のいずれかの Port で接続が確立または解除されるた
+     * びに増加する値を返す。コンポーネント間の接続関係のキャッシュが古
+     * くなったかどうかの判定に使用する。
+     *
+     * @return 接続のリビジョン
+     *
+     * @else
+     *
+     * @brief Get the revision of the connections in the process
+     *
+     * This returns a value which is incremented whenever a connection
+     * of any Port in this process is established or released. It is
+     * used to check whether a cache of the connections between
+     * components is outdated.
+     *
+     * @return The revision of the connections
+     *
+     * @endif
+     */
+    static unsigned long getConnectionRevision();
+
     //============================================================
     // callbacks
     //============================================================
@@ -1960,6 +1986,73 @@ namespace RTC
     bool checkPorts(RTC_PortServiceList& ports);
 #endif  // ORB_IS_RTORB
 
+    /*!
+     * @if jp
+     *
+     * @brief ホストのバイトオーダーを公開する
+     *
+     * データポートの接続の場合、当該 Port のホストのバイトオーダーを
+     * ConnectorProfile::properties の
+     * dataport.serializer.cdr.native_endian に追加する。値は接続に参加
+     * する Port ごとに一つずつ追加される。
+     *
+     * @param connector_profile ConnectorProfile
+     *
+     * @else
+     *
+     * @brief Publish the byte order of the host
+     *
+     * In the case of a data port connection, this operation appends the
+     * byte order of the host of this port to
+     * dataport.serializer.cdr.native_endian in
+     * ConnectorProfile::properties. One value is appended per port
+     * participating in the connection.
+     *
+     * @param connector_profile The ConnectorProfile.
+     *
+     * @endif
+     */
+    void publishNativeEndian(ConnectorProfile& connector_profile);
+
+    /*!
+     * @if jp
+     *
+     * @brief 接続で使用するバイトオーダーを決定する
+     *
+     * dataport.serializer.cdr.endian に列挙されたバイトオーダーのうち、
+     * 接続に参加するすべての Port のホストのバイトオーダーが一致し、そ
+     * れが許可されている場合はそのバイトオーダーを選択する。この場合、
+     * いずれの Port もバイトスワップを行わない。それ以外の場合は従来通
+     * り先頭のバイトオーダーを選択する。選択結果は
+     * dataport.serializer.cdr.endian に記録され、後続の
+     * subscribeInterfaces() および各コネクタはこの値を使用する。
+     *
+     * バイトオーダーを公開しない Port が含まれる場合、その Port は先頭
+     * のバイトオーダーを使用するため、先頭のバイトオーダーを選択する。
+     *
+     * @param connector_profile ConnectorProfile
+     *
+     * @else
+     *
+     * @brief Select the byte order used by the connection
+     *
+     * Among the byte orders listed in dataport.serializer.cdr.endian,
+     * the host byte order is selected if the hosts of all ports
+     * participating in the connection share it and it is allowed. In
+     * this case no port swaps bytes. Otherwise the first byte order is
+     * selected as before. The result is recorded in
+     * dataport.serializer.cdr.endian, and the following
+     * subscribeInterfaces() and the connectors use it.
+     *
+     * If a port that does not publish its byte order takes part, the
+     * first byte order is selected since that port uses it.
+     *
+     * @param connector_profile The ConnectorProfile.
+     *
+     * @endif
+     */
+    void selectEndian(ConnectorProfile& connector_profile);
+
 
     inline void onNotifyConnect(const char* portname,
                                 RTC::ConnectorProfile& profile)
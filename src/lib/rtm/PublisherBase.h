@@ -356,6 +356,30 @@ namespace RTC
      * @endif
      */
     virtual void release(){}
+
+    /*!
+     * @if jp
+     *
+     * @brief 統計情報を取得する
+     *
+     * Publisher が保持する統計情報を引数のプロパティに書き込む。キー名
+     * は Publisher の実装ごとに定義される。デフォルト実装は何もしない。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     *
+     * @brief Get statistics
+     *
+     * This operation writes the statistics held by the publisher into
+     * the given properties. Key names are defined by each publisher
+     * implementation. The default implementation does nothing.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    virtual void getStatistics(coil::Properties& /*stat*/) {}
   };
 
   typedef coil::GlobalFactory<PublisherBase> PublisherFactory;
@@ -61,9 +61,10 @@ namespace RTC
    * @brief initialization
    * @endif
    */
-  DataPortStatus PublisherFlush::init(coil::Properties&  /*prop*/)
+  DataPortStatus PublisherFlush::init(coil::Properties& prop)
   {
     RTC_TRACE(("init()"));
+    m_rateLimiter.init(prop.getNode("publisher.rate_limit"));
     return DataPortStatus::PORT_OK;
   }
 
@@ -146,36 +147,44 @@ namespace RTC
         RTC_DEBUG(("write(): connection lost."));
         return m_retcode;
       }
-    ByteData data_ = *data;
+    // m_data keeps its capacity, so nothing is allocated per write
+    m_data = *data;
 
+    // The flush publisher has no buffer to hold data over the limit.
+    if (!m_rateLimiter.tryAcquire(m_data.getDataLength()))
+      {
+        RTC_PARANOID(("write(): data discarded by the rate limit."));
+        m_rateLimiter.countDrop();
+        return DataPortStatus::PORT_OK;
+      }
 
-    onSend(data_);
-    DataPortStatus ret(m_consumer->put(data_));
+    onSend(m_data);
+    DataPortStatus ret(m_consumer->put(m_data));
     // consumer::put() returns
     //  {PORT_OK, PORT_ERROR, SEND_FULL, SEND_TIMEOUT, UNKNOWN_ERROR}
 
     switch (ret)
       {
       case DataPortStatus::PORT_OK:
-        onReceived(data_);
+        onReceived(m_data);
         return ret;
       case DataPortStatus::PORT_ERROR:
-        onReceiverError(data_);
+        onReceiverError(m_data);
         return ret;
       case DataPortStatus::SEND_FULL:
-        onReceiverFull(data_);
+        onReceiverFull(m_data);
         return ret;
       case DataPortStatus::SEND_TIMEOUT:
-        onReceiverTimeout(data_);
+        onReceiverTimeout(m_data);
         return ret;
       case DataPortStatus::CONNECTION_LOST:
-        onReceiverTimeout(data_);
+        onReceiverTimeout(m_data);
         return ret;
       case DataPortStatus::UNKNOWN_ERROR:
-        onReceiverError(data_);
+        onReceiverError(m_data);
         return ret;
       default:
-        onReceiverError(data_);
+        onReceiverError(m_data);
         return ret;
       }
   }
@@ -25,6 +25,7 @@
 #include <rtm/SystemLogger.h>
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
+#include <rtm/ConnectorRateLimiter.h>
 
 namespace coil
 {
@@ -345,6 +346,25 @@ namespace RTC
      */
     DataPortStatus deactivate() override;
 
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     *
+     * レート制限の統計 rate_limit.* を取得する。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics
+     *
+     * This operation gets the rate limiting statistics rate_limit.*.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) override;
+
   protected:
     /*!
      * @if jp
@@ -429,6 +449,8 @@ namespace RTC
     DataPortStatus m_retcode;
     std::mutex m_retmutex;
     bool m_active;
+    ConnectorRateLimiter m_rateLimiter;
+    ByteData m_data;
   };
 
 } // namespace RTC
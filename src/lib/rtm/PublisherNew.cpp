@@ -30,6 +30,9 @@
 #include <cassert>
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <thread>
+#include <utility>
 
 namespace RTC
 {
@@ -44,7 +47,11 @@ namespace RTC
     : rtclog("PublisherNew"),
       m_consumer(nullptr), m_buffer(nullptr), m_task(nullptr), m_listeners(nullptr),
       m_retcode(DataPortStatus::PORT_OK), m_pushPolicy(PUBLISHER_POLICY_NEW),
-      m_skipn(0), m_active(false), m_leftskip(0)
+      m_skipn(0), m_active(false), m_leftskip(0),
+      m_creditControl(false), m_probeInterval(std::chrono::milliseconds(10)),
+      m_stalled(false), m_overwrite(true),
+      m_finalizing(false), m_stallCount(0), m_localDropCount(0),
+      m_coalescedCount(0)
   {
   }
 
@@ -58,6 +65,7 @@ namespace RTC
   PublisherNew::~PublisherNew()
   {
     RTC_TRACE(("~PublisherNew()"));
+    m_finalizing = true;
     if (m_task != nullptr)
       {
         m_task->resume();
@@ -86,6 +94,8 @@ namespace RTC
     RTC_DEBUG_STR((prop));
 
     setPushPolicy(prop);
+    setFlowControl(prop);
+    m_rateLimiter.init(prop.getNode("publisher.rate_limit"));
     if (!createTask(prop))
       {
         return DataPortStatus::INVALID_ARGS;
@@ -178,25 +188,34 @@ namespace RTC
         return m_retcode;
       }
 
-    ByteData data_ = *data;
+    // m_data keeps its capacity, and the buffer hands back the storage
+    // of the slot it takes, so nothing is allocated per write
+    m_data = *data;
+
+    // only the "overwrite" policy drops data silently: the oldest one
+    bool overwrite(m_overwrite && timeout < std::chrono::nanoseconds::zero()
+                   && m_buffer->full());
 
     if (m_retcode == DataPortStatus::SEND_FULL)
       {
         RTC_DEBUG(("write(): InPort buffer is full."));
-        m_buffer->write(data_, timeout);
+        BufferStatus ret(m_buffer->write(std::move(m_data), timeout));
+        if (overwrite && ret == BufferStatus::OK) { ++m_localDropCount; }
         m_task->signal();
         return DataPortStatus::BUFFER_FULL;
       }
 
     assert(m_buffer != nullptr);
 
-    onBufferWrite(data_);
-    BufferStatus ret(m_buffer->write(data_, timeout));
+    onBufferWrite(m_data);
+    BufferStatus ret(m_buffer->write(std::move(m_data), timeout));
+    if (overwrite && ret == BufferStatus::OK) { ++m_localDropCount; }
 
     m_task->signal();
     RTC_DEBUG(("%s = write()", toString(ret)));
 
-    return convertReturn(ret, data_);
+    // m_data is unchanged unless the write succeeded
+    return convertReturn(ret, m_data);
   }
 
   /*!
@@ -248,6 +267,7 @@ namespace RTC
   {
 
     std::lock_guard<std::mutex> guard(m_retmutex);
+    if (!acquireCredit()) { return 0; }
     switch (m_pushPolicy)
       {
       case PUBLISHER_POLICY_ALL:
@@ -309,6 +329,118 @@ namespace RTC
       }
   }
 
+  /*!
+   * @if jp
+   * @brief フロー制御の設定
+   * @else
+   * @brief Setting flow control
+   * @endif
+   */
+  void PublisherNew::setFlowControl(const coil::Properties& prop)
+  {
+    // flow_control default: none
+    std::string flow_control = prop.getProperty("publisher.flow_control",
+                                                "none");
+    coil::normalize(flow_control);
+    RTC_DEBUG(("flow_control: %s", flow_control.c_str()));
+    if      (flow_control == "credit") { m_creditControl = true;  }
+    else if (flow_control == "none")   { m_creditControl = false; }
+    else
+      {
+        RTC_ERROR(("invalid flow_control value: %s", flow_control.c_str()));
+        m_creditControl = false;
+      }
+
+    // probe_interval default: 0.01 [s]
+    std::string interval =
+      prop.getProperty("publisher.flow_control.probe_interval", "0.01");
+    double sec(0.01);
+    if (!coil::stringTo(sec, interval.c_str()) || sec <= 0.0)
+      {
+        RTC_ERROR(("invalid probe_interval value: %s", interval.c_str()));
+        sec = 0.01;
+      }
+    m_probeInterval = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::duration<double>(sec));
+
+    std::string policy(prop.getProperty("buffer.write.full_policy",
+                                        "overwrite"));
+    coil::normalize(policy);
+    m_overwrite = (policy == "overwrite");
+  }
+
+  /*!
+   * @if jp
+   * @brief 送信クレジットを獲得する
+   * @else
+   * @brief Acquire sending credit
+   * @endif
+   */
+  bool PublisherNew::acquireCredit()
+  {
+    if (!m_creditControl) { return true; }
+    // -1: the destination does not advertise credit
+    if (m_consumer->getCredit() == 0)
+      {
+        // get_credit() is a remote call: ask at most once per interval
+        // and never wait for it here, the data stays in the buffer
+        auto now(std::chrono::steady_clock::now());
+        bool probe(now - m_lastProbe >= m_probeInterval);
+        if (probe) { m_lastProbe = now; }
+        if (!probe || m_consumer->refreshCredit() == 0)
+          {
+            if (!m_stalled)
+              {
+                RTC_DEBUG(("InPort has no credit. data is kept."));
+                m_stalled = true;
+                ++m_stallCount;
+              }
+            return false;
+          }
+      }
+    m_stalled = false;
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get statistics
+   * @endif
+   */
+  void PublisherNew::getStatistics(coil::Properties& stat)
+  {
+    long int credit(m_consumer != nullptr ? m_consumer->getCredit() : -1);
+    stat.setProperty("flow_control.credit", coil::otos(credit));
+    stat.setProperty("flow_control.stall_count",
+                     coil::otos(m_stallCount.load()));
+    stat.setProperty("flow_control.local_drop_count",
+                     coil::otos(m_localDropCount.load()));
+    stat.setProperty("flow_control.coalesced_count",
+                     coil::otos(m_coalescedCount.load()));
+    m_rateLimiter.getStatistics(stat);
+  }
+
+  /*!
+   * @if jp
+   * @brief レート制限の送信枠が得られるまで待つ
+   * @else
+   * @brief Wait until the rate limit allows sending
+   * @endif
+   */
+  bool PublisherNew::waitForBudget(size_t size)
+  {
+    while (!m_rateLimiter.tryAcquire(size))
+      {
+        if (m_finalizing || !m_active) { return false; }
+        std::this_thread::sleep_for(
+          std::max(m_rateLimiter.waitTime(size),
+                   std::chrono::nanoseconds(std::chrono::microseconds(100))));
+      }
+    return true;
+  }
+
   /*!
    * @if jp
    * @brief Task の設定
@@ -369,7 +501,9 @@ namespace RTC
 
     while (m_buffer->readable() > 0)
       {
+        if (!acquireCredit()) { break; }
         ByteData& cdr(m_buffer->get());
+        if (!waitForBudget(cdr.getDataLength())) { break; }
         onBufferRead(cdr);
 
         onSend(cdr);
@@ -394,6 +528,7 @@ namespace RTC
     RTC_TRACE(("pushFifo()"));
 
     ByteData& cdr(m_buffer->get());
+    if (!waitForBudget(cdr.getDataLength())) { return DataPortStatus::PORT_OK; }
 
     onBufferRead(cdr);
 
@@ -424,9 +559,24 @@ namespace RTC
     int postskip(m_skipn - m_leftskip);
     for (int i(0); i < loopcnt; ++i)
       {
+        if (i != 0 && !acquireCredit())
+          {
+            // keep the rest for when credit returns, counting skips
+            // from the sample just sent
+            m_buffer->advanceRptr();
+            m_leftskip = 0;
+            return ret;
+          }
         m_buffer->advanceRptr(postskip);
+        m_coalescedCount += static_cast<unsigned long>(postskip);
 
         ByteData& cdr(m_buffer->get());
+        if (!waitForBudget(cdr.getDataLength()))
+          {
+            m_buffer->advanceRptr(-postskip);
+            m_coalescedCount -= static_cast<unsigned long>(postskip);
+            break;
+          }
 
         onBufferRead(cdr);
 
@@ -435,6 +585,7 @@ namespace RTC
         if (ret != DataPortStatus::PORT_OK)
           {
             m_buffer->advanceRptr(-postskip);
+            m_coalescedCount -= static_cast<unsigned long>(postskip);
             RTC_DEBUG(("%s = consumer.put()", toString(ret)));
             return invokeListener(ret, cdr);
           }
@@ -467,7 +618,18 @@ namespace RTC
   {
     RTC_TRACE(("pushNew()"));
 
-    m_buffer->advanceRptr(static_cast<long>(m_buffer->readable()) - 1);
+    // Samples written while waiting for the rate limit supersede the
+    // one picked up first, so the newest one is taken again after
+    // each wait.
+    skipToNewest();
+    while (!m_rateLimiter.tryAcquire(m_buffer->get().getDataLength()))
+      {
+        if (m_finalizing || !m_active) { return DataPortStatus::PORT_OK; }
+        std::this_thread::sleep_for(
+          std::max(m_rateLimiter.waitTime(m_buffer->get().getDataLength()),
+                   std::chrono::nanoseconds(std::chrono::microseconds(100))));
+        skipToNewest();
+      }
 
     ByteData& cdr(m_buffer->get());
     onBufferRead(cdr);
@@ -486,6 +648,20 @@ namespace RTC
     return DataPortStatus::PORT_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief 最新のデータまで読み捨てる
+   * @else
+   * @brief Pass over all but the newest sample
+   * @endif
+   */
+  void PublisherNew::skipToNewest()
+  {
+    long skip(static_cast<long>(m_buffer->readable()) - 1);
+    m_buffer->advanceRptr(skip);
+    if (skip > 0) { m_coalescedCount += static_cast<unsigned long>(skip); }
+  }
+
   /*!
    * @if jp
    * @brief BufferStatus から DataPortStatus への変換
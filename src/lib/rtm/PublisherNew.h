@@ -23,6 +23,8 @@
 #include <coil/Task.h>
 #include <condition_variable>
 #include <coil/PeriodicTask.h>
+#include <atomic>
+#include <chrono>
 
 #include <rtm/RTC.h>
 #include <rtm/PublisherBase.h>
@@ -32,6 +34,7 @@
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
 #include <rtm/ByteData.h>
+#include <rtm/ConnectorRateLimiter.h>
 
 namespace coil
 {
@@ -418,6 +421,44 @@ namespace RTC
      */
     virtual int svc();
 
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     *
+     * 以下のフロー制御に関する統計情報を取得する。
+     *
+     * - flow_control.credit: 接続先が最後に通知したクレジット(不明な場合 -1)
+     * - flow_control.stall_count: クレジット不足で送信が止まった回数
+     * - flow_control.local_drop_count: ローカルバッファフルで上書きされ
+     *   失われたデータ数
+     * - flow_control.coalesced_count: push_policy (new, skip) により
+     *   送信されずに読み捨てられたデータ数
+     * - rate_limit.*: レート制限の統計 (ConnectorRateLimiter 参照)
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics
+     *
+     * This operation gets the following flow control statistics.
+     *
+     * - flow_control.credit: Credit last advertised by the destination
+     *                        (-1 if unknown)
+     * - flow_control.stall_count: Number of times sending stopped for
+     *                              lack of credit
+     * - flow_control.local_drop_count: Number of samples overwritten
+     *                                  because the local buffer was full
+     * - flow_control.coalesced_count: Number of samples passed over
+     *                                 without sending by push_policy
+     *                                 (new, skip)
+     * - rate_limit.*: Rate limiting statistics (see ConnectorRateLimiter)
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) override;
+
   protected:
     enum Policy
       {
@@ -446,6 +487,65 @@ namespace RTC
      */
     bool createTask(const coil::Properties& prop);
 
+    /*!
+     * @if jp
+     * @brief フロー制御の設定
+     *
+     * publisher.flow_control が credit の場合、接続先 InPort のクレジット
+     * が 0 の間はデータをローカルバッファに保持し送信を待機する。
+     *
+     * @else
+     * @brief Setting flow control
+     *
+     * If publisher.flow_control is credit, data is kept in the local
+     * buffer while the credit of the destination InPort is 0.
+     *
+     * @endif
+     */
+    void setFlowControl(const coil::Properties& prop);
+
+    /*!
+     * @if jp
+     * @brief 送信クレジットを獲得する
+     *
+     * 接続先のクレジットが 0 の場合、前回の問い合わせから
+     * publisher.flow_control.probe_interval 以上経過していれば一度だけ
+     * 問い合わせる。待機はせず、クレジットが無い場合データはバッファに
+     * 保持され、次の書き込みの際に push_policy に従って送信される。
+     *
+     * @return true: 送信可能, false: クレジット無し
+     *
+     * @else
+     * @brief Acquire sending credit
+     *
+     * If the destination's credit is 0, this operation queries it once
+     * if publisher.flow_control.probe_interval has passed since the
+     * last query. It never waits: without credit the data stays in the
+     * buffer and is sent according to push_policy on a later write.
+     *
+     * @return true: ready to send, false: no credit
+     *
+     * @endif
+     */
+    bool acquireCredit();
+
+    /*!
+     * @if jp
+     * @brief レート制限の送信枠が得られるまで待つ
+     *
+     * @param size 送信するデータのバイト数
+     * @return true: 送信可能, false: 非アクティブ化または終了処理中
+     *
+     * @else
+     * @brief Wait until the rate limit allows sending
+     *
+     * @param size Size of the data to send in bytes
+     * @return true: ready to send, false: deactivated or finalizing
+     *
+     * @endif
+     */
+    bool waitForBudget(size_t size);
+
     /*!
      * @brief push "all" policy
      */
@@ -466,6 +566,24 @@ namespace RTC
      */
     DataPortStatus pushNew();
 
+    /*!
+     * @if jp
+     * @brief 最新のデータまで読み捨てる
+     *
+     * 読み出し位置を最新のデータまで進め、読み捨てた数を
+     * flow_control.coalesced_count に加える。
+     *
+     * @else
+     * @brief Pass over all but the newest sample
+     *
+     * This operation advances the read pointer to the newest sample and
+     * adds the number of samples passed over to
+     * flow_control.coalesced_count.
+     *
+     * @endif
+     */
+    void skipToNewest();
+
     /*!
      * @if jp
      * @brief BufferStatus から DataPortStatus への変換
@@ -723,6 +841,17 @@ namespace RTC
     int m_skipn;
     bool m_active;
     int m_leftskip;
+    bool m_creditControl;
+    std::chrono::nanoseconds m_probeInterval;
+    std::chrono::steady_clock::time_point m_lastProbe;
+    bool m_stalled;
+    bool m_overwrite;
+    std::atomic<bool> m_finalizing;
+    std::atomic<unsigned long> m_stallCount;
+    std::atomic<unsigned long> m_localDropCount;
+    std::atomic<unsigned long> m_coalescedCount;
+    ConnectorRateLimiter m_rateLimiter;
+    ByteData m_data;
   };
 } // namespace RTC
 
@@ -27,6 +27,7 @@
 
 #include <cstdlib>
 #include <string>
+#include <utility>
 
 namespace RTC
 {
@@ -85,6 +86,7 @@ namespace RTC
     RTC_DEBUG_STR((prop));
 
     setPushPolicy(prop);
+    m_rateLimiter.init(prop.getNode("publisher.rate_limit"));
     if (!createTask(prop))
       {
         return DataPortStatus::INVALID_ARGS;
@@ -179,20 +181,23 @@ namespace RTC
         return m_retcode;
       }
 
-    ByteData data_ = *data;
+    // m_data keeps its capacity, and the buffer hands back the storage
+    // of the slot it takes, so nothing is allocated per write
+    m_data = *data;
 
     if (m_retcode == DataPortStatus::SEND_FULL)
       {
         RTC_DEBUG(("write(): InPort buffer is full."));
-        m_buffer->write(data_, timeout);
+        m_buffer->write(std::move(m_data), timeout);
         return DataPortStatus::BUFFER_FULL;
       }
 
-    onBufferWrite(data_);
-    BufferStatus ret(m_buffer->write(data_, timeout));
+    onBufferWrite(m_data);
+    BufferStatus ret(m_buffer->write(std::move(m_data), timeout));
     RTC_DEBUG(("%s = write()", toString(ret)));
     m_task->resume();
-    return convertReturn(ret, data_);
+    // m_data is unchanged unless the write succeeded
+    return convertReturn(ret, m_data);
   }
 
   /*!
@@ -280,6 +285,8 @@ namespace RTC
     while (m_buffer->readable() > 0)
       {
         ByteData& cdr(m_buffer->get());
+        // over the rate limit: the rest is sent in the next period
+        if (!m_rateLimiter.tryAcquire(cdr.getDataLength())) { break; }
         onBufferRead(cdr);
 
         onSend(cdr);
@@ -306,6 +313,10 @@ namespace RTC
     if (bufferIsEmpty()) { return DataPortStatus::BUFFER_EMPTY; }
 
     ByteData& cdr(m_buffer->get());
+    if (!m_rateLimiter.tryAcquire(cdr.getDataLength()))
+      {
+        return DataPortStatus::PORT_OK;
+      }
     onBufferRead(cdr);
 
     onSend(cdr);
@@ -343,6 +354,12 @@ namespace RTC
         m_buffer->advanceRptr(static_cast<long>(postskip));
         readable -= postskip;
         ByteData& cdr(m_buffer->get());
+        if (!m_rateLimiter.tryAcquire(cdr.getDataLength()))
+          {
+            // the rest is discarded as the skip policy does
+            m_rateLimiter.countDrop();
+            break;
+          }
         onBufferRead(cdr);
 
         onSend(cdr);
@@ -379,6 +396,11 @@ namespace RTC
     m_buffer->advanceRptr(static_cast<long>(m_buffer->readable()) - 1);
 
     ByteData& cdr(m_buffer->get());
+    if (!m_rateLimiter.tryAcquire(cdr.getDataLength()))
+      {
+        // the newest data is sent in the next period if still newest
+        return DataPortStatus::PORT_OK;
+      }
 
     onBufferRead(cdr);
 
@@ -396,6 +418,18 @@ namespace RTC
     return DataPortStatus::PORT_OK;
   }
 
+  /*!
+   * @if jp
+   * @brief 統計情報を取得する
+   * @else
+   * @brief Get statistics
+   * @endif
+   */
+  void PublisherPeriodic::getStatistics(coil::Properties& stat)
+  {
+    m_rateLimiter.getStatistics(stat);
+  }
+
   /*!
    * @if jp
    * @brief PushPolicy の設定
@@ -30,6 +30,7 @@
 #include <rtm/SystemLogger.h>
 #include <rtm/ConnectorBase.h>
 #include <rtm/ConnectorListener.h>
+#include <rtm/ConnectorRateLimiter.h>
 
 namespace coil
 {
@@ -416,6 +417,25 @@ namespace RTC
      */
     virtual int svc();
 
+    /*!
+     * @if jp
+     * @brief 統計情報を取得する
+     *
+     * レート制限の統計 rate_limit.* を取得する。
+     *
+     * @param stat 統計情報を受け取るプロパティ
+     *
+     * @else
+     * @brief Get statistics
+     *
+     * This operation gets the rate limiting statistics rate_limit.*.
+     *
+     * @param stat Properties to receive the statistics
+     *
+     * @endif
+     */
+    void getStatistics(coil::Properties& stat) override;
+
   protected:
     enum Policy
       {
@@ -743,6 +763,8 @@ namespace RTC
     bool m_active;
     bool m_readback;
     int m_leftskip;
+    ConnectorRateLimiter m_rateLimiter;
+    ByteData m_data;
   };
 } // namespace RTC
 
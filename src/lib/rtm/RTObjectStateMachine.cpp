@@ -28,6 +28,7 @@ namespace RTC_impl
                                              RTC::LightweightRTObject_ptr comp)
     : m_id(id),
       m_rtobj(RTC::LightweightRTObject::_duplicate(comp)),
+      m_hash(objectHash(comp)),
       m_sm(NUM_OF_LIFECYCLESTATE),
       m_ca(false), m_dfc(false), m_fsm(false), m_mode(false),
       m_rtobjPtr(nullptr), m_measure(false)
@@ -97,7 +98,26 @@ namespace RTC_impl
 
   bool RTObjectStateMachine::isEquivalent(RTC::LightweightRTObject_ptr comp)
   {
-    return m_rtobj->_is_equivalent(comp);
+    return m_rtobj.in() == comp || m_rtobj->_is_equivalent(comp);
+  }
+
+  CORBA::ULong RTObjectStateMachine::getObjectHash() const
+  {
+    return m_hash;
+  }
+
+  CORBA::ULong
+  RTObjectStateMachine::objectHash(RTC::LightweightRTObject_ptr comp)
+  {
+    if (CORBA::is_nil(comp)) { return 0; }
+    try
+      {
+        return comp->_hash(0x7fffffff);
+      }
+    catch (...)
+      {
+        return 0;
+      }
   }
 
   RTC::ExecutionContextHandle_t RTObjectStateMachine::
@@ -259,62 +279,28 @@ namespace RTC_impl
   void RTObjectStateMachine::onExecute(const ExecContextStates&  /*st*/)
   {
     if (isNextState(RTC::ERROR_STATE)) { return; }
-    static int count;
-    double max_interval, min_interval, mean_interval, stddev;
-    // call Servant
+    std::chrono::steady_clock::time_point start;
+    if (m_measure) { start = std::chrono::steady_clock::now(); }
+    RTC::ReturnCode_t ret;
     if (m_rtobjPtr != nullptr)
       {
-        if (m_measure) { m_svtMeasure.tick(); }
-        if (m_rtobjPtr->on_execute(m_id) != RTC::RTC_OK)
-          {
-            m_sm.goTo(RTC::ERROR_STATE);
-          }
-        if (m_measure)
-          {
-            m_svtMeasure.tack();
-            if (count > 1000)
-              {
-                count = 0;
-                m_svtMeasure.getStatistics(max_interval, min_interval,
-                                           mean_interval, stddev);
-                std::cout << "[servant] ";
-                std::cout << " max: "    << max_interval;
-                std::cout << " min: "    << min_interval;
-                std::cout << " mean: "   << mean_interval;
-                std::cout << " stddev: " << stddev;
-                std::cout << std::endl;
-              }
-            ++count;
-          }
-        return;
+        // call Servant
+        ret = m_rtobjPtr->on_execute(m_id);
+      }
+    else
+      {
+        // call Object reference
+        if (!m_dfc) { return; }
+        ret = m_dfcVar->on_execute(m_id);
       }
-    // call Object reference
-    if (!m_dfc) { return; }
-    if (m_measure) { m_refMeasure.tick(); }
-    RTC::ReturnCode_t ret = m_dfcVar->on_execute(m_id);
     if (m_measure)
       {
-        m_refMeasure.tack();
-        if (count > 1000)
-          {
-            count = 0;
-            m_refMeasure.getStatistics(max_interval, min_interval,
-                                       mean_interval, stddev);
-            std::cout << "[objref] ";
-            std::cout << " max: "    << max_interval;
-            std::cout << " min: "    << min_interval;
-            std::cout << " mean: "   << mean_interval;
-            std::cout << " stddev: " << stddev;
-            std::cout << std::endl;
-          }
-        ++count;
+        m_execTime.record(std::chrono::steady_clock::now() - start);
       }
     if (ret != RTC::RTC_OK)
       {
         m_sm.goTo(RTC::ERROR_STATE);
-        return;
       }
-    return;
   }
 
   void RTObjectStateMachine::onStateUpdate(const ExecContextStates&  /*st*/)
@@ -410,7 +396,28 @@ namespace RTC_impl
     m_sm.goTo(state);
   }
 
+  RTC::RTObject_impl* RTObjectStateMachine::getRTObjectPtr()
+  {
+    return m_rtobjPtr;
+  }
+
   // Workers
+  void RTObjectStateMachine::setExecTimeMeasure(bool measure)
+  {
+    m_measure = measure;
+  }
+
+  RTC::TimingHistogram& RTObjectStateMachine::getExecTimeHistogram()
+  {
+    return m_execTime;
+  }
+
+  std::string RTObjectStateMachine::getInstanceName()
+  {
+    if (m_rtobjPtr != nullptr) { return m_rtobjPtr->getInstanceName(); }
+    return std::string();
+  }
+
   void RTObjectStateMachine::workerPreDo()
   {
     return m_sm.worker_pre();
@@ -24,6 +24,8 @@
 #include <coil/TimeMeasure.h>
 #include <rtm/idl/RTCSkel.h>
 #include <rtm/StateMachine.h>
+#include <rtm/TimingHistogram.h>
+#include <string>
 #include <cassert>
 #include <iostream>
 
@@ -49,7 +51,13 @@ namespace RTC_impl
 
     // functions for stored RTObject reference
     RTC::LightweightRTObject_ptr getRTObject();
+    // nullptr if the component is not in this process
+    RTC::RTObject_impl* getRTObjectPtr();
     bool isEquivalent(RTC::LightweightRTObject_ptr comp);
+    // _hash() of the reference, cached when the component joined
+    CORBA::ULong getObjectHash() const;
+    // _hash() of any reference, computed locally by the ORB
+    static CORBA::ULong objectHash(RTC::LightweightRTObject_ptr comp);
 
     RTC::ExecutionContextHandle_t getExecutionContextHandle();
 
@@ -85,6 +93,11 @@ namespace RTC_impl
     void workerDo();
     void workerPostDo();
 
+    // Measurement of on_execute time
+    void setExecTimeMeasure(bool measure);
+    RTC::TimingHistogram& getExecTimeHistogram();
+    std::string getInstanceName();
+
   protected:
     void setComponentAction(RTC::LightweightRTObject_ptr comp);
     void setDataFlowComponentAction(RTC::LightweightRTObject_ptr comp);
@@ -97,6 +110,7 @@ namespace RTC_impl
     RTC::ExecutionContextHandle_t m_id;
     // Associated RTObject reference
     RTC::LightweightRTObject_var m_rtobj;
+    CORBA::ULong m_hash;
     // State machine
     RTC_Utils::StateMachine<ExecContextState,
                             RTObjectStateMachine> m_sm;
@@ -110,9 +124,7 @@ namespace RTC_impl
     RTC::MultiModeComponentAction_var m_modeVar;
     RTC::RTObject_impl* m_rtobjPtr;
     bool m_measure;
-    // Component action invoker
-    coil::TimeMeasure m_svtMeasure;
-    coil::TimeMeasure m_refMeasure;
+    RTC::TimingHistogram m_execTime;
   };
 } // namespace RTC_impl
 
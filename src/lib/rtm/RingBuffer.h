@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define RINGBUFFER_DEFAULT_LENGTH 8
@@ -449,52 +450,61 @@ namespace RTC
                        std::chrono::nanoseconds timeout
                        = std::chrono::nanoseconds(-1)) override
     {
-      {
-      std::unique_lock<std::mutex> guard(m_full.mutex);
+      BufferStatus ret(waitWritable(timeout));
+      if (ret != BufferStatus::OK) { return ret; }
 
-      if (full())
-        {
+      put(value);
 
-          bool timedwrite(m_timedwrite);
-          bool overwrite(m_overwrite);
+      advanceWptr(1);
 
-          if (timeout >= std::chrono::seconds::zero())  // block mode
-            {
-              timedwrite = true;
-              overwrite  = false;
-            }
+      return BufferStatus::OK;
+    }
 
-          if (overwrite && !timedwrite)  // "overwrite" mode
-            {
-              advanceRptr(1,false);
-            }
-          else if (!overwrite && !timedwrite)  // "do_nothing" mode
-            {
-              return BufferStatus::FULL;
-            }
-          else if (!overwrite && timedwrite)  // "block" mode
-            {
-              if (timeout < std::chrono::seconds::zero())
-                {
-                  timeout = m_wtimeout;
-                }
-              if (std::cv_status::timeout == m_empty.cond.wait_for(guard, timeout))
-                {
-                  return BufferStatus::TIMEOUT;
-                }
-            }
-          else                                    // unknown condition
-            {
-              return BufferStatus::PRECONDITION_NOT_MET;
-            }
-        }
-      }
+    /*!
+     * @if jp
+     *
+     * @brief バッファにデータを移して書き込む
+     *
+     * write(const DataType&) と同じだが、value をコピーせずに書き込み
+     * 位置の要素と交換する。書き込みに成功すると value には上書きされ
+     * た要素の以前の内容が入るため、同じ大きさのデータを繰り返し書き込
+     * む場合にメモリを確保し直さずに済む。
+     *
+     * @param value 書き込み対象データ
+     * @param timeout タイムアウト時間 nsec (default -1: 無効)
+     * @return write(const DataType&) と同じ
+     *
+     * @else
+     *
+     * @brief Write data into the buffer by moving it
+     *
+     * The same as write(const DataType&), but value is exchanged with
+     * the element at the write position instead of being copied. After
+     * a successful write value holds the previous contents of the
+     * overwritten element, so repeated writes of equal-sized data do
+     * not reallocate.
+     *
+     * @param value Target data for writing
+     * @param timeout Timeout in nsec (default -1: no timeout)
+     * @return The same as write(const DataType&)
+     *
+     * @endif
+     */
+    BufferStatus write(DataType&& value,
+                       std::chrono::nanoseconds timeout
+                       = std::chrono::nanoseconds(-1)) override
+    {
+      BufferStatus ret(waitWritable(timeout));
+      if (ret != BufferStatus::OK) { return ret; }
 
-      put(value);
+      {
+        using std::swap;
+        std::lock_guard<std::mutex> guard(m_posmutex);
+        swap(m_buffer[m_wpos], value);
+      }
 
       advanceWptr(1);
 
-
       return BufferStatus::OK;
     }
 
@@ -850,6 +860,65 @@ namespace RTC
     }
 
   private:
+    /*!
+     * @if jp
+     * @brief 書き込み可能になるまで待つ
+     *
+     * バッファがフルの場合、書込みモードに従って最古のデータを捨てる、
+     * FULL を返す、または読み出されるまで待つ。
+     *
+     * @else
+     * @brief Wait until the buffer is writable
+     *
+     * If the buffer is full, the oldest data is discarded, FULL is
+     * returned or it waits for a read, according to the write mode.
+     *
+     * @endif
+     */
+    BufferStatus waitWritable(std::chrono::nanoseconds timeout)
+    {
+      std::unique_lock<std::mutex> guard(m_full.mutex);
+
+      if (full())
+        {
+
+          bool timedwrite(m_timedwrite);
+          bool overwrite(m_overwrite);
+
+          if (timeout >= std::chrono::seconds::zero())  // block mode
+            {
+              timedwrite = true;
+              overwrite  = false;
+            }
+
+          if (overwrite && !timedwrite)  // "overwrite" mode
+            {
+              advanceRptr(1,false);
+            }
+          else if (!overwrite && !timedwrite)  // "do_nothing" mode
+            {
+              return BufferStatus::FULL;
+            }
+          else if (!overwrite && timedwrite)  // "block" mode
+            {
+              if (timeout < std::chrono::seconds::zero())
+                {
+                  timeout = m_wtimeout;
+                }
+              if (std::cv_status::timeout == m_empty.cond.wait_for(guard, timeout))
+                {
+                  return BufferStatus::TIMEOUT;
+                }
+            }
+          else                                    // unknown condition
+            {
+              return BufferStatus::PRECONDITION_NOT_MET;
+            }
+        }
+
+      return BufferStatus::OK;
+    }
+
     inline void initLength(const coil::Properties& prop)
     {
       if (!prop["length"].empty())
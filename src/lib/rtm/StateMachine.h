@@ -19,9 +19,11 @@
 #ifndef RTC_STATEMACHINE_H
 #define RTC_STATEMACHINE_H
 
-#include <mutex>
-
+#include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -148,6 +150,12 @@ namespace RTC_Utils
    * 一旦 Exit が呼ばれた後、Entry が実行され、以降は前項と同じ動作をする。
    * </ul>
    *
+   * 現在の状態と遷移予定の状態は一つのアトミックな値に保持され、ロッ
+   * クを使用しない。goTo() は任意のスレッドから呼び出すことができ、遷
+   * 移予定の状態を書き込むだけである。遷移は駆動関数を呼ぶスレッドで
+   * 次のステップの始めに行われる。状態の型は 16 ビットに収まる列挙型
+   * でなければならない。
+   *
    * @param State 状態の型
    * @param Listener アクション用リスナーオブジェクト
    * @param States 状態ホルダー
@@ -248,6 +256,12 @@ namespace RTC_Utils
    * above will be done from here on.
    * </ul>
    *
+   * The current and the next state are held in a single atomic word
+   * and no lock is used. goTo() can be called from any thread and only
+   * writes the next state. The transition is made by the thread
+   * calling the worker functions at the beginning of the next step.
+   * The state type must be an enumeration fitting in 16 bits.
+   *
    * @param State Type of the state
    * @param Listener Listener object for action
    * @param States State holder
@@ -264,6 +278,11 @@ namespace RTC_Utils
             >
   class StateMachine
   {
+    // the current and the next state are packed into 16 bits each
+    static_assert(std::is_enum<State>::value,
+                  "State of StateMachine must be an enumeration type");
+    static const uint32_t max_num_of_state = 0x10000;
+
   public:
     /*!
      * @if jp
@@ -291,8 +310,12 @@ namespace RTC_Utils
         m_postdo(m_num, (Callback)nullptr),
         m_exit(m_num, (Callback)nullptr),
         m_transit(nullptr),
+        m_word(0),
         m_selftrans(false)
     {
+      // the states are 0 .. num_of_state - 1 and must fit in 16 bits
+      assert(num_of_state >= 0 &&
+             static_cast<uint32_t>(num_of_state) <= max_num_of_state);
     }
 
     virtual ~StateMachine()
@@ -309,7 +332,8 @@ namespace RTC_Utils
         m_exit  (other.m_exit),
         m_transit(other.m_transit),
         m_states(other.m_states),
-        m_selftrans(other.m_selftrans)
+        m_word(other.m_word.load()),
+        m_selftrans(other.m_selftrans.load())
     {
     }
 
@@ -331,7 +355,8 @@ namespace RTC_Utils
       std::swap(m_exit,      other.m_exit);
       std::swap(m_transit,   other.m_transit);
       std::swap(m_states,    other.m_states);
-      std::swap(m_selftrans, other.m_selftrans);
+      m_word = other.m_word.exchange(m_word.load());
+      m_selftrans = other.m_selftrans.exchange(m_selftrans.load());
     }
     /*!
      * @if jp
@@ -620,6 +645,7 @@ namespace RTC_Utils
       m_states.curr = states.curr;
       m_states.prev = states.prev;
       m_states.next = states.next;
+      m_word = pack(states.curr, states.next);
     }
 
     /*!
@@ -644,8 +670,9 @@ namespace RTC_Utils
      */
     States getStates()
     {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      return m_states;
+      States st;
+      sync(st);
+      return st;
     }
 
     /*!
@@ -667,8 +694,7 @@ namespace RTC_Utils
      */
     State getState()
     {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      return m_states.curr;
+      return curr(m_word.load(std::memory_order_acquire));
     }
 
     /*!
@@ -694,8 +720,7 @@ namespace RTC_Utils
      */
     bool isIn(State state)
     {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      return m_states.curr == state ? true : false;
+      return getState() == state;
     }
 
     /*!
@@ -726,11 +751,15 @@ namespace RTC_Utils
      */
     void goTo(State state)
     {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      m_states.next = state;
-      if (m_states.curr == state)
+      uint32_t word(m_word.load(std::memory_order_relaxed));
+      while (!m_word.compare_exchange_weak(word, pack(curr(word), state),
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_relaxed))
+        {
+        }
+      if (curr(word) == state)
         {
-          m_selftrans  = true;
+          m_selftrans = true;
         }
     }
 
@@ -760,24 +789,24 @@ namespace RTC_Utils
       if (state.curr == state.next)
         {
           // pre-do
-          if (m_predo[state.curr] != NULL)
+          if (m_predo[state.curr] != nullptr)
             (m_listener->*m_predo[state.curr])(state);
 
           if (need_trans()) return;
 
           // do
-          if (m_do[state.curr] != NULL)
+          if (m_do[state.curr] != nullptr)
             (m_listener->*m_do[state.curr])(state);
 
           if (need_trans()) return;
 
           // post-do
-          if (m_postdo[state.curr] != NULL)
+          if (m_postdo[state.curr] != nullptr)
             (m_listener->*m_postdo[state.curr])(state);
         }
       else
         {
-          if (m_exit[state.curr] != NULL)
+          if (m_exit[state.curr] != nullptr)
             (m_listener->*m_exit[state.curr])(state);
 
           sync(state);
@@ -785,7 +814,7 @@ namespace RTC_Utils
           if (state.curr != state.next)
             {
               state.curr = state.next;
-              if (m_entry[state.curr] != NULL)
+              if (m_entry[state.curr] != nullptr)
                 (m_listener->*m_entry[state.curr])(state);
               update_curr(state.curr);
             }
@@ -952,32 +981,65 @@ namespace RTC_Utils
 
     /*!
      * @if jp
-     * @brief 現在の状態情報
+     * @brief 状態情報
+     *
+     * m_states は初期状態を保持し、現在の状態と遷移予定の状態は
+     * m_word の下位と上位 16 ビットに保持する。
+     *
      * @else
-     * @brief Current state information
+     * @brief State information
+     *
+     * m_states holds the initial states. The current and the next
+     * state are held in the lower and the upper 16 bits of m_word.
+     *
      * @endif
      */
     States m_states;
-    bool m_selftrans;
-    std::mutex m_mutex;
+    std::atomic<uint32_t> m_word;
+    std::atomic<bool> m_selftrans;
 
   private:
+    static uint32_t pack(State curr, State next)
+    {
+      assert(static_cast<uint32_t>(curr) < max_num_of_state &&
+             static_cast<uint32_t>(next) < max_num_of_state);
+      return (static_cast<uint32_t>(curr) & 0xffffU) |
+        (static_cast<uint32_t>(next) << 16);
+    }
+
+    static State curr(uint32_t word)
+    {
+      return static_cast<State>(word & 0xffffU);
+    }
+
+    static State next(uint32_t word)
+    {
+      return static_cast<State>(word >> 16);
+    }
+
     inline void sync(States& st)
     {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      st = m_states;
+      uint32_t word(m_word.load(std::memory_order_acquire));
+      st.prev = m_states.prev;
+      st.curr = curr(word);
+      st.next = next(word);
     }
 
     inline bool need_trans()
     {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      return (m_states.curr != m_states.next);
+      uint32_t word(m_word.load(std::memory_order_acquire));
+      return curr(word) != next(word);
     }
 
-    inline void update_curr(const State curr)
+    inline void update_curr(const State state)
     {
-      std::lock_guard<std::mutex> guard(m_mutex);
-      m_states.curr = curr;
+      // keep the next state requested meanwhile
+      uint32_t word(m_word.load(std::memory_order_relaxed));
+      while (!m_word.compare_exchange_weak(word, pack(state, next(word)),
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_relaxed))
+        {
+        }
     }
   };
 } // namespace RTC_Utils
@@ -0,0 +1,371 @@
+﻿// -*- C++ -*-
+/*!
+ * @file TaskGraph.cpp
+ * @brief Dependency graph of tasks and its parallel executor
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/TaskGraph.h>
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace RTC
+{
+  //============================================================
+  // class TaskGraph
+  //============================================================
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TaskGraph::TaskGraph(size_t size)
+  {
+    reset(size);
+  }
+
+  /*!
+   * @if jp
+   * @brief 辺をすべて削除してノード数を設定する
+   * @else
+   * @brief Remove all edges and set the number of nodes
+   * @endif
+   */
+  void TaskGraph::reset(size_t size)
+  {
+    m_successors.assign(size, std::vector<size_t>());
+    m_predecessors.assign(size, std::vector<size_t>());
+    updateOrder();
+  }
+
+  size_t TaskGraph::size() const
+  {
+    return m_successors.size();
+  }
+
+  /*!
+   * @if jp
+   * @brief 辺を追加する
+   * @else
+   * @brief Add an edge
+   * @endif
+   */
+  bool TaskGraph::addEdge(size_t from, size_t to)
+  {
+    if (from == to) { return false; }
+    std::vector<size_t>& succ(m_successors[from]);
+    if (std::find(succ.begin(), succ.end(), to) != succ.end())
+      {
+        return true;
+      }
+    if (isReachable(to, from)) { return false; }
+    succ.push_back(to);
+    m_predecessors[to].push_back(from);
+    updateOrder();
+    return true;
+  }
+
+  /*!
+   * @if jp
+   * @brief from から to へ辺をたどって到達できるか判定する
+   * @else
+   * @brief Check whether to is reachable from from along the edges
+   * @endif
+   */
+  bool TaskGraph::isReachable(size_t from, size_t to) const
+  {
+    std::vector<bool> visited(size(), false);
+    std::vector<size_t> stack(1, from);
+    visited[from] = true;
+    while (!stack.empty())
+      {
+        size_t node(stack.back());
+        stack.pop_back();
+        if (node == to) { return true; }
+        for (auto next : m_successors[node])
+          {
+            if (visited[next]) { continue; }
+            visited[next] = true;
+            stack.push_back(next);
+          }
+      }
+    return false;
+  }
+
+  const std::vector<size_t>& TaskGraph::getSuccessors(size_t node) const
+  {
+    return m_successors[node];
+  }
+
+  const std::vector<size_t>& TaskGraph::getPredecessors(size_t node) const
+  {
+    return m_predecessors[node];
+  }
+
+  const std::vector<size_t>& TaskGraph::getOrder() const
+  {
+    return m_order;
+  }
+
+  /*!
+   * @if jp
+   * @brief クリティカルパスの長さを求める
+   * @else
+   * @brief Calculate the length of the critical path
+   * @endif
+   */
+  std::chrono::nanoseconds TaskGraph::
+  getCriticalPath(const std::vector<std::chrono::nanoseconds>& cost) const
+  {
+    std::chrono::nanoseconds length(0);
+    m_finish.assign(size(), std::chrono::nanoseconds::zero());
+    for (auto node : m_order)
+      {
+        std::chrono::nanoseconds start(0);
+        for (auto prev : m_predecessors[node])
+          {
+            start = std::max(start, m_finish[prev]);
+          }
+        m_finish[node] = start + cost[node];
+        length = std::max(length, m_finish[node]);
+      }
+    return length;
+  }
+
+  /*!
+   * @if jp
+   * @brief トポロジカル順序を求める
+   * @else
+   * @brief Calculate the topological order
+   * @endif
+   */
+  void TaskGraph::updateOrder()
+  {
+    std::vector<size_t> indegree(size());
+    std::priority_queue<size_t, std::vector<size_t>,
+                        std::greater<size_t> > ready;
+    for (size_t i(0); i < size(); ++i)
+      {
+        indegree[i] = m_predecessors[i].size();
+        if (indegree[i] == 0) { ready.push(i); }
+      }
+    m_order.clear();
+    while (!ready.empty())
+      {
+        size_t node(ready.top());
+        ready.pop();
+        m_order.push_back(node);
+        for (auto next : m_successors[node])
+          {
+            if (--indegree[next] == 0) { ready.push(next); }
+          }
+      }
+  }
+
+  //============================================================
+  // class TaskGraphExecutor
+  //============================================================
+  /*!
+   * @if jp
+   * @brief コンストラクタ
+   * @else
+   * @brief Constructor
+   * @endif
+   */
+  TaskGraphExecutor::TaskGraphExecutor(size_t threads)
+    : m_generation(0), m_stop(false), m_graph(nullptr), m_task(nullptr),
+      m_pendingSize(0), m_remaining(0), m_active(0)
+  {
+    threads = std::max(threads, static_cast<size_t>(1));
+    for (size_t i(0); i < threads; ++i)
+      {
+        m_queues.emplace_back(new Queue());
+      }
+    // index 0 is the thread calling run()
+    for (size_t i(1); i < threads; ++i)
+      {
+        m_threads.emplace_back([this, i] { svc(i); });
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief デストラクタ
+   * @else
+   * @brief Destructor
+   * @endif
+   */
+  TaskGraphExecutor::~TaskGraphExecutor()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    for (auto & thread : m_threads) { thread.join(); }
+  }
+
+  size_t TaskGraphExecutor::getThreadCount() const
+  {
+    return m_queues.size();
+  }
+
+  /*!
+   * @if jp
+   * @brief グラフを実行する
+   * @else
+   * @brief Execute a graph
+   * @endif
+   */
+  void TaskGraphExecutor::run(const TaskGraph& graph,
+                              const std::function<void(size_t)>& task)
+  {
+    size_t size(graph.size());
+    if (size == 0) { return; }
+    if (m_threads.empty())
+      {
+        for (auto node : graph.getOrder()) { task(node); }
+        return;
+      }
+
+    if (m_pendingSize < size)
+      {
+        m_pending.reset(new std::atomic<size_t>[size]);
+        m_pendingSize = size;
+      }
+    for (size_t i(0); i < size; ++i)
+      {
+        m_pending[i].store(graph.getPredecessors(i).size(),
+                           std::memory_order_relaxed);
+      }
+    m_remaining.store(size);
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_graph = &graph;
+      m_task = &task;
+      // the nodes without predecessors are distributed to all threads
+      size_t index(0);
+      for (size_t i(0); i < size; ++i)
+        {
+          if (!graph.getPredecessors(i).empty()) { continue; }
+          push(index, i);
+          index = (index + 1) % m_queues.size();
+        }
+      ++m_generation;
+    }
+    m_cond.notify_all();
+
+    execute(0);
+    // the other threads may still refer to the graph
+    while (m_active.load() != 0) { std::this_thread::yield(); }
+  }
+
+  /*!
+   * @if jp
+   * @brief 実行スレッドの関数
+   * @else
+   * @brief Function of an executing thread
+   * @endif
+   */
+  void TaskGraphExecutor::svc(size_t index)
+  {
+    unsigned long generation(0);
+    for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> guard(m_mutex);
+          m_cond.wait(guard, [this, generation] {
+              return m_stop || m_generation != generation;
+            });
+          if (m_stop) { return; }
+          generation = m_generation;
+          ++m_active;
+        }
+        execute(index);
+        --m_active;
+      }
+  }
+
+  /*!
+   * @if jp
+   * @brief すべてのノードの実行が終わるまでノードを実行する
+   * @else
+   * @brief Execute nodes until all nodes are executed
+   * @endif
+   */
+  void TaskGraphExecutor::execute(size_t index)
+  {
+    size_t node;
+    while (m_remaining.load(std::memory_order_acquire) != 0)
+      {
+        if (!pop(index, node))
+          {
+            std::this_thread::yield();
+            continue;
+          }
+        (*m_task)(node);
+        for (auto next : m_graph->getSuccessors(node))
+          {
+            if (m_pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+              {
+                push(index, next);
+              }
+          }
+        m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+      }
+  }
+
+  void TaskGraphExecutor::push(size_t index, size_t node)
+  {
+    Queue& queue(*m_queues[index]);
+    std::lock_guard<std::mutex> guard(queue.mutex);
+    queue.nodes.push_back(node);
+  }
+
+  /*!
+   * @if jp
+   * @brief 自身のキューの末尾、または他のキューの先頭から取り出す
+   * @else
+   * @brief Take a node from the back of the own queue or the front of
+   *        another queue
+   * @endif
+   */
+  bool TaskGraphExecutor::pop(size_t index, size_t& node)
+  {
+    {
+      Queue& queue(*m_queues[index]);
+      std::lock_guard<std::mutex> guard(queue.mutex);
+      if (!queue.nodes.empty())
+        {
+          node = queue.nodes.back();
+          queue.nodes.pop_back();
+          return true;
+        }
+    }
+    for (size_t i(1); i < m_queues.size(); ++i)
+      {
+        Queue& queue(*m_queues[(index + i) % m_queues.size()]);
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        if (!queue.nodes.empty())
+          {
+            node = queue.nodes.front();
+            queue.nodes.pop_front();
+            return true;
+          }
+      }
+    return false;
+  }
+} // namespace RTC
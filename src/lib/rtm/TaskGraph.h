@@ -0,0 +1,329 @@
+﻿// -*- C++ -*-
+/*!
+ * @file TaskGraph.h
+ * @brief Dependency graph of tasks and its parallel executor
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_TASKGRAPH_H
+#define RTC_TASKGRAPH_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TaskGraph
+   * @brief タスクの依存関係を表す有向非巡回グラフ
+   *
+   * ノードは 0 から size() - 1 の番号で表す。addEdge() は閉路を作る辺
+   * を追加しないため、グラフは常に非巡回でありトポロジカル順序を持つ。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class TaskGraph
+   * @brief Directed acyclic graph of the dependencies between tasks
+   *
+   * Nodes are numbered from 0 to size() - 1. addEdge() does not add an
+   * edge which makes a cycle, so the graph is always acyclic and has a
+   * topological order.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class TaskGraph
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @param size ノード数
+     * @else
+     * @brief Constructor
+     * @param size The number of nodes
+     * @endif
+     */
+    explicit TaskGraph(size_t size = 0);
+
+    /*!
+     * @if jp
+     * @brief 辺をすべて削除してノード数を設定する
+     * @param size ノード数
+     * @else
+     * @brief Remove all edges and set the number of nodes
+     * @param size The number of nodes
+     * @endif
+     */
+    void reset(size_t size);
+
+    /*!
+     * @if jp
+     * @brief ノード数を取得する
+     * @return ノード数
+     * @else
+     * @brief Get the number of nodes
+     * @return The number of nodes
+     * @endif
+     */
+    size_t size() const;
+
+    /*!
+     * @if jp
+     * @brief 辺を追加する
+     *
+     * from を to より先に実行する依存関係を追加する。既存の辺は追加し
+     * ない。閉路を作る辺は追加せず false を返す。
+     *
+     * @param from 先に実行するノード
+     * @param to 後に実行するノード
+     * @return 閉路を作るため追加できなかった場合 false
+     *
+     * @else
+     * @brief Add an edge
+     *
+     * This adds a dependency executing from before to. An existing edge
+     * is not added again. An edge which makes a cycle is not added and
+     * false is returned.
+     *
+     * @param from The node executed first
+     * @param to The node executed later
+     * @return false if the edge was not added because it makes a cycle
+     *
+     * @endif
+     */
+    bool addEdge(size_t from, size_t to);
+
+    /*!
+     * @if jp
+     * @brief from から to へ辺をたどって到達できるか判定する
+     * @param from 始点
+     * @param to 終点
+     * @return 到達できる場合 true
+     * @else
+     * @brief Check whether to is reachable from from along the edges
+     * @param from The start node
+     * @param to The end node
+     * @return true if reachable
+     * @endif
+     */
+    bool isReachable(size_t from, size_t to) const;
+
+    /*!
+     * @if jp
+     * @brief 後続ノードを取得する
+     * @param node ノード
+     * @return node の後に実行するノード
+     * @else
+     * @brief Get the successors
+     * @param node The node
+     * @return The nodes executed after node
+     * @endif
+     */
+    const std::vector<size_t>& getSuccessors(size_t node) const;
+
+    /*!
+     * @if jp
+     * @brief 先行ノードを取得する
+     * @param node ノード
+     * @return node の前に実行するノード
+     * @else
+     * @brief Get the predecessors
+     * @param node The node
+     * @return The nodes executed before node
+     * @endif
+     */
+    const std::vector<size_t>& getPredecessors(size_t node) const;
+
+    /*!
+     * @if jp
+     * @brief トポロジカル順序を取得する
+     *
+     * 依存関係のないノードどうしは番号の順に並べる。
+     *
+     * @return すべてのノードを依存関係の順に並べたもの
+     *
+     * @else
+     * @brief Get the topological order
+     *
+     * Nodes without a dependency between them are ordered by number.
+     *
+     * @return All nodes in the order of the dependencies
+     *
+     * @endif
+     */
+    const std::vector<size_t>& getOrder() const;
+
+    /*!
+     * @if jp
+     * @brief クリティカルパスの長さを求める
+     *
+     * 各ノードの実行時間から、依存関係をたどる経路の実行時間の和の最大
+     * 値を求める。
+     *
+     * @param cost ノードごとの実行時間
+     * @return クリティカルパスの長さ
+     *
+     * @else
+     * @brief Calculate the length of the critical path
+     *
+     * This calculates the maximum sum of the execution times along a
+     * path of the dependencies from the execution time of each node.
+     *
+     * @param cost The execution time of each node
+     * @return The length of the critical path
+     *
+     * @endif
+     */
+    std::chrono::nanoseconds
+    getCriticalPath(const std::vector<std::chrono::nanoseconds>& cost) const;
+
+  private:
+    void updateOrder();
+
+    std::vector<std::vector<size_t> > m_successors;
+    std::vector<std::vector<size_t> > m_predecessors;
+    std::vector<size_t> m_order;
+    // work area of getCriticalPath()
+    mutable std::vector<std::chrono::nanoseconds> m_finish;
+  };
+
+  /*!
+   * @if jp
+   * @class TaskGraphExecutor
+   * @brief TaskGraph を並列に実行するスレッドプール
+   *
+   * run() は TaskGraph の依存関係を守りながら、依存関係のないノードを
+   * 複数のスレッドで同時に実行し、すべてのノードの実行が終わってから
+   * 戻る。呼び出したスレッドも実行に加わる。
+   *
+   * 各スレッドは自身のキューを持ち、実行可能になった後続ノードを自身
+   * のキューに積む。キューが空になったスレッドは他のスレッドのキュー
+   * から反対側のノードを取り出す (work stealing)。run() の実行中、待機
+   * するスレッドはブロックせずに yield しながら次のノードを待つ。
+   *
+   * run() は同時に一つのスレッドからのみ呼び出すこと。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class TaskGraphExecutor
+   * @brief Thread pool executing a TaskGraph in parallel
+   *
+   * run() executes nodes without a dependency between them on multiple
+   * threads at the same time keeping the dependencies of the TaskGraph,
+   * and returns after all nodes are executed. The calling thread also
+   * takes part in the execution.
+   *
+   * Each thread has its own queue and pushes the successors which
+   * become ready to it. A thread whose queue is empty takes a node from
+   * the other end of the queue of another thread (work stealing).
+   * While run() is executing, idle threads wait for the next node
+   * yielding instead of blocking.
+   *
+   * run() must be called from only one thread at a time.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class TaskGraphExecutor
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @param threads 呼び出したスレッドを含む実行スレッド数。1 以下の
+     *                場合はスレッドを作らず順に実行する。
+     * @else
+     * @brief Constructor
+     * @param threads The number of executing threads including the
+     *                calling thread. If 1 or less, no thread is created
+     *                and the nodes are executed in order.
+     * @endif
+     */
+    explicit TaskGraphExecutor(size_t threads);
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~TaskGraphExecutor();
+
+    TaskGraphExecutor(const TaskGraphExecutor&) = delete;
+    TaskGraphExecutor& operator=(const TaskGraphExecutor&) = delete;
+
+    /*!
+     * @if jp
+     * @brief 実行スレッド数を取得する
+     * @return 呼び出したスレッドを含む実行スレッド数
+     * @else
+     * @brief Get the number of executing threads
+     * @return The number of executing threads including the caller
+     * @endif
+     */
+    size_t getThreadCount() const;
+
+    /*!
+     * @if jp
+     * @brief グラフを実行する
+     * @param graph 実行するグラフ
+     * @param task ノード番号を引数としてノードを実行する関数
+     * @else
+     * @brief Execute a graph
+     * @param graph The graph to execute
+     * @param task The function executing the node given by its number
+     * @endif
+     */
+    void run(const TaskGraph& graph, const std::function<void(size_t)>& task);
+
+  private:
+    struct Queue
+    {
+      std::mutex mutex;
+      std::deque<size_t> nodes;
+    };
+
+    void svc(size_t index);
+    void execute(size_t index);
+    void push(size_t index, size_t node);
+    bool pop(size_t index, size_t& node);
+
+    std::vector<std::unique_ptr<Queue> > m_queues;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    unsigned long m_generation;
+    bool m_stop;
+    const TaskGraph* m_graph;
+    const std::function<void(size_t)>* m_task;
+    std::unique_ptr<std::atomic<size_t>[]> m_pending;
+    size_t m_pendingSize;
+    std::atomic<size_t> m_remaining;
+    std::atomic<size_t> m_active;
+  };
+} // namespace RTC
+
+#endif  // RTC_TASKGRAPH_H
@@ -65,14 +65,33 @@ namespace RTC
     ~Timestamp() override {}
     ReturnCode operator()(ConnectorInfo& info, DataType& data) override
     {
-      if (info.properties["timestamp_policy"] != m_tstype)
+      if (policy(info) != m_tstype)
         {
           return NO_CHANGE;
         }
       setTimestamp<DataType>(data);
       return DATA_CHANGED;
     }
+    ReturnCode operator()(ConnectorInfo& info, ByteData& data,
+                          const std::string& marshalingtype) override
+    {
+      // skip deserializing the data when no timestamp is set here
+      if (policy(info) != m_tstype)
+        {
+          return NO_CHANGE;
+        }
+      return ConnectorDataListenerT<DataType>::operator()(info, data,
+                                                          marshalingtype);
+    }
     std::string m_tstype;
+
+  private:
+    // looked up for every data, so nothing is allocated here
+    static const std::string& policy(const ConnectorInfo& info)
+    {
+      static const std::string key("timestamp_policy");
+      return info.properties.getProperty(key);
+    }
   };
 } // namespace RTC
 
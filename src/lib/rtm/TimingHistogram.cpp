@@ -0,0 +1,189 @@
+﻿// -*- C++ -*-
+/*!
+ * @file TimingHistogram.cpp
+ * @brief Lock-free histogram of durations
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/TimingHistogram.h>
+#include <coil/stringutil.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  const unsigned long long NO_MIN(
+    std::numeric_limits<unsigned long long>::max());
+
+  size_t highestBit(unsigned long long v)
+  {
+#if defined(__GNUC__)
+    return 63 - static_cast<size_t>(__builtin_clzll(v));
+#else
+    size_t bit(0);
+    while (v >>= 1) { ++bit; }
+    return bit;
+#endif
+  }
+
+  std::string seconds(unsigned long long ns)
+  {
+    return coil::otos(static_cast<double>(ns) / 1e9);
+  }
+} // namespace
+
+namespace RTC
+{
+  TimingHistogram::TimingHistogram()
+    : m_count(0), m_sum(0), m_min(NO_MIN), m_max(0)
+  {
+    for (auto& bin : m_bins) { bin.store(0, std::memory_order_relaxed); }
+  }
+
+  /*!
+   * @if jp
+   * @brief 時間を記録する
+   * @else
+   * @brief Record a duration
+   * @endif
+   */
+  void TimingHistogram::record(std::chrono::nanoseconds duration)
+  {
+    unsigned long long ns(duration.count() > 0 ?
+                          static_cast<unsigned long long>(duration.count())
+                          : 0);
+    m_bins[index(ns)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(ns, std::memory_order_relaxed);
+    unsigned long long prev(m_min.load(std::memory_order_relaxed));
+    while (ns < prev &&
+           !m_min.compare_exchange_weak(prev, ns,
+                                        std::memory_order_relaxed)) {}
+    prev = m_max.load(std::memory_order_relaxed);
+    while (ns > prev &&
+           !m_max.compare_exchange_weak(prev, ns,
+                                        std::memory_order_relaxed)) {}
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録を消去する
+   * @else
+   * @brief Clear the records
+   * @endif
+   */
+  void TimingHistogram::reset()
+  {
+    for (auto& bin : m_bins) { bin.store(0, std::memory_order_relaxed); }
+    m_count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_min.store(NO_MIN, std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+  }
+
+  /*!
+   * @if jp
+   * @brief 記録数を取得する
+   * @else
+   * @brief Get the number of records
+   * @endif
+   */
+  unsigned long long TimingHistogram::count() const
+  {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * @if jp
+   * @brief パーセンタイル値を取得する
+   * @else
+   * @brief Get a percentile
+   * @endif
+   */
+  std::chrono::nanoseconds TimingHistogram::percentile(double ratio) const
+  {
+    unsigned long long bins[BINS];
+    unsigned long long total(0);
+    for (size_t i(0); i < BINS; ++i)
+      {
+        bins[i] = m_bins[i].load(std::memory_order_relaxed);
+        total += bins[i];
+      }
+    if (total == 0) { return std::chrono::nanoseconds(0); }
+
+    ratio = std::min(std::max(ratio, 0.0), 1.0);
+    unsigned long long rank(std::max(
+      static_cast<unsigned long long>(std::ceil(ratio * total)), 1ULL));
+    unsigned long long sum(0);
+    size_t i(0);
+    for (; i < BINS - 1; ++i)
+      {
+        sum += bins[i];
+        if (sum >= rank) { break; }
+      }
+    // the middle of the bin, within the recorded range
+    unsigned long long value((lower(i) + lower(i + 1)) / 2);
+    value = std::min(value, m_max.load(std::memory_order_relaxed));
+    value = std::max(value, m_min.load(std::memory_order_relaxed) == NO_MIN
+                     ? 0 : m_min.load(std::memory_order_relaxed));
+    return std::chrono::nanoseconds(static_cast<long long>(value));
+  }
+
+  /*!
+   * @if jp
+   * @brief 統計値をプロパティに書き込む
+   * @else
+   * @brief Write the statistics to properties
+   * @endif
+   */
+  void TimingHistogram::toProperties(coil::Properties& prop,
+                                     const std::string& prefix) const
+  {
+    unsigned long long n(count());
+    unsigned long long min(m_min.load(std::memory_order_relaxed));
+    prop.setProperty(prefix + ".count", coil::otos(n));
+    prop.setProperty(prefix + ".min", seconds(min == NO_MIN ? 0 : min));
+    prop.setProperty(prefix + ".max",
+                     seconds(m_max.load(std::memory_order_relaxed)));
+    prop.setProperty(prefix + ".mean",
+                     seconds(n == 0 ? 0 :
+                             m_sum.load(std::memory_order_relaxed) / n));
+    prop.setProperty(prefix + ".p50",
+                     seconds(percentile(0.5).count()));
+    prop.setProperty(prefix + ".p90",
+                     seconds(percentile(0.9).count()));
+    prop.setProperty(prefix + ".p99",
+                     seconds(percentile(0.99).count()));
+    prop.setProperty(prefix + ".p999",
+                     seconds(percentile(0.999).count()));
+  }
+
+  size_t TimingHistogram::index(unsigned long long ns)
+  {
+    if (ns < LINEAR) { return static_cast<size_t>(ns); }
+    size_t bit(highestBit(ns));
+    if (bit > MAX_BIT) { return BINS - 1; }
+    size_t sub(static_cast<size_t>(ns >> (bit - SUB_BITS)) &
+               ((1 << SUB_BITS) - 1));
+    return LINEAR + ((bit - 4) << SUB_BITS) + sub;
+  }
+
+  unsigned long long TimingHistogram::lower(size_t index)
+  {
+    if (index < LINEAR) { return index; }
+    size_t bit(((index - LINEAR) >> SUB_BITS) + 4);
+    unsigned long long sub((index - LINEAR) & ((1 << SUB_BITS) - 1));
+    return ((1ULL << SUB_BITS) + sub) << (bit - SUB_BITS);
+  }
+} // namespace RTC
@@ -0,0 +1,157 @@
+﻿// -*- C++ -*-
+/*!
+ * @file TimingHistogram.h
+ * @brief Lock-free histogram of durations
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_TIMINGHISTOGRAM_H
+#define RTC_TIMINGHISTOGRAM_H
+
+#include <coil/Properties.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class TimingHistogram
+   * @brief 時間の対数ヒストグラム
+   *
+   * ナノ秒単位の時間を 2 のべき乗ごとに 8 分割したビンに数える。相対
+   * 誤差は 12.5% 以下で、メモリ量は一定である。record() はロックを使
+   * わず、実行スレッドから呼び出しながら他のスレッドから読み出しや
+   * reset() ができる。ただし読み出し中の記録や reset() との競合によ
+   * り、統計値が一時的にわずかにずれることがある。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class TimingHistogram
+   * @brief Logarithmic histogram of durations
+   *
+   * Durations in nanoseconds are counted in bins which divide each
+   * power of two into 8. The relative error is 12.5% or less and the
+   * memory size is constant. record() takes no lock, so other threads
+   * can read or reset() the histogram while the executing thread
+   * records. Records racing with reading or reset() may make the
+   * statistics slightly inconsistent for a moment.
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class TimingHistogram
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    TimingHistogram();
+
+    TimingHistogram(const TimingHistogram&) = delete;
+    TimingHistogram& operator=(const TimingHistogram&) = delete;
+
+    /*!
+     * @if jp
+     * @brief 時間を記録する
+     * @param duration 時間。負の値は 0 として記録する。
+     * @else
+     * @brief Record a duration
+     * @param duration The duration. A negative value is recorded as 0.
+     * @endif
+     */
+    void record(std::chrono::nanoseconds duration);
+
+    /*!
+     * @if jp
+     * @brief 記録を消去する
+     * @else
+     * @brief Clear the records
+     * @endif
+     */
+    void reset();
+
+    /*!
+     * @if jp
+     * @brief 記録数を取得する
+     * @return 記録数
+     * @else
+     * @brief Get the number of records
+     * @return The number of records
+     * @endif
+     */
+    unsigned long long count() const;
+
+    /*!
+     * @if jp
+     * @brief パーセンタイル値を取得する
+     * @param ratio 0.0 から 1.0 の割合
+     * @return パーセンタイル値。記録がない場合は 0。
+     * @else
+     * @brief Get a percentile
+     * @param ratio The ratio from 0.0 to 1.0
+     * @return The percentile, or 0 if nothing is recorded
+     * @endif
+     */
+    std::chrono::nanoseconds percentile(double ratio) const;
+
+    /*!
+     * @if jp
+     * @brief 統計値をプロパティに書き込む
+     *
+     * count, min, max, mean, p50, p90, p99, p999 を書き込む。count 以外
+     * の単位は秒である。
+     *
+     * @param prop 書き込むプロパティ
+     * @param prefix キーの接頭辞
+     *
+     * @else
+     * @brief Write the statistics to properties
+     *
+     * count, min, max, mean, p50, p90, p99 and p999 are written. The
+     * unit is seconds except count.
+     *
+     * @param prop The properties to write to
+     * @param prefix The prefix of the keys
+     *
+     * @endif
+     */
+    void toProperties(coil::Properties& prop,
+                      const std::string& prefix) const;
+
+  private:
+    static size_t index(unsigned long long ns);
+    static unsigned long long lower(size_t index);
+
+    // 16 linear bins below 16 ns, then 8 per power of two up to 2^40 ns
+    static const size_t LINEAR = 16;
+    static const size_t SUB_BITS = 3;
+    static const size_t MAX_BIT = 40;
+    static const size_t BINS = LINEAR + (MAX_BIT - 4 + 1) * (1 << SUB_BITS);
+
+    std::atomic<unsigned long long> m_bins[BINS];
+    std::atomic<unsigned long long> m_count;
+    std::atomic<unsigned long long> m_sum;
+    std::atomic<unsigned long long> m_min;
+    std::atomic<unsigned long long> m_max;
+  };
+} // namespace RTC
+
+#endif  // RTC_TIMINGHISTOGRAM_H
@@ -0,0 +1,140 @@
+﻿// -*- C++ -*-
+/*!
+ * @file WaitSet.cpp
+ * @brief Waiting for data on several InPorts at once
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <rtm/WaitSet.h>
+
+namespace RTC
+{
+  WaitSet::WaitSet()
+    : m_generation(0)
+  {
+  }
+
+  WaitSet::~WaitSet()
+  {
+    clear();
+  }
+
+  /*!
+   * @if jp
+   * @brief InPort を登録する
+   * @else
+   * @brief Attach an InPort
+   * @endif
+   */
+  size_t WaitSet::attach(InPortBase& port)
+  {
+    EventNotifier& notifier(port.getEventNotifier());
+    m_entries.push_back({&notifier, &port, notifier.count()});
+    notifier.attach(this);
+    return m_entries.size() - 1;
+  }
+
+  /*!
+   * @if jp
+   * @brief EventNotifier を登録する
+   * @else
+   * @brief Attach an EventNotifier
+   * @endif
+   */
+  size_t WaitSet::attach(EventNotifier& notifier)
+  {
+    m_entries.push_back({&notifier, nullptr, notifier.count()});
+    notifier.attach(this);
+    return m_entries.size() - 1;
+  }
+
+  /*!
+   * @if jp
+   * @brief 登録をすべて解除する
+   * @else
+   * @brief Detach everything
+   * @endif
+   */
+  void WaitSet::clear()
+  {
+    for (auto& entry : m_entries)
+      {
+        entry.notifier->detach(this);
+      }
+    m_entries.clear();
+  }
+
+  /*!
+   * @if jp
+   * @brief いずれかが準備完了になるまで待つ
+   * @else
+   * @brief Wait until any of them is ready
+   * @endif
+   */
+  bool WaitSet::wait(std::vector<size_t>& ready,
+                     std::chrono::nanoseconds timeout)
+  {
+    using Clock = std::chrono::steady_clock;
+    const bool forever(timeout == std::chrono::nanoseconds::max());
+    const Clock::time_point deadline(forever ? Clock::time_point::max() :
+                                     Clock::now() + timeout);
+    std::unique_lock<std::mutex> guard(m_mutex);
+    for (;;)
+      {
+        // a signal after this point changes the generation
+        unsigned long long generation(m_generation);
+        guard.unlock();
+        collect(ready);
+        guard.lock();
+        if (!ready.empty()) { return true; }
+        auto signaled = [this, generation]
+          {
+            return m_generation != generation;
+          };
+        if (forever)
+          {
+            m_cond.wait(guard, signaled);
+          }
+        else if (!m_cond.wait_until(guard, deadline, signaled))
+          {
+            return false;
+          }
+      }
+  }
+
+  void WaitSet::signal()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    ++m_generation;
+    m_cond.notify_all();
+  }
+
+  void WaitSet::collect(std::vector<size_t>& ready)
+  {
+    ready.clear();
+    for (size_t i(0); i < m_entries.size(); ++i)
+      {
+        Entry& entry(m_entries[i]);
+        if (entry.port != nullptr)
+          {
+            if (entry.port->isNew()) { ready.push_back(i); }
+            continue;
+          }
+        unsigned long long count(entry.notifier->count());
+        if (count != entry.count)
+          {
+            entry.count = count;
+            ready.push_back(i);
+          }
+      }
+  }
+} // namespace RTC
@@ -0,0 +1,163 @@
+﻿// -*- C++ -*-
+/*!
+ * @file WaitSet.h
+ * @brief Waiting for data on several InPorts at once
+ * @date $Date$
+ *
+ * Copyright (C) 2026
+ *     Intelligent Systems Research Institute,
+ *     National Institute of
+ *         Advanced Industrial Science and Technology (AIST), Japan
+ *     All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef RTC_WAITSET_H
+#define RTC_WAITSET_H
+
+#include <rtm/EventNotifier.h>
+#include <rtm/InPortBase.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace RTC
+{
+  /*!
+   * @if jp
+   * @class WaitSet
+   * @brief 複数の InPort のデータ到着を同時に待つクラス
+   *
+   * 登録した InPort のいずれかにデータが到着するか、登録した
+   * EventNotifier が通知されるまでスレッドを停止する。InPort は未読デー
+   * タがある間は準備完了とみなされ、EventNotifier は前回の wait() 以降
+   * に通知された場合に準備完了とみなされる。サービスポートの要求を待つ
+   * 場合は、サービスの実装から EventNotifier::notify() を呼び出す。
+   *
+   * attach() と clear() は wait() と同じスレッドから呼び出すこと。
+   *
+   * @since 2.1.0
+   *
+   * @else
+   * @class WaitSet
+   * @brief Class waiting for data on several InPorts at once
+   *
+   * This blocks the thread until data arrives at one of the attached
+   * InPorts or one of the attached EventNotifiers is notified. An InPort
+   * is ready while it has unread data, and an EventNotifier is ready if
+   * it was notified since the previous wait(). To wait for service port
+   * requests, call EventNotifier::notify() from the service
+   * implementation.
+   *
+   * attach() and clear() must be called from the thread calling
+   * wait().
+   *
+   * @since 2.1.0
+   *
+   * @endif
+   */
+  class WaitSet
+  {
+  public:
+    /*!
+     * @if jp
+     * @brief コンストラクタ
+     * @else
+     * @brief Constructor
+     * @endif
+     */
+    WaitSet();
+
+    /*!
+     * @if jp
+     * @brief デストラクタ
+     * @else
+     * @brief Destructor
+     * @endif
+     */
+    ~WaitSet();
+
+    WaitSet(const WaitSet&) = delete;
+    WaitSet& operator=(const WaitSet&) = delete;
+
+    /*!
+     * @if jp
+     * @brief InPort を登録する
+     * @param port InPort
+     * @return wait() が返す番号
+     * @else
+     * @brief Attach an InPort
+     * @param port The InPort
+     * @return The index returned by wait()
+     * @endif
+     */
+    size_t attach(InPortBase& port);
+
+    /*!
+     * @if jp
+     * @brief EventNotifier を登録する
+     * @param notifier EventNotifier
+     * @return wait() が返す番号
+     * @else
+     * @brief Attach an EventNotifier
+     * @param notifier The EventNotifier
+     * @return The index returned by wait()
+     * @endif
+     */
+    size_t attach(EventNotifier& notifier);
+
+    /*!
+     * @if jp
+     * @brief 登録をすべて解除する
+     * @else
+     * @brief Detach everything
+     * @endif
+     */
+    void clear();
+
+    /*!
+     * @if jp
+     * @brief いずれかが準備完了になるまで待つ
+     *
+     * @param ready 準備完了になった登録番号を格納する変数
+     * @param timeout タイムアウト時間。nanoseconds::max() の場合は無期
+     *                限に待つ。
+     *
+     * @return 準備完了のものがある場合 true、タイムアウトした場合 false
+     *
+     * @else
+     * @brief Wait until any of them is ready
+     *
+     * @param ready The variable to store the indexes of the ready ones
+     * @param timeout The timeout. nanoseconds::max() waits forever.
+     *
+     * @return true if any is ready, false on timeout
+     *
+     * @endif
+     */
+    bool wait(std::vector<size_t>& ready, std::chrono::nanoseconds timeout
+              = std::chrono::nanoseconds::max());
+
+  private:
+    friend class EventNotifier;
+    void signal();
+    void collect(std::vector<size_t>& ready);
+
+    struct Entry
+    {
+      EventNotifier* notifier;
+      InPortBase* port;
+      unsigned long long count;
+    };
+    std::vector<Entry> m_entries;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    unsigned long long m_generation;
+  };
+} // namespace RTC
+
+#endif  // RTC_WAITSET_H